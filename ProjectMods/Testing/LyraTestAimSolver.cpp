@@ -0,0 +1,84 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Testing/LyraTestAimSolver.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Weapons/LyraRangedWeaponInstance.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(LyraTestAimSolver)
+
+static const FName HeadSocketName(TEXT("head"));
+static constexpr int32 InterceptIterations = 3;
+
+static bool TryGetHeadLocation(const ACharacter* Target, FVector& OutLocation)
+{
+	const USkeletalMeshComponent* Mesh = Target ? Target->GetMesh() : nullptr;
+	if (Mesh && Mesh->DoesSocketExist(HeadSocketName))
+	{
+		OutLocation = Mesh->GetSocketLocation(HeadSocketName);
+		return true;
+	}
+	return false;
+}
+
+static bool ShouldAimAtHead(const FLyraTestAimSettings& Settings, const ULyraRangedWeaponInstance* Weapon, double Distance)
+{
+	switch (Settings.AimPoint)
+	{
+	case ELyraTestAimPoint::Head:
+		return true;
+	case ELyraTestAimPoint::CapsuleCenter:
+		return false;
+	default:
+		break;
+	}
+	if (!Weapon)
+	{
+		return false;
+	}
+
+	// Lyra spreads shots in a cone whose half angle is half the calculated spread angle.
+	const float SpreadAngle = Weapon->HasFirstShotAccuracy() ? 0.f : Weapon->GetCalculatedSpreadAngle();
+	const double SpreadRadius = Distance * FMath::Tan(FMath::DegreesToRadians(SpreadAngle * 0.5f));
+	return SpreadRadius <= LyraTestAimSolver::HeadRadius + Weapon->GetBulletTraceSweepRadius();
+}
+
+FVector LyraTestAimSolver::SolveAimPoint(const FVector& ViewLocation, const ACharacter* Target, const FVector& TargetPosition, const FVector& TargetVelocity,
+	const ULyraRangedWeaponInstance* Weapon, const FLyraTestAimSettings& Settings, float LatencySeconds)
+{
+	const FVector Position = Target ? Target->GetActorLocation() : TargetPosition;
+	const UCharacterMovementComponent* Movement = Target ? Target->GetCharacterMovement() : nullptr;
+	const FVector Velocity = Movement ? Movement->Velocity : TargetVelocity;
+
+	FVector AimOffset(0.f, 0.f, FallbackAimZOffset);
+	if (Target)
+	{
+		FVector HeadLocation;
+		if (ShouldAimAtHead(Settings, Weapon, FVector::Dist(ViewLocation, Position)) && TryGetHeadLocation(Target, HeadLocation))
+		{
+			AimOffset = HeadLocation - Position;
+		}
+		else
+		{
+			// Character locations are the capsule centre.
+			AimOffset = FVector::ZeroVector;
+		}
+	}
+
+	const FVector AimBase = Position + AimOffset;
+	const double Latency = FMath::Max(0.f, LatencySeconds + Settings.ExtraLeadSeconds);
+	if (Settings.ProjectileSpeed <= 0.f)
+	{
+		return AimBase + Velocity * Latency;
+	}
+
+	// Fixed-point iteration on the travel time; converges in a few steps whenever the projectile outruns the target.
+	double LeadTime = Latency;
+	for (int32 Iteration = 0; Iteration < InterceptIterations; ++Iteration)
+	{
+		const FVector Predicted = AimBase + Velocity * LeadTime;
+		LeadTime = Latency + FVector::Dist(ViewLocation, Predicted) / Settings.ProjectileSpeed;
+	}
+	return AimBase + Velocity * LeadTime;
+}
@@ -0,0 +1,49 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LyraTestAimSolver.generated.h"
+
+class ACharacter;
+class ULyraRangedWeaponInstance;
+
+UENUM(BlueprintType)
+enum class ELyraTestAimPoint : uint8
+{
+	/** Head while the weapon's spread cone at the target's distance fits the head, otherwise capsule centre. */
+	Auto,
+	CapsuleCenter,
+	Head
+};
+
+USTRUCT(BlueprintType)
+struct LYRAGAME_API FLyraTestAimSettings
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	ELyraTestAimPoint AimPoint = ELyraTestAimPoint::Auto;
+
+	/** Projectile speed in cm/s; 0 for hitscan, which is what every stock Lyra ranged weapon uses. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	float ProjectileSpeed = 0.f;
+
+	/** Lead added on top of the frame it takes injected fire input to reach the weapon. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	float ExtraLeadSeconds = 0.f;
+};
+
+namespace LyraTestAimSolver
+{
+	/** Offset above the actor location used when the target actor is unknown (no capsule or mesh to read). */
+	static constexpr float FallbackAimZOffset = 40.f;
+	static constexpr float HeadRadius = 12.f;
+
+	/**
+	 * Returns the point to aim at so a shot fired after LatencySeconds meets Target. TargetPosition/Velocity
+	 * are used when Target is null; Weapon (optional) supplies spread and trace radius for the aim point choice.
+	 */
+	LYRAGAME_API FVector SolveAimPoint(const FVector& ViewLocation, const ACharacter* Target, const FVector& TargetPosition, const FVector& TargetVelocity,
+		const ULyraRangedWeaponInstance* Weapon, const FLyraTestAimSettings& Settings, float LatencySeconds);
+}
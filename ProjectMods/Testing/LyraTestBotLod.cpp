@@ -0,0 +1,371 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Testing/LyraTestBotLod.h"
+#include "Testing/LyraTestEnemyQuery.h"
+#include "Testing/LyraTestEnemyRegistry.h"
+#include "Testing/LyraTestNetComponent.h"
+#include "Testing/LyraTestStats.h"
+#include "Testing/LyraTestSupportSubsystem.h"
+#include "AIController.h"
+#include "BrainComponent.h"
+#include "Character/LyraHealthComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "Navigation/PathFollowingComponent.h"
+#include "Perception/AIPerceptionComponent.h"
+#include "Perception/AISenseConfig.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(LyraTestBotLod)
+
+static const TCHAR* BotLodPauseReason = TEXT("LyraTestBotLod");
+
+static void GetObjectTick(const UObject* Object, float& OutInterval, bool& bOutEnabled)
+{
+	if (const AActor* Actor = Cast<AActor>(Object))
+	{
+		OutInterval = Actor->GetActorTickInterval();
+		bOutEnabled = Actor->IsActorTickEnabled();
+	}
+	else if (const UActorComponent* Component = Cast<UActorComponent>(Object))
+	{
+		OutInterval = Component->GetComponentTickInterval();
+		bOutEnabled = Component->IsComponentTickEnabled();
+	}
+}
+
+static void SetObjectTick(UObject* Object, float Interval, bool bEnabled)
+{
+	if (AActor* Actor = Cast<AActor>(Object))
+	{
+		Actor->SetActorTickInterval(Interval);
+		Actor->SetActorTickEnabled(bEnabled);
+	}
+	else if (UActorComponent* Component = Cast<UActorComponent>(Object))
+	{
+		Component->SetComponentTickInterval(Interval);
+		Component->SetComponentTickEnabled(bEnabled);
+	}
+}
+
+static void SetSensesEnabled(UAIPerceptionComponent* Perception, bool bEnable)
+{
+	for (auto It = Perception->GetSensesConfigIterator(); It; ++It)
+	{
+		if (const UAISenseConfig* Config = *It)
+		{
+			// Re-enabling goes back to how the sense was configured rather than forcing it on.
+			Perception->SetSenseEnabled(Config->GetSenseImplementation(), bEnable && Config->GetStartsEnabled());
+		}
+	}
+}
+
+void ULyraTestBotLod::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	Collection.InitializeDependency<ULyraTestSupportSubsystem>();
+	bEnabled = FParse::Param(FCommandLine::Get(), TEXT("LyraTestBotLod"));
+}
+
+void ULyraTestBotLod::Deinitialize()
+{
+	RestoreAllBots();
+	bEnabled = false;
+	Super::Deinitialize();
+}
+
+bool ULyraTestBotLod::IsTickable() const
+{
+	return !HasAnyFlags(RF_ClassDefaultObject) && bEnabled;
+}
+
+TStatId ULyraTestBotLod::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(ULyraTestBotLod, STATGROUP_Tickables);
+}
+
+void ULyraTestBotLod::SetBotLodEnabled(bool bEnable)
+{
+	if (!bEnable)
+	{
+		RestoreAllBots();
+	}
+	bEnabled = bEnable;
+	LastUpdateSeconds = -1.0;
+}
+
+void ULyraTestBotLod::SetBotLodSettings(const FLyraTestBotLodSettings& InSettings)
+{
+	Settings = InSettings;
+	Settings.FullDistance = FMath::Max(Settings.FullDistance, 0.f);
+	Settings.ReducedDistance = FMath::Max(Settings.ReducedDistance, Settings.FullDistance);
+	Settings.FreezeDistance = Settings.FreezeDistance > 0.f ? FMath::Max(Settings.FreezeDistance, Settings.ReducedDistance) : 0.f;
+	Settings.InViewDistanceScale = FMath::Max(Settings.InViewDistanceScale, 1.f);
+	Settings.NeighbourRadius = FMath::Max(Settings.NeighbourRadius, 0.f);
+	Settings.ReducedTickInterval = FMath::Max(Settings.ReducedTickInterval, 0.f);
+	Settings.UpdateInterval = FMath::Max(Settings.UpdateInterval, 0.f);
+}
+
+FString ULyraTestBotLod::GetBotLodCountsJson() const
+{
+	return FString::Printf(TEXT("{\"enabled\":%s,\"full\":%d,\"reduced\":%d,\"noPerception\":%d,\"frozen\":%d}"),
+		bEnabled ? TEXT("true") : TEXT("false"), Counts.Full, Counts.Reduced, Counts.NoPerception, Counts.Frozen);
+}
+
+void ULyraTestBotLod::Tick(float DeltaTime)
+{
+	LYRA_TEST_SCOPE(BotLod);
+	UWorld* World = GetGameInstance()->GetWorld();
+	// Clients only see replicated bots; their AI, movement authority and perception live on the server.
+	if (!World || World->GetNetMode() == NM_Client)
+	{
+		return;
+	}
+	// World time restarts after travel, so an earlier time also counts as due.
+	const double Now = World->GetTimeSeconds();
+	if (LastUpdateSeconds >= 0.0 && Now >= LastUpdateSeconds && Now - LastUpdateSeconds < Settings.UpdateInterval)
+	{
+		return;
+	}
+	LastUpdateSeconds = Now;
+	UpdateTiers(World);
+}
+
+void ULyraTestBotLod::UpdateTiers(UWorld* World)
+{
+	ULyraTestEnemyRegistry* Registry = World->GetSubsystem<ULyraTestEnemyRegistry>();
+	if (!Registry)
+	{
+		return;
+	}
+
+	// Every player with a pawn: the local ones here, plus the remote ones on a server. Remote clients of a
+	// load test server also report their current targets through their net component.
+	TArray<FVector, TInlineAllocator<8>> ViewLocations;
+	TArray<FVector, TInlineAllocator<8>> ViewDirections;
+	TArray<const ACharacter*, TInlineAllocator<4>> Targets;
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PC = It->Get();
+		if (!PC || !PC->GetPawn())
+		{
+			continue;
+		}
+		FVector Location;
+		FRotator Rotation;
+		PC->GetPlayerViewPoint(Location, Rotation);
+		ViewLocations.Add(Location);
+		ViewDirections.Add(Rotation.Vector());
+
+		const ULyraTestNetComponent* NetComponent = PC->IsLocalController() ? nullptr : ULyraTestNetComponent::Find(PC);
+		if (const ACharacter* Target = NetComponent ? Cast<ACharacter>(NetComponent->GetTarget()) : nullptr)
+		{
+			Targets.Add(Target);
+		}
+	}
+	// Nothing to measure against yet; leave the tiers as they are rather than freezing everything.
+	if (ViewLocations.IsEmpty())
+	{
+		return;
+	}
+
+	if (const ULyraTestSupportSubsystem* Support = GetGameInstance()->GetSubsystem<ULyraTestSupportSubsystem>())
+	{
+		for (int32 PlayerIndex = 0; PlayerIndex < GetGameInstance()->GetNumLocalPlayers(); ++PlayerIndex)
+		{
+			if (const ACharacter* Target = Cast<ACharacter>(ULyraTestEnemyQuery::ResolveTestObjectId(Support->GetPlayerTargetId(PlayerIndex))))
+			{
+				Targets.Add(Target);
+			}
+		}
+	}
+
+	++UpdateCount;
+	const float CosViewHalfAngle = FMath::Cos(FMath::DegreesToRadians(Settings.ViewHalfAngleDegrees));
+	const double NeighbourRadiusSquared = FMath::Square(Settings.NeighbourRadius);
+	FLyraTestBotLodCounts NewCounts;
+	Registry->ForEachAlive(false, INDEX_NONE, [&](ACharacter* Char, int32 TeamId, ULyraHealthComponent* HealthComponent)
+	{
+		const FVector Location = Char->GetActorLocation();
+		ELyraTestBotLodTier Tier = ELyraTestBotLodTier::Full;
+		const bool bNearTarget = Targets.ContainsByPredicate([Char, &Location, NeighbourRadiusSquared](const ACharacter* Target)
+		{
+			return Target == Char || FVector::DistSquared(Target->GetActorLocation(), Location) <= NeighbourRadiusSquared;
+		});
+		if (!bNearTarget)
+		{
+			double Distance = UE_BIG_NUMBER;
+			for (int32 Index = 0; Index < ViewLocations.Num(); ++Index)
+			{
+				const FVector ToBot = Location - ViewLocations[Index];
+				double ViewDistance = ToBot.Size();
+				if (ViewDistance > UE_KINDA_SMALL_NUMBER && FVector::DotProduct(ToBot / ViewDistance, ViewDirections[Index]) >= CosViewHalfAngle)
+				{
+					ViewDistance /= Settings.InViewDistanceScale;
+				}
+				Distance = FMath::Min(Distance, ViewDistance);
+			}
+			if (Distance > Settings.FullDistance)
+			{
+				Tier = Distance <= Settings.ReducedDistance ? ELyraTestBotLodTier::Reduced
+					: (Settings.FreezeDistance <= 0.f || Distance <= Settings.FreezeDistance) ? ELyraTestBotLodTier::NoPerception
+					: ELyraTestBotLodTier::Frozen;
+			}
+		}
+
+		switch (Tier)
+		{
+		case ELyraTestBotLodTier::Full: ++NewCounts.Full; break;
+		case ELyraTestBotLodTier::Reduced: ++NewCounts.Reduced; break;
+		case ELyraTestBotLodTier::NoPerception: ++NewCounts.NoPerception; break;
+		case ELyraTestBotLodTier::Frozen: ++NewCounts.Frozen; break;
+		}
+
+		FBotState* State = Bots.Find(Char);
+		if (Tier == ELyraTestBotLodTier::Full)
+		{
+			if (State)
+			{
+				ForgetBot(*State);
+				Bots.Remove(Char);
+			}
+			return;
+		}
+		if (!State)
+		{
+			State = &Bots.Add(Char);
+			State->Character = Char;
+			State->Controller = Char->GetController();
+			State->HealthComponent = HealthComponent;
+			if (HealthComponent)
+			{
+				HealthComponent->OnDeathStarted.AddUniqueDynamic(this, &ThisClass::HandleBotDeathStarted);
+			}
+		}
+		else if (State->Controller != Char->GetController())
+		{
+			// Repossessed: the saved state belongs to the old controller.
+			RestoreBot(*State);
+			State->Controller = Char->GetController();
+		}
+		State->SeenUpdate = UpdateCount;
+		if (State->Tier != Tier)
+		{
+			SetBotTier(*State, Tier);
+		}
+	});
+
+	// Bots that left the alive set or were destroyed since the last update.
+	for (auto It = Bots.CreateIterator(); It; ++It)
+	{
+		if (It.Value().SeenUpdate != UpdateCount)
+		{
+			ForgetBot(It.Value());
+			It.RemoveCurrent();
+		}
+	}
+	Counts = NewCounts;
+}
+
+void ULyraTestBotLod::SetBotTier(FBotState& State, ELyraTestBotLodTier Tier)
+{
+	RestoreBot(State);
+	ACharacter* Char = State.Character.Get();
+	if (!Char || Tier == ELyraTestBotLodTier::Full)
+	{
+		return;
+	}
+
+	AAIController* AIController = Cast<AAIController>(State.Controller.Get());
+	UBrainComponent* Brain = AIController ? AIController->GetBrainComponent() : nullptr;
+	UAIPerceptionComponent* Perception = AIController ? AIController->GetAIPerceptionComponent() : nullptr;
+	const TArray<UObject*, TInlineAllocator<8>> Tickers = { Char, Char->GetCharacterMovement(), Char->GetMesh(), AIController, Brain,
+		AIController ? AIController->GetPathFollowingComponent() : nullptr, Perception };
+	const bool bFrozen = Tier == ELyraTestBotLodTier::Frozen;
+	for (UObject* Object : Tickers)
+	{
+		if (!Object)
+		{
+			continue;
+		}
+		FSavedTick& Saved = State.SavedTicks.AddDefaulted_GetRef();
+		Saved.Object = Object;
+		GetObjectTick(Object, Saved.Interval, Saved.bEnabled);
+		SetObjectTick(Object, FMath::Max(Saved.Interval, Settings.ReducedTickInterval), Saved.bEnabled && !bFrozen);
+	}
+
+	if (Tier >= ELyraTestBotLodTier::NoPerception)
+	{
+		if (Brain && Brain->IsRunning() && !Brain->IsPaused())
+		{
+			Brain->PauseLogic(BotLodPauseReason);
+			State.bBrainPaused = true;
+		}
+		if (Perception)
+		{
+			SetSensesEnabled(Perception, false);
+			State.bSensesDisabled = true;
+		}
+	}
+	State.Tier = Tier;
+}
+
+void ULyraTestBotLod::RestoreBot(FBotState& State)
+{
+	for (const FSavedTick& Saved : State.SavedTicks)
+	{
+		if (UObject* Object = Saved.Object.Get())
+		{
+			SetObjectTick(Object, Saved.Interval, Saved.bEnabled);
+		}
+	}
+	State.SavedTicks.Reset();
+
+	const AAIController* AIController = Cast<AAIController>(State.Controller.Get());
+	if (State.bBrainPaused && AIController && AIController->GetBrainComponent())
+	{
+		AIController->GetBrainComponent()->ResumeLogic(BotLodPauseReason);
+	}
+	if (State.bSensesDisabled && AIController && AIController->GetAIPerceptionComponent())
+	{
+		SetSensesEnabled(AIController->GetAIPerceptionComponent(), true);
+	}
+	State.bBrainPaused = false;
+	State.bSensesDisabled = false;
+	State.Tier = ELyraTestBotLodTier::Full;
+}
+
+void ULyraTestBotLod::ForgetBot(FBotState& State)
+{
+	RestoreBot(State);
+	if (ULyraHealthComponent* HealthComponent = State.HealthComponent.Get())
+	{
+		HealthComponent->OnDeathStarted.RemoveDynamic(this, &ThisClass::HandleBotDeathStarted);
+	}
+}
+
+void ULyraTestBotLod::RestoreAllBots()
+{
+	for (TPair<TObjectKey<ACharacter>, FBotState>& Pair : Bots)
+	{
+		ForgetBot(Pair.Value);
+	}
+	Bots.Reset();
+	Counts = FLyraTestBotLodCounts();
+}
+
+void ULyraTestBotLod::HandleBotDeathStarted(AActor* OwningActor)
+{
+	// Right away rather than at the next update, so the death ability's montage and ragdoll run at full rate.
+	const TObjectKey<ACharacter> Key(Cast<ACharacter>(OwningActor));
+	if (FBotState* State = Bots.Find(Key))
+	{
+		ForgetBot(*State);
+		Bots.Remove(Key);
+	}
+}
@@ -0,0 +1,162 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Tickable.h"
+#include "UObject/ObjectKey.h"
+#include "LyraTestBotLod.generated.h"
+
+class ACharacter;
+class AController;
+class ULyraHealthComponent;
+class UWorld;
+
+UENUM(BlueprintType)
+enum class ELyraTestBotLodTier : uint8
+{
+	/** Untouched. */
+	Full,
+	/** Controller, movement, mesh and AI component ticks throttled to ReducedTickInterval. */
+	Reduced,
+	/** Reduced, plus perception senses off and behavior logic paused. */
+	NoPerception,
+	/** No ticking at all; the bot keeps its pose and can still be hit. */
+	Frozen
+};
+
+USTRUCT(BlueprintType)
+struct LYRAGAME_API FLyraTestBotLodSettings
+{
+	GENERATED_BODY()
+
+	/** Distance to the nearest player pawn up to which bots stay at full fidelity. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	float FullDistance = 3000.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	float ReducedDistance = 6000.f;
+
+	/** Bots beyond this are frozen; 0 never freezes. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	float FreezeDistance = 10000.f;
+
+	/** Bots inside a player's view cone count as this many times closer. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	float InViewDistanceScale = 2.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	float ViewHalfAngleDegrees = 60.f;
+
+	/** Bots this close to a player's current target stay at full fidelity with it. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	float NeighbourRadius = 1500.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	float ReducedTickInterval = 0.1f;
+
+	/** Game seconds between reclassifications. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	float UpdateInterval = 0.25f;
+};
+
+USTRUCT(BlueprintType)
+struct LYRAGAME_API FLyraTestBotLodCounts
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	int32 Full = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	int32 Reduced = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	int32 NoPerception = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	int32 Frozen = 0;
+};
+
+/**
+ * AI level of detail for high bot counts: every UpdateInterval, classifies the enemy registry's alive bots by
+ * distance to the nearest player pawn (closer when in its view cone) and throttles, blinds or freezes the far
+ * ones. Players' current targets and bots near them always stay at full fidelity, as do bots that die,
+ * so death and ragdoll play normally. Off by default; -LyraTestBotLod turns it on at startup. Only acts where
+ * the bots' AI runs, i.e. not on network clients.
+ */
+UCLASS(meta = (DisplayName = "Lyra Test Bot LOD"))
+class LYRAGAME_API ULyraTestBotLod : public UGameInstanceSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual ETickableTickType GetTickableTickType() const override { return ETickableTickType::Conditional; }
+	virtual TStatId GetStatId() const override;
+
+	/** Disabling restores every bot to full fidelity. */
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
+	void SetBotLodEnabled(bool bEnable);
+
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
+	bool IsBotLodEnabled() const { return bEnabled; }
+
+	/** Takes effect at the next reclassification. */
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
+	void SetBotLodSettings(const FLyraTestBotLodSettings& InSettings);
+
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
+	FLyraTestBotLodSettings GetBotLodSettings() const { return Settings; }
+
+	/** Alive bots per tier as of the last reclassification. */
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
+	FLyraTestBotLodCounts GetBotLodCounts() const { return Counts; }
+
+	FString GetBotLodCountsJson() const;
+
+private:
+	struct FSavedTick
+	{
+		TWeakObjectPtr<UObject> Object;
+		float Interval = 0.f;
+		bool bEnabled = true;
+	};
+
+	/** A bot below full fidelity and the tick state it had before, restored when it goes back to full. */
+	struct FBotState
+	{
+		TWeakObjectPtr<ACharacter> Character;
+		TWeakObjectPtr<AController> Controller;
+		TWeakObjectPtr<ULyraHealthComponent> HealthComponent;
+		ELyraTestBotLodTier Tier = ELyraTestBotLodTier::Full;
+		TArray<FSavedTick> SavedTicks;
+		bool bBrainPaused = false;
+		bool bSensesDisabled = false;
+		uint64 SeenUpdate = 0;
+	};
+
+	UFUNCTION()
+	void HandleBotDeathStarted(AActor* OwningActor);
+
+	void UpdateTiers(UWorld* World);
+	void SetBotTier(FBotState& State, ELyraTestBotLodTier Tier);
+	void RestoreBot(FBotState& State);
+	void ForgetBot(FBotState& State);
+	void RestoreAllBots();
+
+	UPROPERTY(Transient)
+	FLyraTestBotLodSettings Settings;
+
+	UPROPERTY(Transient)
+	FLyraTestBotLodCounts Counts;
+
+	bool bEnabled = false;
+	double LastUpdateSeconds = -1.0;
+	uint64 UpdateCount = 0;
+	TMap<TObjectKey<ACharacter>, FBotState> Bots;
+};
@@ -0,0 +1,155 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Testing/LyraTestCommandBatch.h"
+
+static_assert(PLATFORM_LITTLE_ENDIAN, "LyraTestCommandBatch wire format is written little endian.");
+
+template <typename T>
+static FORCEINLINE void WriteCommandValue(uint8* Dest, int32 Offset, T Value)
+{
+	FMemory::Memcpy(Dest + Offset, &Value, sizeof(T));
+}
+
+void FLyraTestCommandBatch::AddResult(ELyraTestCommandOp Op, bool bOk, TConstArrayView<uint8> Payload)
+{
+	using namespace LyraTestCommandBatch;
+
+	const int32 Offset = ResultEntries.AddZeroed(EntryHeaderSize + Payload.Num());
+	uint8* Entry = ResultEntries.GetData() + Offset;
+	WriteCommandValue<uint8>(Entry, 0, static_cast<uint8>(Op));
+	WriteCommandValue<uint8>(Entry, 1, bOk ? 1 : 0);
+	WriteCommandValue<uint32>(Entry, 4, static_cast<uint32>(Payload.Num()));
+	WriteCommandValue<uint64>(Entry, 8, static_cast<uint64>(GFrameCounter));
+	if (Payload.Num() > 0)
+	{
+		FMemory::Memcpy(Entry + EntryHeaderSize, Payload.GetData(), Payload.Num());
+	}
+	++ResultCount;
+}
+
+void FLyraTestCommandBatch::AddResult(ELyraTestCommandOp Op, bool bOk, int64 Value)
+{
+	AddResult(Op, bOk, TConstArrayView<uint8>(reinterpret_cast<const uint8*>(&Value), sizeof(Value)));
+}
+
+void FLyraTestCommandBatch::SerializeToBytes(TArray<uint8>& OutBytes) const
+{
+	using namespace LyraTestCommandBatch;
+
+	OutBytes.Reset();
+	OutBytes.AddZeroed(HeaderSize);
+	uint8* Data = OutBytes.GetData();
+	WriteCommandValue<uint32>(Data, 0, Magic);
+	WriteCommandValue<uint16>(Data, 4, Version);
+	WriteCommandValue<uint16>(Data, 6, static_cast<uint16>(ResultCount));
+	WriteCommandValue<int64>(Data, 8, BatchId);
+	WriteCommandValue<uint64>(Data, 16, static_cast<uint64>(GFrameCounter));
+	WriteCommandValue<uint32>(Data, 24, Flags | (IsComplete() ? 0 : Flag_Pending));
+	OutBytes.Append(ResultEntries);
+}
+
+static bool ParseCommandArgs(const TArray<FString>& Tokens, int32 MinArgs, int32 MaxArgs)
+{
+	const int32 NumArgs = Tokens.Num() - 1;
+	return NumArgs >= MinArgs && NumArgs <= MaxArgs;
+}
+
+static bool ParseCommand(const TArray<FString>& Tokens, FLyraTestCommand& OutCommand)
+{
+	const FString& Name = Tokens[0];
+	if (Name == TEXT("look") && ParseCommandArgs(Tokens, 3, 3))
+	{
+		OutCommand.Op = ELyraTestCommandOp::LookAt;
+		return LexTryParseString(OutCommand.Target.X, *Tokens[1])
+			&& LexTryParseString(OutCommand.Target.Y, *Tokens[2])
+			&& LexTryParseString(OutCommand.Target.Z, *Tokens[3]);
+	}
+	if (Name == TEXT("fire") && ParseCommandArgs(Tokens, 0, 0))
+	{
+		OutCommand.Op = ELyraTestCommandOp::Fire;
+		return true;
+	}
+	if (Name == TEXT("cheat") && ParseCommandArgs(Tokens, 2, 2))
+	{
+		OutCommand.Op = ELyraTestCommandOp::SetCheats;
+		OutCommand.bFlagA = Tokens[1] != TEXT("0");
+		OutCommand.bFlagB = Tokens[2] != TEXT("0");
+		return true;
+	}
+	if (Name == TEXT("snap") && ParseCommandArgs(Tokens, 0, 1))
+	{
+		OutCommand.Op = ELyraTestCommandOp::Snapshot;
+		OutCommand.bFlagA = Tokens.Num() < 2 || Tokens[1] != TEXT("0");
+		return true;
+	}
+	if (Name == TEXT("wait") && ParseCommandArgs(Tokens, 1, 1))
+	{
+		OutCommand.Op = ELyraTestCommandOp::WaitFrames;
+		return LexTryParseString(OutCommand.Values[0], *Tokens[1]) && OutCommand.Values[0] >= 0;
+	}
+	if (Name == TEXT("aim") && ParseCommandArgs(Tokens, 0, 1))
+	{
+		OutCommand.Op = ELyraTestCommandOp::AimAtEnemy;
+		return Tokens.Num() < 2 || LexTryParseString(OutCommand.Values[0], *Tokens[1]);
+	}
+	if (Name == TEXT("track") && ParseCommandArgs(Tokens, 0, 2))
+	{
+		OutCommand.Op = ELyraTestCommandOp::TrackEnemy;
+		OutCommand.bFlagA = Tokens.Num() > 2 && Tokens[2] != TEXT("0");
+		return Tokens.Num() < 2 || LexTryParseString(OutCommand.Values[0], *Tokens[1]);
+	}
+	if (Name == TEXT("burst") && ParseCommandArgs(Tokens, 1, 3))
+	{
+		OutCommand.Op = ELyraTestCommandOp::FirePattern;
+		OutCommand.Values[1] = 3;
+		OutCommand.Values[2] = 6;
+		for (int32 Index = 1; Index < Tokens.Num(); ++Index)
+		{
+			if (!LexTryParseString(OutCommand.Values[Index - 1], *Tokens[Index]))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+	if (Name == TEXT("kill") && ParseCommandArgs(Tokens, 1, 3))
+	{
+		OutCommand.Op = ELyraTestCommandOp::FindKill;
+		for (int32 Index = 1; Index < Tokens.Num(); ++Index)
+		{
+			if (!LexTryParseString(OutCommand.Values[Index - 1], *Tokens[Index]))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+	return false;
+}
+
+bool LyraTestCommandBatch::ParseCommands(const FString& Text, TArray<FLyraTestCommand>& OutCommands, FString& OutError)
+{
+	OutCommands.Reset();
+
+	TArray<FString> Statements;
+	Text.ParseIntoArray(Statements, TEXT(";"), true);
+	TArray<FString> Tokens;
+	for (const FString& Statement : Statements)
+	{
+		Tokens.Reset();
+		Statement.ParseIntoArrayWS(Tokens);
+		if (Tokens.Num() == 0)
+		{
+			continue;
+		}
+		FLyraTestCommand Command;
+		if (!ParseCommand(Tokens, Command))
+		{
+			OutError = Statement.TrimStartAndEnd();
+			OutCommands.Reset();
+			return false;
+		}
+		OutCommands.Add(Command);
+	}
+	return true;
+}
@@ -0,0 +1,75 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum class ELyraTestCommandOp : uint8
+{
+	None,
+	LookAt,
+	Fire,
+	SetCheats,
+	Snapshot,
+	WaitFrames,
+	FindKill,
+	AimAtEnemy,
+	TrackEnemy,
+	FirePattern
+};
+
+struct FLyraTestCommand
+{
+	ELyraTestCommandOp Op = ELyraTestCommandOp::None;
+	FVector Target = FVector::ZeroVector;
+	bool bFlagA = false;
+	bool bFlagB = false;
+	int64 Values[3] = { 0, 0, 0 };
+};
+
+/** A parsed command list plus the results written so far; kept by the test support subsystem while it waits frames. */
+struct FLyraTestCommandBatch
+{
+	int64 BatchId = 0;
+	int32 PlayerIndex = 0;
+	TArray<FLyraTestCommand> Commands;
+	int32 NextCommand = 0;
+	int32 FramesToWait = 0;
+	uint64 LastRunFrame = 0;
+	int32 ResultCount = 0;
+	uint32 Flags = 0;
+	TArray<uint8> ResultEntries;
+
+	bool IsComplete() const { return NextCommand >= Commands.Num() && FramesToWait <= 0; }
+
+	void AddResult(ELyraTestCommandOp Op, bool bOk, TConstArrayView<uint8> Payload = TConstArrayView<uint8>());
+	void AddResult(ELyraTestCommandOp Op, bool bOk, int64 Value);
+	void SerializeToBytes(TArray<uint8>& OutBytes) const;
+};
+
+namespace LyraTestCommandBatch
+{
+	// Command text: ';'-separated commands, whitespace-separated arguments, executed in order.
+	//   look X Y Z | fire | cheat Invincible(0/1) InfiniteAmmo(0/1) | snap [EnemiesOnly(0/1), default 1]
+	//   wait Frames | kill SinceSequence [VictimId] [InstigatorId] | aim [TargetId, default 0 = selected target, lead-aimed]
+	//   track [TargetId] [FireWhenSettled(0/1)] (smooth per-frame aim until stopped)
+	//   burst ShotCount(0 = auto) [HoldFrames, default 3] [IntervalFrames, default 6]
+	// Everything before the first wait runs in the calling frame; the rest resumes after the requested frames.
+	//
+	// Packed result layout (little endian): 32-byte header then variable-size entries, one per executed command.
+	//   Header  [0] uint32 Magic 'LTCB'  [4] uint16 Version  [6] uint16 ResultCount  [8] int64 BatchId
+	//           [16] uint64 FrameNumber  [24] uint32 Flags  [28] uint32 Reserved
+	//   Entry   [0] uint8 Op  [1] uint8 Ok  [2] uint16 Reserved  [4] uint32 PayloadSize  [8] uint64 FrameNumber  [16] payload
+	//   Payload snap: snapshot bytes (LyraTestSnapshot layout); kill: int64 kill sequence (0 = none); others: empty.
+	static constexpr uint32 Magic = 0x4243544C; // "LTCB"
+	static constexpr uint16 Version = 1;
+	static constexpr int32 HeaderSize = 32;
+	static constexpr int32 EntryHeaderSize = 16;
+
+	static constexpr uint32 Flag_Pending = 1 << 0;
+	static constexpr uint32 Flag_ParseError = 1 << 1;
+	static constexpr uint32 Flag_Unknown = 1 << 2;
+
+	/** Parses the whole list or nothing; on failure OutCommands is empty and OutError names the bad command. */
+	LYRAGAME_API bool ParseCommands(const FString& Text, TArray<FLyraTestCommand>& OutCommands, FString& OutError);
+}
@@ -0,0 +1,68 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Testing/LyraTestCommandBatch.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLyraTestCommandBatchParseTest, "LyraGame.Testing.CommandBatch.Parse",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FLyraTestCommandBatchParseTest::RunTest(const FString& Parameters)
+{
+	TArray<FLyraTestCommand> Commands;
+	FString Error;
+
+	TestTrue(TEXT("Valid list parses"), LyraTestCommandBatch::ParseCommands(TEXT("look 1 2.5 -3; fire; wait 2; snap 0; kill 5 7"), Commands, Error));
+	if (TestEqual(TEXT("Valid list command count"), Commands.Num(), 5))
+	{
+		TestTrue(TEXT("look op"), Commands[0].Op == ELyraTestCommandOp::LookAt);
+		TestEqual(TEXT("look target"), Commands[0].Target, FVector(1.0, 2.5, -3.0));
+		TestTrue(TEXT("fire op"), Commands[1].Op == ELyraTestCommandOp::Fire);
+		TestEqual(TEXT("wait frames"), Commands[2].Values[0], int64(2));
+		TestFalse(TEXT("snap 0 includes allies"), Commands[3].bFlagA);
+		TestEqual(TEXT("kill since"), Commands[4].Values[0], int64(5));
+		TestEqual(TEXT("kill victim"), Commands[4].Values[1], int64(7));
+		TestEqual(TEXT("kill instigator default"), Commands[4].Values[2], int64(0));
+	}
+
+	TestTrue(TEXT("Defaults parse"), LyraTestCommandBatch::ParseCommands(TEXT("snap; burst 0; track 9"), Commands, Error));
+	if (TestEqual(TEXT("Defaults command count"), Commands.Num(), 3))
+	{
+		TestTrue(TEXT("snap defaults to enemies only"), Commands[0].bFlagA);
+		TestEqual(TEXT("burst shots"), Commands[1].Values[0], int64(0));
+		TestEqual(TEXT("burst hold default"), Commands[1].Values[1], int64(3));
+		TestEqual(TEXT("burst interval default"), Commands[1].Values[2], int64(6));
+		TestEqual(TEXT("track target"), Commands[2].Values[0], int64(9));
+		TestFalse(TEXT("track fire default"), Commands[2].bFlagA);
+	}
+
+	TestTrue(TEXT("Empty statements are skipped"), LyraTestCommandBatch::ParseCommands(TEXT(" ; fire ;; "), Commands, Error));
+	TestEqual(TEXT("Empty statements command count"), Commands.Num(), 1);
+
+	// One bad command rejects the whole list, including the good commands before it.
+	TestFalse(TEXT("Short look rejects the list"), LyraTestCommandBatch::ParseCommands(TEXT("fire; look 1 2; fire"), Commands, Error));
+	TestEqual(TEXT("Rejected list leaves no commands"), Commands.Num(), 0);
+	TestEqual(TEXT("Error names the bad command"), Error, FString(TEXT("look 1 2")));
+
+	const TCHAR* BadLists[] = {
+		TEXT("jump"),
+		TEXT("fire 1"),
+		TEXT("wait -1"),
+		TEXT("wait x"),
+		TEXT("look 1 2 z"),
+		TEXT("cheat 1"),
+		TEXT("burst 1 2 3 4"),
+		TEXT("kill"),
+		TEXT("snap; aim one"),
+	};
+	for (const TCHAR* BadList : BadLists)
+	{
+		TestFalse(FString::Printf(TEXT("'%s' is rejected"), BadList), LyraTestCommandBatch::ParseCommands(BadList, Commands, Error));
+		TestEqual(FString::Printf(TEXT("'%s' leaves no commands"), BadList), Commands.Num(), 0);
+	}
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
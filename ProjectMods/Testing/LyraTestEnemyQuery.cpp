@@ -1,226 +1,399 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "Testing/LyraTestEnemyQuery.h"
+#include "Testing/LyraTestBotLod.h"
+#include "Testing/LyraTestEnemyRegistry.h"
+#include "Testing/LyraTestEventPublisher.h"
+#include "Testing/LyraTestHandleTable.h"
+#include "Testing/LyraTestInstanceConfig.h"
+#include "Testing/LyraTestPerfCapture.h"
+#include "Testing/LyraTestSessionBootstrap.h"
+#include "Testing/LyraTestStats.h"
 #include "Testing/LyraTestSupportSubsystem.h"
+#include "Testing/LyraTestWorlds.h"
 #include "Character/LyraHealthComponent.h"
+#include "Equipment/LyraEquipmentInstance.h"
 #include "Engine/Engine.h"
 #include "Engine/World.h"
 #include "Engine/GameInstance.h"
 #include "GameFramework/PlayerController.h"
 #include "GameFramework/Pawn.h"
 #include "GameFramework/Character.h"
-#include "Kismet/GameplayStatics.h"
 #include "Camera/PlayerCameraManager.h"
 #include "Math/UnrealMathUtility.h"
+#include "Misc/Base64.h"
 #include "Teams/LyraTeamSubsystem.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraTestEnemyQuery)
 
-static bool IsAliveEnemyCharacter(ACharacter* Char, APawn* LocalPawn)
+static UWorld* GetWorldForAutomation(UObject* WorldContextObject)
 {
-	if (!Char || !Char->GetController()) return false;
-	if (Char->GetController()->IsPlayerController()) return false;
-	if (LocalPawn && Char == LocalPawn) return false;
-	if (ULyraHealthComponent* Health = ULyraHealthComponent::FindHealthComponent(Char))
-	{
-		if (Health->IsDeadOrDying()) return false;
-	}
-	return true;
+	return LyraTestWorlds::ResolveWorld(WorldContextObject);
 }
 
-static UWorld* GetWorldForAutomation(UObject* WorldContextObject)
+int64 ULyraTestEnemyQuery::GetTestObjectId(const UObject* Object)
 {
-	UWorld* World = nullptr;
-	if (GEngine && WorldContextObject)
+	return FLyraTestHandleTable::Get().GetHandle(Object);
+}
+
+UObject* ULyraTestEnemyQuery::ResolveTestObjectId(int64 Id)
+{
+	return FLyraTestHandleTable::Get().Resolve(Id);
+}
+
+static void FillHealth(FLyraTestSnapshotRecord& Record, const AActor* Actor)
+{
+	if (ULyraHealthComponent* Health = ULyraHealthComponent::FindHealthComponent(Actor))
 	{
-		World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull);
+		Record.Health = Health->GetHealth();
+		Record.MaxHealth = Health->GetMaxHealth();
+		Record.bAlive = !Health->IsDeadOrDying();
 	}
-	if (World)
+	else
 	{
-		return World;
+		Record.bAlive = Actor != nullptr;
 	}
-	if (GEngine)
+}
+
+// Resets OutSnapshot to the current frame and adds the local player's record (camera position when it has no pawn).
+static APlayerController* BeginSnapshot(UWorld* World, int32 PlayerIndex, FLyraTestSnapshot& OutSnapshot)
+{
+	OutSnapshot.Reset();
+	OutSnapshot.FrameNumber = static_cast<int64>(GFrameCounter);
+	OutSnapshot.WorldTimeSeconds = World->GetTimeSeconds();
+
+	APlayerController* LocalPC = ULyraTestSupportSubsystem::FindLocalPlayerController(World->GetGameInstance(), PlayerIndex);
+	APawn* LocalPawn = LocalPC ? LocalPC->GetPawn() : nullptr;
+	UObject* LocalViewAgent = LocalPawn ? static_cast<UObject*>(LocalPawn) : static_cast<UObject*>(LocalPC);
+	ULyraTeamSubsystem* TeamSub = World->GetSubsystem<ULyraTeamSubsystem>();
+	if (LocalPC)
 	{
-		World = GEngine->GetCurrentPlayWorld();
-		if (World)
+		FLyraTestSnapshotRecord& Record = OutSnapshot.Records.AddDefaulted_GetRef();
+		Record.Kind = ELyraTestSnapshotRecordKind::Player;
+		Record.Id = ULyraTestEnemyQuery::GetTestObjectId(LocalPawn);
+		Record.Actor = LocalPawn;
+		Record.TeamId = TeamSub && LocalViewAgent ? TeamSub->FindTeamFromObject(LocalViewAgent) : INDEX_NONE;
+		if (LocalPawn)
+		{
+			Record.Position = LocalPawn->GetActorLocation();
+			Record.Velocity = LocalPawn->GetVelocity();
+			FillHealth(Record, LocalPawn);
+		}
+		else if (APlayerCameraManager* PCM = LocalPC->PlayerCameraManager)
 		{
-			return World;
+			Record.Position = PCM->GetCameraLocation();
 		}
-		for (const FWorldContext& Ctx : GEngine->GetWorldContexts())
+		else
 		{
-			if (Ctx.WorldType == EWorldType::Game || Ctx.WorldType == EWorldType::PIE)
-			{
-				if (UWorld* CtxWorld = Ctx.World())
-				{
-					return CtxWorld;
-				}
-			}
+			Record.Position = LocalPC->GetFocalLocation();
 		}
 	}
-	return nullptr;
+	return LocalPC;
 }
 
-FString ULyraTestEnemyQuery::GetEnemyLocationsAsString(UObject* WorldContextObject, int32 PlayerIndex)
+// Player record plus alive characters; all of them, or only those matching SpatialQuery (nearest first).
+static bool BuildSnapshot(UWorld* World, int32 PlayerIndex, bool bEnemiesOnly, const FLyraTestSpatialQuery* SpatialQuery, FLyraTestSnapshot& OutSnapshot)
 {
-	UWorld* World = GetWorldForAutomation(WorldContextObject);
 	if (!World)
 	{
-		return FString();
+		OutSnapshot.Reset();
+		return false;
 	}
-
-	TArray<AActor*> Characters;
-	UGameplayStatics::GetAllActorsOfClass(World, ACharacter::StaticClass(), Characters);
-
-	UGameInstance* GI = World->GetGameInstance();
-	APlayerController* LocalPC = GI ? GI->GetFirstLocalPlayerController() : nullptr;
+	APlayerController* LocalPC = BeginSnapshot(World, PlayerIndex, OutSnapshot);
 	APawn* LocalPawn = LocalPC ? LocalPC->GetPawn() : nullptr;
+	UObject* LocalViewAgent = LocalPawn ? static_cast<UObject*>(LocalPawn) : static_cast<UObject*>(LocalPC);
+	ULyraTeamSubsystem* TeamSub = World->GetSubsystem<ULyraTeamSubsystem>();
 
-	FString Result;
-	for (AActor* Actor : Characters)
+	ULyraTestEnemyRegistry* Registry = World->GetSubsystem<ULyraTestEnemyRegistry>();
+	if (!Registry)
 	{
-		ACharacter* Char = Cast<ACharacter>(Actor);
-		if (!IsAliveEnemyCharacter(Char, LocalPawn))
-		{
-			continue;
-		}
-		const FVector Loc = Char->GetActorLocation();
-		if (Result.Len() > 0)
+		return true;
+	}
+
+	const bool bFilterTeams = bEnemiesOnly && TeamSub && LocalViewAgent;
+	const int32 LocalTeamId = bFilterTeams ? TeamSub->FindTeamFromObject(LocalViewAgent) : INDEX_NONE;
+	auto AddEnemyRecord = [&OutSnapshot, LocalPawn](ACharacter* Char, int32 TeamId, ULyraHealthComponent* Health)
+	{
+		if (Char == LocalPawn)
 		{
-			Result += TEXT("|");
+			return;
 		}
-		Result += FString::Printf(TEXT("%.2f,%.2f,%.2f"), Loc.X, Loc.Y, Loc.Z);
+		FLyraTestSnapshotRecord& Record = OutSnapshot.Records.AddDefaulted_GetRef();
+		Record.Kind = ELyraTestSnapshotRecordKind::Enemy;
+		Record.Id = ULyraTestEnemyQuery::GetTestObjectId(Char);
+		Record.Actor = Char;
+		Record.TeamId = TeamId;
+		Record.Position = Char->GetActorLocation();
+		Record.Velocity = Char->GetVelocity();
+		Record.Health = Health ? Health->GetHealth() : 0.f;
+		Record.MaxHealth = Health ? Health->GetMaxHealth() : 0.f;
+		Record.bAlive = true;
+	};
+
+	if (SpatialQuery)
+	{
+		TArray<int32> Indices;
+		Registry->FindAlive(*SpatialQuery, bFilterTeams, LocalTeamId, LocalPawn, Indices);
+		OutSnapshot.Records.Reserve(OutSnapshot.Records.Num() + Indices.Num());
+		Registry->ForEachAliveAt(Indices, AddEnemyRecord);
 	}
-	return Result;
+	else
+	{
+		OutSnapshot.Records.Reserve(OutSnapshot.Records.Num() + Registry->NumAlive());
+		Registry->ForEachAlive(bFilterTeams, LocalTeamId, AddEnemyRecord);
+	}
+	return true;
 }
 
-FString ULyraTestEnemyQuery::GetTestPositionsAsString(UObject* WorldContextObject, int32 PlayerIndex)
+bool ULyraTestEnemyQuery::BuildTestSnapshot(UWorld* World, int32 PlayerIndex, bool bEnemiesOnly, FLyraTestSnapshot& OutSnapshot)
 {
-	UWorld* World = GetWorldForAutomation(WorldContextObject);
-	if (!World)
+	LYRA_TEST_SCOPE(BuildSnapshot);
+	return BuildSnapshot(World, PlayerIndex, bEnemiesOnly, nullptr, OutSnapshot);
+}
+
+// Pawn for controllers and equipment, owner for components, the actor itself otherwise.
+static AActor* GetHandleRecordActor(UObject* Object)
+{
+	if (const AController* Controller = Cast<AController>(Object))
 	{
-		return FString();
+		return Controller->GetPawn();
 	}
+	if (const ULyraEquipmentInstance* Equipment = Cast<ULyraEquipmentInstance>(Object))
+	{
+		return Equipment->GetPawn();
+	}
+	if (const UActorComponent* Component = Cast<UActorComponent>(Object))
+	{
+		return Component->GetOwner();
+	}
+	return Cast<AActor>(Object);
+}
 
-	UGameInstance* GI = World->GetGameInstance();
-	APlayerController* LocalPC = GI ? GI->GetFirstLocalPlayerController() : nullptr;
-	APawn* LocalPawn = LocalPC ? LocalPC->GetPawn() : nullptr;
-
-	FString Result;
+bool ULyraTestEnemyQuery::BuildHandleSnapshot(UWorld* World, int32 PlayerIndex, TConstArrayView<int64> Ids, FLyraTestSnapshot& OutSnapshot)
+{
+	LYRA_TEST_SCOPE(BuildSnapshot);
+	if (!World)
+	{
+		OutSnapshot.Reset();
+		return false;
+	}
+	const APlayerController* LocalPC = BeginSnapshot(World, PlayerIndex, OutSnapshot);
+	const APawn* LocalPawn = LocalPC ? LocalPC->GetPawn() : nullptr;
+	const ULyraTeamSubsystem* TeamSub = World->GetSubsystem<ULyraTeamSubsystem>();
+	const FLyraTestHandleTable& Handles = FLyraTestHandleTable::Get();
 
-	if (LocalPC)
+	OutSnapshot.Records.Reserve(OutSnapshot.Records.Num() + Ids.Num());
+	for (const int64 Id : Ids)
 	{
-		FVector PlayerLoc;
-		if (LocalPawn)
+		FLyraTestSnapshotRecord& Record = OutSnapshot.Records.AddDefaulted_GetRef();
+		Record.Id = Id;
+		UObject* Object = Handles.Resolve(Id);
+		AActor* Actor = GetHandleRecordActor(Object);
+		// Handles are process wide; an actor of another world is not visible from this one.
+		if (!Actor || Actor->GetWorld() != World)
 		{
-			PlayerLoc = LocalPawn->GetActorLocation();
-		}
-		else if (APlayerCameraManager* PCM = LocalPC->PlayerCameraManager)
-		{
-			PlayerLoc = PCM->GetCameraLocation();
-		}
-		else
-		{
-			PlayerLoc = LocalPC->GetFocalLocation();
+			Record.bStale = Handles.IsStale(Id);
+			continue;
 		}
-		Result = FString::Printf(TEXT("P,%.2f,%.2f,%.2f"), PlayerLoc.X, PlayerLoc.Y, PlayerLoc.Z);
+		Record.Kind = Actor == LocalPawn ? ELyraTestSnapshotRecordKind::Player : ELyraTestSnapshotRecordKind::Enemy;
+		Record.Actor = Actor;
+		Record.TeamId = TeamSub ? TeamSub->FindTeamFromObject(Object) : INDEX_NONE;
+		Record.Position = Actor->GetActorLocation();
+		Record.Velocity = Actor->GetVelocity();
+		FillHealth(Record, Actor);
 	}
+	return true;
+}
+
+bool ULyraTestEnemyQuery::BuildTestVisibility(UWorld* World, int32 PlayerIndex, TConstArrayView<int64> Ids, FLyraTestVisibility& OutVisibility)
+{
+	FLyraTestSnapshot Snapshot;
+	const bool bBuilt = Ids.Num() > 0 ? BuildHandleSnapshot(World, PlayerIndex, Ids, Snapshot) : BuildTestSnapshot(World, PlayerIndex, true, Snapshot);
+	const APlayerController* PC = bBuilt ? ULyraTestSupportSubsystem::FindLocalPlayerController(World->GetGameInstance(), PlayerIndex) : nullptr;
+	OutVisibility.Evaluate(PC, Snapshot);
+	return PC != nullptr;
+}
+
+bool ULyraTestEnemyQuery::BuildSpatialTestSnapshot(UWorld* World, int32 PlayerIndex, bool bEnemiesOnly, const FLyraTestSpatialQuery& Query, FLyraTestSnapshot& OutSnapshot)
+{
+	LYRA_TEST_SCOPE(SpatialQuery);
+	return BuildSnapshot(World, PlayerIndex, bEnemiesOnly, &Query, OutSnapshot);
+}
 
-	TArray<AActor*> Characters;
-	UGameplayStatics::GetAllActorsOfClass(World, ACharacter::StaticClass(), Characters);
-	for (AActor* Actor : Characters)
+static FString FormatSnapshotPositions(const FLyraTestSnapshot& Snapshot, bool bIncludePlayer, bool bWithPrefix)
+{
+	FString Result;
+	Result.Reserve(Snapshot.Records.Num() * 32);
+	for (const FLyraTestSnapshotRecord& Record : Snapshot.Records)
 	{
-		ACharacter* Char = Cast<ACharacter>(Actor);
-		if (!IsAliveEnemyCharacter(Char, LocalPawn))
+		const bool bPlayer = Record.Kind == ELyraTestSnapshotRecordKind::Player;
+		if (bPlayer && !bIncludePlayer)
 		{
 			continue;
 		}
-		const FVector Loc = Char->GetActorLocation();
 		if (Result.Len() > 0)
 		{
 			Result += TEXT("|");
 		}
-		Result += FString::Printf(TEXT("E,%.2f,%.2f,%.2f"), Loc.X, Loc.Y, Loc.Z);
+		if (bWithPrefix)
+		{
+			Result += bPlayer ? TEXT("P,") : TEXT("E,");
+		}
+		Result += FString::Printf(TEXT("%.2f,%.2f,%.2f"), Record.Position.X, Record.Position.Y, Record.Position.Z);
 	}
 	return Result;
 }
 
-FString ULyraTestEnemyQuery::GetEnemyOnlyTestPositionsAsString(UObject* WorldContextObject, int32 PlayerIndex)
+FString ULyraTestEnemyQuery::GetEnemyLocationsAsString(UObject* WorldContextObject, int32 PlayerIndex)
 {
-	UWorld* World = GetWorldForAutomation(WorldContextObject);
-	if (!World)
+	LYRA_TEST_SCOPE(Query);
+	FLyraTestSnapshot Snapshot;
+	if (!BuildTestSnapshot(GetWorldForAutomation(WorldContextObject), PlayerIndex, false, Snapshot))
 	{
 		return FString();
 	}
+	return FormatSnapshotPositions(Snapshot, false, false);
+}
 
-	UGameInstance* GI = World->GetGameInstance();
-	APlayerController* LocalPC = GI ? GI->GetFirstLocalPlayerController() : nullptr;
-	APawn* LocalPawn = LocalPC ? LocalPC->GetPawn() : nullptr;
-	UObject* LocalViewAgent = LocalPawn ? static_cast<UObject*>(LocalPawn) : static_cast<UObject*>(LocalPC);
-
-	ULyraTeamSubsystem* TeamSub = World->GetSubsystem<ULyraTeamSubsystem>();
+FString ULyraTestEnemyQuery::GetTestPositionsAsString(UObject* WorldContextObject, int32 PlayerIndex)
+{
+	LYRA_TEST_SCOPE(Query);
+	FLyraTestSnapshot Snapshot;
+	if (!BuildTestSnapshot(GetWorldForAutomation(WorldContextObject), PlayerIndex, false, Snapshot))
+	{
+		return FString();
+	}
+	return FormatSnapshotPositions(Snapshot, true, true);
+}
 
-	FString Result;
-	if (LocalPC)
+FString ULyraTestEnemyQuery::GetEnemyOnlyTestPositionsAsString(UObject* WorldContextObject, int32 PlayerIndex)
+{
+	LYRA_TEST_SCOPE(Query);
+	FLyraTestSnapshot Snapshot;
+	if (!BuildTestSnapshot(GetWorldForAutomation(WorldContextObject), PlayerIndex, true, Snapshot))
 	{
-		FVector PlayerLoc;
-		if (LocalPawn)
-		{
-			PlayerLoc = LocalPawn->GetActorLocation();
-		}
-		else if (APlayerCameraManager* PCM = LocalPC->PlayerCameraManager)
-		{
-			PlayerLoc = PCM->GetCameraLocation();
-		}
-		else
-		{
-			PlayerLoc = LocalPC->GetFocalLocation();
-		}
-		Result = FString::Printf(TEXT("P,%.2f,%.2f,%.2f"), PlayerLoc.X, PlayerLoc.Y, PlayerLoc.Z);
+		return FString();
 	}
+	return FormatSnapshotPositions(Snapshot, true, true);
+}
+
+bool ULyraTestEnemyQuery::GetTestSnapshot(UObject* WorldContextObject, int32 PlayerIndex, bool bEnemiesOnly, FLyraTestSnapshot& OutSnapshot)
+{
+	LYRA_TEST_SCOPE(Query);
+	return BuildTestSnapshot(GetWorldForAutomation(WorldContextObject), PlayerIndex, bEnemiesOnly, OutSnapshot);
+}
 
-	TArray<AActor*> Characters;
-	UGameplayStatics::GetAllActorsOfClass(World, ACharacter::StaticClass(), Characters);
-	for (AActor* Actor : Characters)
+TArray<uint8> ULyraTestEnemyQuery::GetTestSnapshotBytes(UObject* WorldContextObject, int32 PlayerIndex, bool bEnemiesOnly)
+{
+	LYRA_TEST_SCOPE(Query);
+	TArray<uint8> Bytes;
+	FLyraTestSnapshot Snapshot;
+	if (BuildTestSnapshot(GetWorldForAutomation(WorldContextObject), PlayerIndex, bEnemiesOnly, Snapshot))
 	{
-		ACharacter* Char = Cast<ACharacter>(Actor);
-		if (!IsAliveEnemyCharacter(Char, LocalPawn))
-		{
-			continue;
-		}
-		if (TeamSub && LocalViewAgent)
-		{
-			if (TeamSub->CompareTeams(LocalViewAgent, Char) != ELyraTeamComparison::DifferentTeams)
-			{
-				continue;
-			}
-		}
-		const FVector Loc = Char->GetActorLocation();
-		if (Result.Len() > 0)
-		{
-			Result += TEXT("|");
-		}
-		Result += FString::Printf(TEXT("E,%.2f,%.2f,%.2f"), Loc.X, Loc.Y, Loc.Z);
+		Snapshot.SerializeToBytes(Bytes);
 	}
-	return Result;
+	return Bytes;
 }
 
-static void ApplyLocalPlayerLookAt(UWorld* World, float TargetX, float TargetY, float TargetZ)
+FString ULyraTestEnemyQuery::GetTestSnapshotBase64(UObject* WorldContextObject, int32 PlayerIndex, bool bEnemiesOnly)
 {
-	UGameInstance* GI = World->GetGameInstance();
-	if (!GI) return;
-	APlayerController* PC = GI->GetFirstLocalPlayerController();
-	if (!PC) return;
+	LYRA_TEST_SCOPE(Query);
+	const TArray<uint8> Bytes = GetTestSnapshotBytes(WorldContextObject, PlayerIndex, bEnemiesOnly);
+	return Bytes.Num() > 0 ? FBase64::Encode(Bytes) : FString();
+}
+
+static APlayerController* GetLocalPlayerViewPoint(UWorld* World, int32 PlayerIndex, FVector& OutLocation, FRotator& OutRotation)
+{
+	UGameInstance* GI = World ? World->GetGameInstance() : nullptr;
+	APlayerController* PC = GI ? ULyraTestSupportSubsystem::FindLocalPlayerController(GI, PlayerIndex) : nullptr;
+	if (!PC) return nullptr;
 
-	FVector ViewLocation;
-	FRotator ViewRotation;
 	if (APlayerCameraManager* PCM = PC->PlayerCameraManager)
 	{
-		PCM->GetCameraViewPoint(ViewLocation, ViewRotation);
+		PCM->GetCameraViewPoint(OutLocation, OutRotation);
 	}
 	else
 	{
-		PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+		PC->GetPlayerViewPoint(OutLocation, OutRotation);
+	}
+	return PC;
+}
+
+static FString EncodeSnapshotBase64(const FLyraTestSnapshot& Snapshot)
+{
+	TArray<uint8> Bytes;
+	Snapshot.SerializeToBytes(Bytes);
+	return FBase64::Encode(Bytes);
+}
+
+bool ULyraTestEnemyQuery::GetSpatialTestSnapshot(UObject* WorldContextObject, int32 PlayerIndex, bool bEnemiesOnly, const FLyraTestSpatialQuery& Query, FLyraTestSnapshot& OutSnapshot)
+{
+	return BuildSpatialTestSnapshot(GetWorldForAutomation(WorldContextObject), PlayerIndex, bEnemiesOnly, Query, OutSnapshot);
+}
+
+int64 ULyraTestEnemyQuery::FindNearestEnemyId(UObject* WorldContextObject, int32 PlayerIndex, float X, float Y, float Z, float MaxDistance)
+{
+	FLyraTestSpatialQuery Query;
+	Query.Shape = ELyraTestSpatialQueryShape::Nearest;
+	Query.Origin = FVector(X, Y, Z);
+	Query.Count = 1;
+	Query.Distance = MaxDistance;
+	FLyraTestSnapshot Snapshot;
+	if (!BuildSpatialTestSnapshot(GetWorldForAutomation(WorldContextObject), PlayerIndex, true, Query, Snapshot))
+	{
+		return 0;
 	}
+	const FLyraTestSnapshotRecord* Nearest = Snapshot.Records.FindByPredicate([](const FLyraTestSnapshotRecord& Record)
+	{
+		return Record.Kind == ELyraTestSnapshotRecordKind::Enemy;
+	});
+	return Nearest ? Nearest->Id : 0;
+}
+
+FString ULyraTestEnemyQuery::GetNearestEnemiesBase64(UObject* WorldContextObject, int32 PlayerIndex, float X, float Y, float Z, int32 Count, float MaxDistance, bool bEnemiesOnly)
+{
+	FLyraTestSpatialQuery Query;
+	Query.Shape = ELyraTestSpatialQueryShape::Nearest;
+	Query.Origin = FVector(X, Y, Z);
+	Query.Count = Count;
+	Query.Distance = MaxDistance;
+	FLyraTestSnapshot Snapshot;
+	return BuildSpatialTestSnapshot(GetWorldForAutomation(WorldContextObject), PlayerIndex, bEnemiesOnly, Query, Snapshot) ? EncodeSnapshotBase64(Snapshot) : FString();
+}
+
+FString ULyraTestEnemyQuery::GetEnemiesInRadiusBase64(UObject* WorldContextObject, int32 PlayerIndex, float X, float Y, float Z, float Radius, bool bEnemiesOnly)
+{
+	FLyraTestSpatialQuery Query;
+	Query.Shape = ELyraTestSpatialQueryShape::Radius;
+	Query.Origin = FVector(X, Y, Z);
+	Query.Distance = Radius;
+	FLyraTestSnapshot Snapshot;
+	return BuildSpatialTestSnapshot(GetWorldForAutomation(WorldContextObject), PlayerIndex, bEnemiesOnly, Query, Snapshot) ? EncodeSnapshotBase64(Snapshot) : FString();
+}
+
+FString ULyraTestEnemyQuery::GetEnemiesInViewConeBase64(UObject* WorldContextObject, int32 PlayerIndex, float HalfAngleDegrees, float MaxDistance, bool bEnemiesOnly)
+{
+	UWorld* World = GetWorldForAutomation(WorldContextObject);
+	FRotator ViewRotation;
+	FLyraTestSpatialQuery Query;
+	if (!GetLocalPlayerViewPoint(World, PlayerIndex, Query.Origin, ViewRotation))
+	{
+		return FString();
+	}
+	Query.Shape = ELyraTestSpatialQueryShape::Cone;
+	Query.Direction = ViewRotation.Vector();
+	Query.HalfAngleDegrees = HalfAngleDegrees;
+	Query.Distance = MaxDistance;
+	FLyraTestSnapshot Snapshot;
+	return BuildSpatialTestSnapshot(World, PlayerIndex, bEnemiesOnly, Query, Snapshot) ? EncodeSnapshotBase64(Snapshot) : FString();
+}
+
+static void ApplyLocalPlayerLookAt(UWorld* World, int32 PlayerIndex, float TargetX, float TargetY, float TargetZ)
+{
+	FVector ViewLocation;
+	FRotator ViewRotation;
+	APlayerController* PC = GetLocalPlayerViewPoint(World, PlayerIndex, ViewLocation, ViewRotation);
+	if (!PC) return;
 
 	FVector Dir = (FVector(TargetX, TargetY, TargetZ) - ViewLocation).GetSafeNormal();
 	if (Dir.IsNearlyZero()) return;
@@ -233,6 +406,7 @@ static void ApplyLocalPlayerLookAt(UWorld* World, float TargetX, float TargetY,
 
 FString ULyraTestEnemyQuery::GetEnemyOnlyPositionsAndAimAt(UObject* WorldContextObject, int32 PlayerIndex, float TargetX, float TargetY, float TargetZ, bool bFire)
 {
+	LYRA_TEST_SCOPE(Query);
 	UWorld* World = GetWorldForAutomation(WorldContextObject);
 	if (!World)
 	{
@@ -242,51 +416,343 @@ FString ULyraTestEnemyQuery::GetEnemyOnlyPositionsAndAimAt(UObject* WorldContext
 	UGameInstance* GI = World->GetGameInstance();
 	if (ULyraTestSupportSubsystem* Sub = GI ? GI->GetSubsystem<ULyraTestSupportSubsystem>() : nullptr)
 	{
-		Sub->SetLocalPlayerLookAtWorldPosition(TargetX, TargetY, TargetZ);
+		Sub->SetPlayerLookAtWorldPosition(PlayerIndex, TargetX, TargetY, TargetZ);
 		if (bFire)
 		{
-			Sub->SimulatePrimaryFire();
+			Sub->SimulatePrimaryFireForPlayer(PlayerIndex);
 		}
 	}
 	else
 	{
-		ApplyLocalPlayerLookAt(World, TargetX, TargetY, TargetZ);
+		ApplyLocalPlayerLookAt(World, PlayerIndex, TargetX, TargetY, TargetZ);
 	}
 
 	return GetEnemyOnlyTestPositionsAsString(WorldContextObject, PlayerIndex);
 }
 
-void ULyraTestEnemyQuery::SetLocalPlayerInvincible(UObject* WorldContextObject, bool bEnable)
+void ULyraTestEnemyQuery::SetLocalPlayerInvincible(UObject* WorldContextObject, bool bEnable, int32 PlayerIndex)
 {
+	LYRA_TEST_SCOPE(Cheats);
 	UWorld* World = GetWorldForAutomation(WorldContextObject);
 	if (!World) return;
 	UGameInstance* GI = World->GetGameInstance();
 	if (!GI) return;
 	if (ULyraTestSupportSubsystem* Sub = GI->GetSubsystem<ULyraTestSupportSubsystem>())
 	{
-		Sub->SetLocalPlayerInvincible(bEnable);
+		Sub->SetPlayerInvincible(PlayerIndex, bEnable);
 	}
 }
 
-void ULyraTestEnemyQuery::SetLocalPlayerInfiniteAmmo(UObject* WorldContextObject, bool bEnable)
+void ULyraTestEnemyQuery::SetLocalPlayerInfiniteAmmo(UObject* WorldContextObject, bool bEnable, int32 PlayerIndex)
 {
+	LYRA_TEST_SCOPE(Cheats);
 	UWorld* World = GetWorldForAutomation(WorldContextObject);
 	if (!World) return;
 	UGameInstance* GI = World->GetGameInstance();
 	if (!GI) return;
 	if (ULyraTestSupportSubsystem* Sub = GI->GetSubsystem<ULyraTestSupportSubsystem>())
 	{
-		Sub->SetLocalPlayerInfiniteAmmo(bEnable);
+		Sub->SetPlayerInfiniteAmmo(PlayerIndex, bEnable);
 	}
 }
 
+int32 ULyraTestEnemyQuery::GetLocalPlayerCheatState(UObject* WorldContextObject, int32 PlayerIndex)
+{
+	LYRA_TEST_SCOPE(Cheats);
+	UWorld* World = GetWorldForAutomation(WorldContextObject);
+	UGameInstance* GI = World ? World->GetGameInstance() : nullptr;
+	const ULyraTestSupportSubsystem* Sub = GI ? GI->GetSubsystem<ULyraTestSupportSubsystem>() : nullptr;
+	return Sub ? Sub->GetPlayerCheatState(PlayerIndex) : 0;
+}
+
 int64 ULyraTestEnemyQuery::GetLocalPlayerPawnId(UObject* WorldContextObject, int32 PlayerIndex)
 {
+	LYRA_TEST_SCOPE(Query);
 	UWorld* World = GetWorldForAutomation(WorldContextObject);
 	if (!World) return 0;
-	UGameInstance* GI = World->GetGameInstance();
-	APlayerController* LocalPC = GI ? GI->GetFirstLocalPlayerController() : nullptr;
+	APlayerController* LocalPC = ULyraTestSupportSubsystem::FindLocalPlayerController(World->GetGameInstance(), PlayerIndex);
 	APawn* LocalPawn = LocalPC ? LocalPC->GetPawn() : nullptr;
-	if (!LocalPawn) return 0;
-	return static_cast<int64>(reinterpret_cast<uintptr_t>(LocalPawn));
+	return GetTestObjectId(LocalPawn);
+}
+
+int64 ULyraTestEnemyQuery::GetLocalPlayerControllerId(UObject* WorldContextObject, int32 PlayerIndex)
+{
+	LYRA_TEST_SCOPE(Query);
+	UWorld* World = GetWorldForAutomation(WorldContextObject);
+	if (!World) return 0;
+	return GetTestObjectId(ULyraTestSupportSubsystem::FindLocalPlayerController(World->GetGameInstance(), PlayerIndex));
+}
+
+static void ParseTestHandles(const FString& Ids, TArray<int64, TInlineAllocator<32>>& OutHandles)
+{
+	TArray<FString> IdStrings;
+	Ids.ParseIntoArray(IdStrings, TEXT(","));
+	for (const FString& Id : IdStrings)
+	{
+		OutHandles.Add(FCString::Atoi64(*Id.TrimStartAndEnd()));
+	}
+}
+
+FString ULyraTestEnemyQuery::ResolveTestHandlesBase64(UObject* WorldContextObject, int32 PlayerIndex, const FString& Ids)
+{
+	LYRA_TEST_SCOPE(Query);
+	TArray<int64, TInlineAllocator<32>> Handles;
+	ParseTestHandles(Ids, Handles);
+	FLyraTestSnapshot Snapshot;
+	return BuildHandleSnapshot(GetWorldForAutomation(WorldContextObject), PlayerIndex, Handles, Snapshot) ? EncodeSnapshotBase64(Snapshot) : FString();
+}
+
+FString ULyraTestEnemyQuery::GetTestObjectName(UObject* WorldContextObject, int64 Id)
+{
+	LYRA_TEST_SCOPE(Query);
+	const UObject* Object = ResolveTestObjectId(Id);
+	return Object ? Object->GetName() : FString();
+}
+
+bool ULyraTestEnemyQuery::IsTestHandleStale(UObject* WorldContextObject, int64 Id)
+{
+	return FLyraTestHandleTable::Get().IsStale(Id);
+}
+
+bool ULyraTestEnemyQuery::GetTestVisibility(UObject* WorldContextObject, int32 PlayerIndex, const FString& Ids, FLyraTestVisibility& OutVisibility)
+{
+	LYRA_TEST_SCOPE(Query);
+	TArray<int64, TInlineAllocator<32>> Handles;
+	ParseTestHandles(Ids, Handles);
+	return BuildTestVisibility(GetWorldForAutomation(WorldContextObject), PlayerIndex, Handles, OutVisibility);
+}
+
+FString ULyraTestEnemyQuery::GetTestVisibilityBase64(UObject* WorldContextObject, int32 PlayerIndex, const FString& Ids)
+{
+	LYRA_TEST_SCOPE(Query);
+	FLyraTestVisibility Visibility;
+	if (!GetTestVisibility(WorldContextObject, PlayerIndex, Ids, Visibility))
+	{
+		return FString();
+	}
+	TArray<uint8> Bytes;
+	Visibility.SerializeToBytes(Bytes);
+	return FBase64::Encode(Bytes);
+}
+
+int64 ULyraTestEnemyQuery::GetLatestTestEventSequence(UObject* WorldContextObject)
+{
+	LYRA_TEST_SCOPE(EventQuery);
+	UWorld* World = GetWorldForAutomation(WorldContextObject);
+	ULyraTestEventPublisher* Publisher = ULyraTestEventPublisher::Get(World);
+	return Publisher ? Publisher->GetLatestEventSequence() : 0;
+}
+
+FString ULyraTestEnemyQuery::GetTestEventsSinceBase64(UObject* WorldContextObject, int64 SinceSequence, int32 MaxEvents)
+{
+	LYRA_TEST_SCOPE(EventQuery);
+	UWorld* World = GetWorldForAutomation(WorldContextObject);
+	ULyraTestEventPublisher* Publisher = ULyraTestEventPublisher::Get(World);
+	return Publisher ? Publisher->GetEventsSinceBase64(SinceSequence, MaxEvents) : FString();
+}
+
+static ULyraTestSupportSubsystem* GetTestSupportSubsystem(UObject* WorldContextObject)
+{
+	UWorld* World = GetWorldForAutomation(WorldContextObject);
+	UGameInstance* GI = World ? World->GetGameInstance() : nullptr;
+	return GI ? GI->GetSubsystem<ULyraTestSupportSubsystem>() : nullptr;
+}
+
+static ULyraTestSessionBootstrap* GetSessionBootstrap(UObject* WorldContextObject)
+{
+	const UWorld* World = GetWorldForAutomation(WorldContextObject);
+	const UGameInstance* GI = World ? World->GetGameInstance() : nullptr;
+	return GI ? GI->GetSubsystem<ULyraTestSessionBootstrap>() : nullptr;
+}
+
+static ULyraTestBotLod* GetBotLod(UObject* WorldContextObject)
+{
+	const UWorld* World = GetWorldForAutomation(WorldContextObject);
+	const UGameInstance* GI = World ? World->GetGameInstance() : nullptr;
+	return GI ? GI->GetSubsystem<ULyraTestBotLod>() : nullptr;
+}
+
+int64 ULyraTestEnemyQuery::GetLatestCombatSequence(UObject* WorldContextObject)
+{
+	LYRA_TEST_SCOPE(CombatQuery);
+	ULyraTestSupportSubsystem* Sub = GetTestSupportSubsystem(WorldContextObject);
+	return Sub ? Sub->GetLatestCombatSequence() : 0;
+}
+
+FString ULyraTestEnemyQuery::GetCombatLogSinceBase64(UObject* WorldContextObject, int64 SinceSequence, int32 MaxRecords)
+{
+	LYRA_TEST_SCOPE(CombatQuery);
+	ULyraTestSupportSubsystem* Sub = GetTestSupportSubsystem(WorldContextObject);
+	return Sub ? Sub->GetCombatLogSinceBase64(SinceSequence, MaxRecords) : FString();
+}
+
+int64 ULyraTestEnemyQuery::FindKillSince(UObject* WorldContextObject, int64 SinceSequence, int64 VictimId, int64 InstigatorId)
+{
+	LYRA_TEST_SCOPE(CombatQuery);
+	ULyraTestSupportSubsystem* Sub = GetTestSupportSubsystem(WorldContextObject);
+	return Sub ? Sub->FindKillSince(SinceSequence, VictimId, InstigatorId) : 0;
+}
+
+FString ULyraTestEnemyQuery::ExecuteTestCommands(UObject* WorldContextObject, int32 PlayerIndex, const FString& Commands)
+{
+	LYRA_TEST_SCOPE(CommandBatch);
+	ULyraTestSupportSubsystem* Sub = GetTestSupportSubsystem(WorldContextObject);
+	return Sub ? Sub->ExecuteCommandBatch(PlayerIndex, Commands) : FString();
+}
+
+FString ULyraTestEnemyQuery::GetTestCommandResults(UObject* WorldContextObject, int64 BatchId)
+{
+	LYRA_TEST_SCOPE(CommandBatch);
+	ULyraTestSupportSubsystem* Sub = GetTestSupportSubsystem(WorldContextObject);
+	return Sub ? Sub->GetCommandBatchResults(BatchId) : FString();
+}
+
+int64 ULyraTestEnemyQuery::StartTestSession(UObject* WorldContextObject, const FString& MapName, const FString& Experience, int32 PlayerIndex, bool bSkipWarmup, float TimeoutSeconds)
+{
+	LYRA_TEST_SCOPE(Session);
+	ULyraTestSessionBootstrap* Bootstrap = GetSessionBootstrap(WorldContextObject);
+	if (!Bootstrap)
+	{
+		return 0;
+	}
+	FLyraTestSessionSettings SessionSettings;
+	SessionSettings.MapName = MapName;
+	SessionSettings.Experience = Experience;
+	SessionSettings.BotCount = LyraTestInstanceConfig::Get().BotCount;
+	SessionSettings.PlayerIndex = PlayerIndex;
+	SessionSettings.bSkipWarmup = bSkipWarmup;
+	SessionSettings.TimeoutSeconds = TimeoutSeconds;
+	return Bootstrap->StartSession(SessionSettings);
+}
+
+int32 ULyraTestEnemyQuery::GetTestSessionState(UObject* WorldContextObject, int64 Token)
+{
+	LYRA_TEST_SCOPE(Session);
+	const ULyraTestSessionBootstrap* Bootstrap = GetSessionBootstrap(WorldContextObject);
+	return static_cast<int32>(Bootstrap ? Bootstrap->GetSessionState(Token) : ELyraTestSessionState::None);
+}
+
+FString ULyraTestEnemyQuery::GetTestSessionFailure(UObject* WorldContextObject, int64 Token)
+{
+	LYRA_TEST_SCOPE(Session);
+	const ULyraTestSessionBootstrap* Bootstrap = GetSessionBootstrap(WorldContextObject);
+	return Bootstrap ? Bootstrap->GetSessionFailure(Token) : FString();
+}
+
+int32 ULyraTestEnemyQuery::GetTestWorldId(UObject* WorldContextObject)
+{
+	return LyraTestWorlds::GetWorldId(GetWorldForAutomation(WorldContextObject));
+}
+
+FString ULyraTestEnemyQuery::GetTestWorldsAsString(UObject* WorldContextObject)
+{
+	return LyraTestWorlds::ToJson();
+}
+
+FString ULyraTestEnemyQuery::GetTestInstanceConfig(UObject* WorldContextObject)
+{
+	LYRA_TEST_SCOPE(Session);
+	return LyraTestInstanceConfig::ToJson(LyraTestInstanceConfig::Get());
+}
+
+bool ULyraTestEnemyQuery::SetTestBotLodEnabled(UObject* WorldContextObject, bool bEnable, float FullDistance, float ReducedDistance, float FreezeDistance)
+{
+	LYRA_TEST_SCOPE(BotLod);
+	ULyraTestBotLod* BotLod = GetBotLod(WorldContextObject);
+	if (!BotLod)
+	{
+		return false;
+	}
+	FLyraTestBotLodSettings Settings = BotLod->GetBotLodSettings();
+	Settings.FullDistance = FullDistance;
+	Settings.ReducedDistance = ReducedDistance;
+	Settings.FreezeDistance = FreezeDistance;
+	BotLod->SetBotLodSettings(Settings);
+	BotLod->SetBotLodEnabled(bEnable);
+	return true;
+}
+
+FString ULyraTestEnemyQuery::GetTestBotLodCounts(UObject* WorldContextObject)
+{
+	LYRA_TEST_SCOPE(BotLod);
+	const ULyraTestBotLod* BotLod = GetBotLod(WorldContextObject);
+	return BotLod ? BotLod->GetBotLodCountsJson() : FString();
+}
+
+int64 ULyraTestEnemyQuery::ResetTestWorld(UObject* WorldContextObject, int32 PlayerIndex, int32 PlayerStartIndex, int32 BotCount, const FString& BotTeamIds, int32 PlayerTeamId)
+{
+	LYRA_TEST_SCOPE(WorldReset);
+	ULyraTestSupportSubsystem* Sub = GetTestSupportSubsystem(WorldContextObject);
+	if (!Sub)
+	{
+		return 0;
+	}
+	FLyraTestWorldResetSettings Settings;
+	Settings.PlayerIndex = PlayerIndex;
+	Settings.PlayerStartIndex = PlayerStartIndex;
+	Settings.BotCount = BotCount;
+	Settings.PlayerTeamId = PlayerTeamId;
+	TArray<FString> TeamIds;
+	BotTeamIds.ParseIntoArray(TeamIds, TEXT(","));
+	for (const FString& TeamId : TeamIds)
+	{
+		Settings.BotTeamIds.Add(FCString::Atoi(*TeamId.TrimStartAndEnd()));
+	}
+	return Sub->ResetWorld(Settings);
+}
+
+int32 ULyraTestEnemyQuery::GetTestWorldResetState(UObject* WorldContextObject, int64 ResetId)
+{
+	LYRA_TEST_SCOPE(WorldReset);
+	const ULyraTestSupportSubsystem* Sub = GetTestSupportSubsystem(WorldContextObject);
+	const FLyraTestWorldResetResult Result = Sub ? Sub->GetWorldResetResult() : FLyraTestWorldResetResult();
+	if (ResetId == 0 || Result.ResetId != ResetId)
+	{
+		return 0;
+	}
+	return !Result.bComplete ? 1 : Result.bSucceeded ? 2 : 3;
+}
+
+FString ULyraTestEnemyQuery::GetTestStatsSummary(UObject* WorldContextObject, bool bReset)
+{
+	FString Summary = LyraTestStats::BuildSummary();
+	if (bReset)
+	{
+		LyraTestStats::Reset();
+	}
+	return Summary;
+}
+
+bool ULyraTestEnemyQuery::BeginTestPerfCapture(UObject* WorldContextObject, const FString& Name, float HitchThresholdMs)
+{
+	LYRA_TEST_SCOPE(PerfCapture);
+	ULyraTestSupportSubsystem* Sub = GetTestSupportSubsystem(WorldContextObject);
+	if (!Sub)
+	{
+		return false;
+	}
+	Sub->BeginPerfCapture(Name, HitchThresholdMs);
+	return true;
+}
+
+FString ULyraTestEnemyQuery::EndTestPerfCapture(UObject* WorldContextObject, const FString& BaselineDirectory, bool bUpdateBaseline)
+{
+	LYRA_TEST_SCOPE(PerfCapture);
+	ULyraTestSupportSubsystem* Sub = GetTestSupportSubsystem(WorldContextObject);
+	const FLyraTestPerfCaptureResult Result = Sub ? Sub->EndPerfCapture() : FLyraTestPerfCaptureResult();
+	if (!Result.bValid)
+	{
+		return FString();
+	}
+	const FLyraTestPerfComparison Comparison = Sub->ComparePerfCaptureToBaseline(Result, BaselineDirectory, FLyraTestPerfGateSettings());
+	const bool bBaselineWritten = ((Comparison.bPassed && !Comparison.bBaselineFound) || bUpdateBaseline) && LyraTestPerfCapture::SaveBaseline(Result, BaselineDirectory);
+
+	FString Regressions;
+	for (const FString& Regression : Comparison.Regressions)
+	{
+		Regressions += FString::Printf(TEXT("%s\"%s\""), Regressions.IsEmpty() ? TEXT("") : TEXT(", "), *Regression.ReplaceCharWithEscapedChar());
+	}
+	return FString::Printf(TEXT("{\"capture\": %s, \"comparison\": {\"baselinePath\": \"%s\", \"baselineFound\": %s, \"passed\": %s, \"baselineWritten\": %s, \"regressions\": [%s]}}"),
+		*LyraTestPerfCapture::ToJson(Result), *Comparison.BaselinePath.ReplaceCharWithEscapedChar(), Comparison.bBaselineFound ? TEXT("true") : TEXT("false"),
+		Comparison.bPassed ? TEXT("true") : TEXT("false"), bBaselineWritten ? TEXT("true") : TEXT("false"), *Regressions);
 }
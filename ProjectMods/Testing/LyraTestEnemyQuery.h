@@ -3,6 +3,9 @@
 #pragma once
 
 #include "Kismet/BlueprintFunctionLibrary.h"
+#include "Testing/LyraTestEnemyRegistry.h"
+#include "Testing/LyraTestSnapshot.h"
+#include "Testing/LyraTestVisibility.h"
 #include "LyraTestEnemyQuery.generated.h"
 
 UCLASS(meta = (DisplayName = "Lyra Test Enemy Query"))
@@ -20,15 +23,171 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Test|Automation", meta = (WorldContext = "WorldContextObject"))
 	static FString GetEnemyOnlyTestPositionsAsString(UObject* WorldContextObject, int32 PlayerIndex = 0);
 
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation", meta = (WorldContext = "WorldContextObject"))
+	static bool GetTestSnapshot(UObject* WorldContextObject, int32 PlayerIndex, bool bEnemiesOnly, FLyraTestSnapshot& OutSnapshot);
+
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation", meta = (WorldContext = "WorldContextObject"))
+	static TArray<uint8> GetTestSnapshotBytes(UObject* WorldContextObject, int32 PlayerIndex = 0, bool bEnemiesOnly = true);
+
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation", meta = (WorldContext = "WorldContextObject"))
+	static FString GetTestSnapshotBase64(UObject* WorldContextObject, int32 PlayerIndex = 0, bool bEnemiesOnly = true);
+
+	/** Snapshot of the player plus only the characters matching Query, nearest to Query.Origin first. */
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation", meta = (WorldContext = "WorldContextObject"))
+	static bool GetSpatialTestSnapshot(UObject* WorldContextObject, int32 PlayerIndex, bool bEnemiesOnly, const FLyraTestSpatialQuery& Query, FLyraTestSnapshot& OutSnapshot);
+
+	/** Id of the enemy nearest to the point within MaxDistance (0 = any distance), or 0 if none. */
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation", meta = (WorldContext = "WorldContextObject"))
+	static int64 FindNearestEnemyId(UObject* WorldContextObject, int32 PlayerIndex, float X, float Y, float Z, float MaxDistance = 0.f);
+
+	/** Base64 snapshot (same format as GetTestSnapshotBase64) of the player and the Count nearest enemies to the point. */
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation", meta = (WorldContext = "WorldContextObject"))
+	static FString GetNearestEnemiesBase64(UObject* WorldContextObject, int32 PlayerIndex, float X, float Y, float Z, int32 Count = 1, float MaxDistance = 0.f, bool bEnemiesOnly = true);
+
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation", meta = (WorldContext = "WorldContextObject"))
+	static FString GetEnemiesInRadiusBase64(UObject* WorldContextObject, int32 PlayerIndex, float X, float Y, float Z, float Radius, bool bEnemiesOnly = true);
+
+	/** Enemies within HalfAngleDegrees of the player's camera direction and MaxDistance (0 = any distance), nearest first. */
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation", meta = (WorldContext = "WorldContextObject"))
+	static FString GetEnemiesInViewConeBase64(UObject* WorldContextObject, int32 PlayerIndex, float HalfAngleDegrees, float MaxDistance = 0.f, bool bEnemiesOnly = true);
+
+	/** Screen position, bounds, crosshair offset and occlusion for every alive enemy (empty Ids) or each comma separated handle, in one frame. */
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation", meta = (WorldContext = "WorldContextObject"))
+	static bool GetTestVisibility(UObject* WorldContextObject, int32 PlayerIndex, const FString& Ids, FLyraTestVisibility& OutVisibility);
+
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation", meta = (WorldContext = "WorldContextObject"))
+	static FString GetTestVisibilityBase64(UObject* WorldContextObject, int32 PlayerIndex = 0, const FString& Ids = TEXT(""));
+
 	UFUNCTION(BlueprintCallable, Category = "Test|Automation", meta = (WorldContext = "WorldContextObject"))
 	static FString GetEnemyOnlyPositionsAndAimAt(UObject* WorldContextObject, int32 PlayerIndex, float TargetX, float TargetY, float TargetZ, bool bFire = false);
 
 	UFUNCTION(BlueprintCallable, Category = "Test|Automation", meta = (WorldContext = "WorldContextObject"))
-	static void SetLocalPlayerInvincible(UObject* WorldContextObject, bool bEnable);
+	static void SetLocalPlayerInvincible(UObject* WorldContextObject, bool bEnable, int32 PlayerIndex = 0);
+
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation", meta = (WorldContext = "WorldContextObject"))
+	static void SetLocalPlayerInfiniteAmmo(UObject* WorldContextObject, bool bEnable, int32 PlayerIndex = 0);
 
+	/** ULyraTestSupportSubsystem::GetPlayerCheatState; cheats set through the subsystem persist across respawns. */
 	UFUNCTION(BlueprintCallable, Category = "Test|Automation", meta = (WorldContext = "WorldContextObject"))
-	static void SetLocalPlayerInfiniteAmmo(UObject* WorldContextObject, bool bEnable);
+	static int32 GetLocalPlayerCheatState(UObject* WorldContextObject, int32 PlayerIndex = 0);
 
 	UFUNCTION(BlueprintCallable, Category = "Test|Automation", meta = (WorldContext = "WorldContextObject"))
 	static int64 GetLocalPlayerPawnId(UObject* WorldContextObject, int32 PlayerIndex = 0);
+
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation", meta = (WorldContext = "WorldContextObject"))
+	static int64 GetLatestTestEventSequence(UObject* WorldContextObject);
+
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation", meta = (WorldContext = "WorldContextObject"))
+	static FString GetTestEventsSinceBase64(UObject* WorldContextObject, int64 SinceSequence, int32 MaxEvents = 0);
+
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation", meta = (WorldContext = "WorldContextObject"))
+	static int64 GetLatestCombatSequence(UObject* WorldContextObject);
+
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation", meta = (WorldContext = "WorldContextObject"))
+	static FString GetCombatLogSinceBase64(UObject* WorldContextObject, int64 SinceSequence, int32 MaxRecords = 0);
+
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation", meta = (WorldContext = "WorldContextObject"))
+	static int64 FindKillSince(UObject* WorldContextObject, int64 SinceSequence, int64 VictimId = 0, int64 InstigatorId = 0);
+
+	/** Executes a LyraTestCommandBatch command list in this frame (up to the first wait) and returns the packed results as base64. */
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation", meta = (WorldContext = "WorldContextObject"))
+	static FString ExecuteTestCommands(UObject* WorldContextObject, int32 PlayerIndex, const FString& Commands);
+
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation", meta = (WorldContext = "WorldContextObject"))
+	static FString GetTestCommandResults(UObject* WorldContextObject, int64 BatchId);
+
+	/**
+	 * Loads MapName with Experience (empty map: the current one) through ULyraTestSessionBootstrap and returns a token;
+	 * the instance configuration's bot count applies to the load. A SessionReady event with Value = token is published
+	 * once the pawn is ready and warm-up is over.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation", meta = (WorldContext = "WorldContextObject"))
+	static int64 StartTestSession(UObject* WorldContextObject, const FString& MapName, const FString& Experience, int32 PlayerIndex = 0, bool bSkipWarmup = true, float TimeoutSeconds = 120.f);
+
+	/** ELyraTestSessionState of the session as an int; 0 (None) for unknown or superseded tokens. */
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation", meta = (WorldContext = "WorldContextObject"))
+	static int32 GetTestSessionState(UObject* WorldContextObject, int64 Token);
+
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation", meta = (WorldContext = "WorldContextObject"))
+	static FString GetTestSessionFailure(UObject* WorldContextObject, int64 Token);
+
+	/** LyraTestWorlds id of the context object's world; -1 when it has none or several worlds make it ambiguous. */
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation", meta = (WorldContext = "WorldContextObject"))
+	static int32 GetTestWorldId(UObject* WorldContextObject);
+
+	/** Every game world in the process as JSON (worldId, map, netMode, localPlayers). */
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation", meta = (WorldContext = "WorldContextObject"))
+	static FString GetTestWorldsAsString(UObject* WorldContextObject);
+
+	/** This instance's LyraTestInstanceConfig as JSON (instanceId -1 when it was started on its own). */
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation", meta = (WorldContext = "WorldContextObject"))
+	static FString GetTestInstanceConfig(UObject* WorldContextObject);
+
+	/**
+	 * ULyraTestSupportSubsystem::ResetWorld; BotTeamIds is a comma separated team id per bot (repeated), BotCount
+	 * and PlayerTeamId -1 keep the current ones. Returns the reset id, also the Value of its WorldReset event, or 0 for a
+	 * bad player index.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation", meta = (WorldContext = "WorldContextObject"))
+	static int64 ResetTestWorld(UObject* WorldContextObject, int32 PlayerIndex = 0, int32 PlayerStartIndex = -1, int32 BotCount = -1, const FString& BotTeamIds = TEXT(""), int32 PlayerTeamId = -1);
+
+	/** Turns ULyraTestBotLod on or off with the given tier distances (see FLyraTestBotLodSettings); false without the subsystem. */
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation", meta = (WorldContext = "WorldContextObject"))
+	static bool SetTestBotLodEnabled(UObject* WorldContextObject, bool bEnable, float FullDistance = 3000.f, float ReducedDistance = 6000.f, float FreezeDistance = 10000.f);
+
+	/** Alive bots per LOD tier as JSON (enabled, full, reduced, noPerception, frozen); empty without the subsystem. */
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation", meta = (WorldContext = "WorldContextObject"))
+	static FString GetTestBotLodCounts(UObject* WorldContextObject);
+
+	/** 0 unknown or superseded id, 1 running, 2 succeeded, 3 failed. */
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation", meta = (WorldContext = "WorldContextObject"))
+	static int32 GetTestWorldResetState(UObject* WorldContextObject, int64 ResetId);
+
+	/** Per entry point call counts, latency percentiles and allocations plus the harness share of the frame (see LyraTestStats). */
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation", meta = (WorldContext = "WorldContextObject"))
+	static FString GetTestStatsSummary(UObject* WorldContextObject, bool bReset = false);
+
+	/** ULyraTestSupportSubsystem::BeginPerfCapture; false without the subsystem. */
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation", meta = (WorldContext = "WorldContextObject"))
+	static bool BeginTestPerfCapture(UObject* WorldContextObject, const FString& Name, float HitchThresholdMs = 50.f);
+
+	/**
+	 * Ends the perf capture and gates it on its baseline with the default gate settings. Returns JSON
+	 * {"capture": {...}, "comparison": {...}}, empty when no capture was running. The capture becomes the
+	 * baseline when none exists yet or bUpdateBaseline is set.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation", meta = (WorldContext = "WorldContextObject"))
+	static FString EndTestPerfCapture(UObject* WorldContextObject, const FString& BaselineDirectory = TEXT(""), bool bUpdateBaseline = false);
+
+	/** Snapshot with the player record followed by one record per comma separated handle, in request order. */
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation", meta = (WorldContext = "WorldContextObject"))
+	static FString ResolveTestHandlesBase64(UObject* WorldContextObject, int32 PlayerIndex, const FString& Ids);
+
+	/** Object name for a handle, for exact By.NAME lookups from the driver; empty when stale or unknown. */
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation", meta = (WorldContext = "WorldContextObject"))
+	static FString GetTestObjectName(UObject* WorldContextObject, int64 Id);
+
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation", meta = (WorldContext = "WorldContextObject"))
+	static int64 GetLocalPlayerControllerId(UObject* WorldContextObject, int32 PlayerIndex = 0);
+
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation", meta = (WorldContext = "WorldContextObject"))
+	static bool IsTestHandleStale(UObject* WorldContextObject, int64 Id);
+
+	/** Handle reported for objects in snapshots and events (see FLyraTestHandleTable). */
+	static int64 GetTestObjectId(const UObject* Object);
+
+	/** Object for a handle from GetTestObjectId; null when stale. */
+	static UObject* ResolveTestObjectId(int64 Id);
+
+	/** Player record plus one record per handle; stale or unresolved handles get a dead record with bStale set when destroyed. */
+	static bool BuildHandleSnapshot(UWorld* World, int32 PlayerIndex, TConstArrayView<int64> Ids, FLyraTestSnapshot& OutSnapshot);
+
+	/** FLyraTestVisibility::Evaluate over alive enemies (empty Ids) or the given handles; false without a local player. */
+	static bool BuildTestVisibility(UWorld* World, int32 PlayerIndex, TConstArrayView<int64> Ids, FLyraTestVisibility& OutVisibility);
+
+	/** Native path for in-process callers; reuses OutSnapshot's record storage between calls. */
+	static bool BuildTestSnapshot(UWorld* World, int32 PlayerIndex, bool bEnemiesOnly, FLyraTestSnapshot& OutSnapshot);
+
+	/** BuildTestSnapshot restricted to the registry's spatial index; enemy records come nearest first. */
+	static bool BuildSpatialTestSnapshot(UWorld* World, int32 PlayerIndex, bool bEnemiesOnly, const FLyraTestSpatialQuery& Query, FLyraTestSnapshot& OutSnapshot);
 };
@@ -0,0 +1,270 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Testing/LyraTestEnemyRegistry.h"
+#include "Testing/LyraTestEventPublisher.h"
+#include "Testing/LyraTestSupportSubsystem.h"
+#include "Character/LyraHealthComponent.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/Controller.h"
+#include "Teams/LyraTeamAgentInterface.h"
+#include "Teams/LyraTeamSubsystem.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(LyraTestEnemyRegistry)
+
+bool ULyraTestEnemyRegistry::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void ULyraTestEnemyRegistry::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	if (UWorld* World = GetWorld())
+	{
+		ActorSpawnedHandle = World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &ThisClass::HandleActorSpawned));
+	}
+}
+
+void ULyraTestEnemyRegistry::Deinitialize()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+	}
+	ActorSpawnedHandle.Reset();
+	TrackedCharacters.Reset();
+	AliveCharacters.Reset();
+	AliveKeys.Reset();
+	AliveTeamIds.Reset();
+	AliveHealthComponents.Reset();
+	AliveIndexByCharacter.Reset();
+	AliveGrid.Reset();
+	Super::Deinitialize();
+}
+
+void ULyraTestEnemyRegistry::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+	for (TActorIterator<ACharacter> It(&InWorld); It; ++It)
+	{
+		TrackCharacter(*It);
+	}
+}
+
+void ULyraTestEnemyRegistry::HandleActorSpawned(AActor* Actor)
+{
+	if (ACharacter* Char = Cast<ACharacter>(Actor))
+	{
+		TrackCharacter(Char);
+	}
+}
+
+void ULyraTestEnemyRegistry::TrackCharacter(ACharacter* Char)
+{
+	if (!Char || TrackedCharacters.Contains(Char))
+	{
+		return;
+	}
+	TrackedCharacters.Add(Char);
+
+	Char->ReceiveControllerChangedDelegate.AddDynamic(this, &ThisClass::HandleControllerChanged);
+	Char->OnEndPlay.AddDynamic(this, &ThisClass::HandleCharacterEndPlay);
+	if (ULyraHealthComponent* Health = ULyraHealthComponent::FindHealthComponent(Char))
+	{
+		Health->OnDeathStarted.AddDynamic(this, &ThisClass::HandleDeathStarted);
+		Health->OnHealthChanged.AddDynamic(this, &ThisClass::HandleHealthChanged);
+	}
+	if (ILyraTeamAgentInterface* TeamAgent = Cast<ILyraTeamAgentInterface>(Char))
+	{
+		if (FOnLyraTeamIndexChangedDelegate* TeamDelegate = TeamAgent->GetOnTeamIndexChangedDelegate())
+		{
+			TeamDelegate->AddDynamic(this, &ThisClass::HandleTeamChanged);
+		}
+	}
+
+	if (UGameInstance* GI = GetWorld() ? GetWorld()->GetGameInstance() : nullptr)
+	{
+		if (ULyraTestSupportSubsystem* Sub = GI->GetSubsystem<ULyraTestSupportSubsystem>())
+		{
+			Sub->TrackCombatPawn(Char);
+		}
+	}
+
+	RefreshCharacter(Char);
+}
+
+void ULyraTestEnemyRegistry::RefreshCharacter(ACharacter* Char)
+{
+	bool bAlive = IsValid(Char) && Char->GetController() && !Char->GetController()->IsPlayerController();
+	if (bAlive)
+	{
+		if (ULyraHealthComponent* Health = ULyraHealthComponent::FindHealthComponent(Char))
+		{
+			bAlive = !Health->IsDeadOrDying();
+		}
+	}
+
+	if (bAlive)
+	{
+		AddAlive(Char);
+	}
+	else
+	{
+		RemoveAlive(Char);
+	}
+}
+
+void ULyraTestEnemyRegistry::AddAlive(ACharacter* Char)
+{
+	const ULyraTeamSubsystem* TeamSub = GetWorld() ? GetWorld()->GetSubsystem<ULyraTeamSubsystem>() : nullptr;
+	const int32 TeamId = TeamSub ? TeamSub->FindTeamFromObject(Char) : INDEX_NONE;
+
+	if (const int32* ExistingIndex = AliveIndexByCharacter.Find(Char))
+	{
+		AliveTeamIds[*ExistingIndex] = TeamId;
+		return;
+	}
+
+	AliveIndexByCharacter.Add(Char, AliveCharacters.Num());
+	AliveCharacters.Add(Char);
+	AliveKeys.Add(Char);
+	AliveTeamIds.Add(TeamId);
+	AliveHealthComponents.Add(ULyraHealthComponent::FindHealthComponent(Char));
+	AliveGrid.Add(Char->GetActorLocation());
+
+	if (ULyraTestEventPublisher* Publisher = ULyraTestEventPublisher::Get(this))
+	{
+		Publisher->Publish(ELyraTestEventType::EnemySpawned, Char, Char->GetController(), static_cast<float>(TeamId), Char->GetActorLocation());
+	}
+}
+
+void ULyraTestEnemyRegistry::RemoveAlive(const ACharacter* Char)
+{
+	int32 Index = INDEX_NONE;
+	if (!AliveIndexByCharacter.RemoveAndCopyValue(Char, Index))
+	{
+		return;
+	}
+
+	const int32 LastIndex = AliveCharacters.Num() - 1;
+	if (Index != LastIndex)
+	{
+		AliveIndexByCharacter.Add(AliveKeys[LastIndex], Index);
+	}
+	AliveCharacters.RemoveAtSwap(Index, 1, false);
+	AliveKeys.RemoveAtSwap(Index, 1, false);
+	AliveTeamIds.RemoveAtSwap(Index, 1, false);
+	AliveHealthComponents.RemoveAtSwap(Index, 1, false);
+	AliveGrid.RemoveAtSwap(Index);
+}
+
+void ULyraTestEnemyRegistry::UpdateSpatialIndex()
+{
+	if (SpatialIndexFrame == GFrameCounter)
+	{
+		return;
+	}
+	SpatialIndexFrame = GFrameCounter;
+	for (int32 Index = 0; Index < AliveCharacters.Num(); ++Index)
+	{
+		if (const ACharacter* Char = AliveCharacters[Index].Get())
+		{
+			AliveGrid.Move(Index, Char->GetActorLocation());
+		}
+	}
+}
+
+void ULyraTestEnemyRegistry::FindAlive(const FLyraTestSpatialQuery& Query, bool bEnemiesOnly, int32 LocalTeamId, const AActor* Ignore, TArray<int32>& OutIndices)
+{
+	UpdateSpatialIndex();
+
+	auto PassesFilter = [this, bEnemiesOnly, LocalTeamId, Ignore](int32 Index)
+	{
+		return (!bEnemiesOnly || AreDifferentTeams(LocalTeamId, AliveTeamIds[Index])) && AliveCharacters[Index].Get() != Ignore;
+	};
+
+	switch (Query.Shape)
+	{
+	case ELyraTestSpatialQueryShape::Nearest:
+		AliveGrid.FindNearest(Query.Origin, Query.Count, Query.Distance, PassesFilter, OutIndices);
+		break;
+	case ELyraTestSpatialQueryShape::Radius:
+		AliveGrid.FindInRadius(Query.Origin, Query.Distance, PassesFilter, OutIndices);
+		break;
+	case ELyraTestSpatialQueryShape::Cone:
+	{
+		const FVector Direction = Query.Direction.GetSafeNormal();
+		const double CosHalfAngle = FMath::Cos(FMath::DegreesToRadians(FMath::Clamp(Query.HalfAngleDegrees, 0.f, 180.f)));
+		auto InCone = [this, &Query, &Direction, CosHalfAngle, &PassesFilter](int32 Index)
+		{
+			const FVector ToTarget = AliveGrid.GetPosition(Index) - Query.Origin;
+			const double Distance = ToTarget.Size();
+			return (Distance <= UE_KINDA_SMALL_NUMBER || FVector::DotProduct(ToTarget / Distance, Direction) >= CosHalfAngle) && PassesFilter(Index);
+		};
+		if (Query.Distance > 0.f)
+		{
+			AliveGrid.FindInRadius(Query.Origin, Query.Distance, InCone, OutIndices);
+		}
+		else
+		{
+			AliveGrid.FindNearest(Query.Origin, AliveGrid.Num(), 0.f, InCone, OutIndices);
+		}
+		break;
+	}
+	}
+}
+
+void ULyraTestEnemyRegistry::HandleControllerChanged(APawn* Pawn, AController* OldController, AController* NewController)
+{
+	RefreshCharacter(Cast<ACharacter>(Pawn));
+}
+
+void ULyraTestEnemyRegistry::HandleDeathStarted(AActor* OwningActor)
+{
+	ACharacter* Char = Cast<ACharacter>(OwningActor);
+	const bool bWasAliveEnemy = Char && AliveIndexByCharacter.Contains(Char);
+	RemoveAlive(Char);
+
+	if (ULyraTestEventPublisher* Publisher = ULyraTestEventPublisher::Get(this))
+	{
+		if (bWasAliveEnemy)
+		{
+			Publisher->Publish(ELyraTestEventType::EnemyDied, Char, nullptr, 0.f, Char->GetActorLocation());
+		}
+		else if (Char && Char->IsPlayerControlled())
+		{
+			Publisher->Publish(ELyraTestEventType::PlayerDied, Char, Char->GetController(), 0.f, Char->GetActorLocation());
+		}
+	}
+}
+
+void ULyraTestEnemyRegistry::HandleHealthChanged(ULyraHealthComponent* HealthComponent, float OldValue, float NewValue, AActor* Instigator)
+{
+	if (NewValue >= OldValue || !HealthComponent)
+	{
+		return;
+	}
+	if (ULyraTestEventPublisher* Publisher = ULyraTestEventPublisher::Get(this))
+	{
+		const AActor* Victim = HealthComponent->GetOwner();
+		Publisher->Publish(ELyraTestEventType::DamageDealt, Victim, Instigator, OldValue - NewValue, Victim ? Victim->GetActorLocation() : FVector::ZeroVector);
+	}
+}
+
+void ULyraTestEnemyRegistry::HandleTeamChanged(UObject* ObjectChangingTeam, int32 OldTeamID, int32 NewTeamID)
+{
+	if (const int32* Index = AliveIndexByCharacter.Find(Cast<ACharacter>(ObjectChangingTeam)))
+	{
+		AliveTeamIds[*Index] = NewTeamID;
+	}
+}
+
+void ULyraTestEnemyRegistry::HandleCharacterEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason)
+{
+	ACharacter* Char = Cast<ACharacter>(Actor);
+	RemoveAlive(Char);
+	TrackedCharacters.Remove(Char);
+}
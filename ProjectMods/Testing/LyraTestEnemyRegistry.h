@@ -0,0 +1,145 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "Testing/LyraTestSpatialGrid.h"
+#include "UObject/ObjectKey.h"
+#include "LyraTestEnemyRegistry.generated.h"
+
+class ACharacter;
+class AController;
+class APawn;
+class ULyraHealthComponent;
+
+UENUM(BlueprintType)
+enum class ELyraTestSpatialQueryShape : uint8
+{
+	/** The Count closest within Distance (0 = any distance). */
+	Nearest,
+	/** Everything within Distance. */
+	Radius,
+	/** Everything within Distance (0 = any distance) and HalfAngleDegrees of Direction. */
+	Cone
+};
+
+USTRUCT(BlueprintType)
+struct LYRAGAME_API FLyraTestSpatialQuery
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	ELyraTestSpatialQueryShape Shape = ELyraTestSpatialQueryShape::Nearest;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	FVector Origin = FVector::ZeroVector;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	FVector Direction = FVector::ForwardVector;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	int32 Count = 1;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	float Distance = 0.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	float HalfAngleDegrees = 45.f;
+};
+
+/**
+ * Tracks AI-controlled characters through spawn, possession, team, death and end-play events so test
+ * queries iterate only the alive set instead of scanning every actor in the world. Alive characters are
+ * also kept in a spatial grid, refreshed at most once per frame when queried, for nearest / radius / cone queries.
+ */
+UCLASS(meta = (DisplayName = "Lyra Test Enemy Registry"))
+class LYRAGAME_API ULyraTestEnemyRegistry : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	int32 NumAlive() const { return AliveCharacters.Num(); }
+
+	/** Calls Func(ACharacter*, int32 TeamId, ULyraHealthComponent*) for each alive AI character; with bEnemiesOnly, skips characters not on a different team than LocalTeamId. */
+	template <typename FuncType>
+	void ForEachAlive(bool bEnemiesOnly, int32 LocalTeamId, FuncType&& Func) const
+	{
+		for (int32 Index = 0; Index < AliveCharacters.Num(); ++Index)
+		{
+			if (bEnemiesOnly && !AreDifferentTeams(LocalTeamId, AliveTeamIds[Index]))
+			{
+				continue;
+			}
+			if (ACharacter* Char = AliveCharacters[Index].Get())
+			{
+				Func(Char, AliveTeamIds[Index], AliveHealthComponents[Index].Get());
+			}
+		}
+	}
+
+	/** Alive indices matching Query, nearest to Query.Origin first, with the same team filter as ForEachAlive; Ignore is never returned. */
+	void FindAlive(const FLyraTestSpatialQuery& Query, bool bEnemiesOnly, int32 LocalTeamId, const AActor* Ignore, TArray<int32>& OutIndices);
+
+	/** ForEachAlive over the given alive indices (from FindAlive), in order. */
+	template <typename FuncType>
+	void ForEachAliveAt(TConstArrayView<int32> Indices, FuncType&& Func) const
+	{
+		for (int32 Index : Indices)
+		{
+			if (ACharacter* Char = AliveCharacters[Index].Get())
+			{
+				Func(Char, AliveTeamIds[Index], AliveHealthComponents[Index].Get());
+			}
+		}
+	}
+
+	static bool AreDifferentTeams(int32 TeamA, int32 TeamB)
+	{
+		return TeamA != INDEX_NONE && TeamB != INDEX_NONE && TeamA != TeamB;
+	}
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	void HandleActorSpawned(AActor* Actor);
+	void TrackCharacter(ACharacter* Char);
+	void RefreshCharacter(ACharacter* Char);
+	void AddAlive(ACharacter* Char);
+	void RemoveAlive(const ACharacter* Char);
+	void UpdateSpatialIndex();
+
+	UFUNCTION()
+	void HandleControllerChanged(APawn* Pawn, AController* OldController, AController* NewController);
+
+	UFUNCTION()
+	void HandleDeathStarted(AActor* OwningActor);
+
+	UFUNCTION()
+	void HandleHealthChanged(ULyraHealthComponent* HealthComponent, float OldValue, float NewValue, AActor* Instigator);
+
+	UFUNCTION()
+	void HandleTeamChanged(UObject* ObjectChangingTeam, int32 OldTeamID, int32 NewTeamID);
+
+	UFUNCTION()
+	void HandleCharacterEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason);
+
+	FDelegateHandle ActorSpawnedHandle;
+	TSet<TObjectKey<ACharacter>> TrackedCharacters;
+
+	// Dense, swap-removed arrays indexed in parallel.
+	TArray<TWeakObjectPtr<ACharacter>> AliveCharacters;
+	/** Map keys of AliveCharacters; unlike the weak pointers these still match after the character is destroyed. */
+	TArray<TObjectKey<ACharacter>> AliveKeys;
+	TArray<int32> AliveTeamIds;
+	TArray<TWeakObjectPtr<ULyraHealthComponent>> AliveHealthComponents;
+	TMap<TObjectKey<ACharacter>, int32> AliveIndexByCharacter;
+
+	// Same indices as the alive arrays; positions as of SpatialIndexFrame.
+	FLyraTestSpatialGrid AliveGrid;
+	uint64 SpatialIndexFrame = 0;
+};
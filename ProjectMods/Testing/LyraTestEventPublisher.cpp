@@ -0,0 +1,185 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Testing/LyraTestEventPublisher.h"
+#include "Testing/LyraTestEnemyQuery.h"
+#include "Testing/LyraTestStats.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/HUD.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "GameModes/LyraExperienceManagerComponent.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/Base64.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(LyraTestEventPublisher)
+
+ULyraTestEventPublisher* ULyraTestEventPublisher::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	const UGameInstance* GI = World ? World->GetGameInstance() : nullptr;
+	return GI ? GI->GetSubsystem<ULyraTestEventPublisher>() : nullptr;
+}
+
+void ULyraTestEventPublisher::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	EventPublishedSignal = FPlatformProcess::GetSynchEventFromPool(false);
+	WorldInitializedActorsHandle = FWorldDelegates::OnWorldInitializedActors.AddUObject(this, &ThisClass::HandleWorldInitializedActors);
+	if (UGameInstance* GI = GetGameInstance())
+	{
+		GI->OnPawnControllerChangedDelegates.AddDynamic(this, &ThisClass::HandlePawnControllerChanged);
+	}
+}
+
+void ULyraTestEventPublisher::Deinitialize()
+{
+	FWorldDelegates::OnWorldInitializedActors.Remove(WorldInitializedActorsHandle);
+	WorldInitializedActorsHandle.Reset();
+	if (UGameInstance* GI = GetGameInstance())
+	{
+		GI->OnPawnControllerChangedDelegates.RemoveDynamic(this, &ThisClass::HandlePawnControllerChanged);
+	}
+	if (EventPublishedSignal)
+	{
+		EventPublishedSignal->Trigger();
+		FPlatformProcess::ReturnSynchEventToPool(EventPublishedSignal);
+		EventPublishedSignal = nullptr;
+	}
+	Super::Deinitialize();
+}
+
+int64 ULyraTestEventPublisher::Publish(ELyraTestEventType Type, const UObject* Subject, const UObject* Other, float Value, const FVector& Location)
+{
+	const UGameInstance* GI = GetGameInstance();
+	const UWorld* World = GI ? GI->GetWorld() : nullptr;
+
+	FLyraTestEvent Event;
+	Event.FrameNumber = static_cast<int64>(GFrameCounter);
+	Event.WorldTimeSeconds = World ? World->GetTimeSeconds() : 0.0;
+	Event.Type = Type;
+	Event.SubjectId = ULyraTestEnemyQuery::GetTestObjectId(Subject);
+	Event.OtherId = ULyraTestEnemyQuery::GetTestObjectId(Other);
+	Event.Value = Value;
+	Event.Location = Location;
+
+	const int64 Sequence = Events.Push(Event);
+	if (EventPublishedSignal)
+	{
+		EventPublishedSignal->Trigger();
+	}
+	return Sequence;
+}
+
+int64 ULyraTestEventPublisher::GetLatestEventSequence() const
+{
+	return Events.GetLatestSequence();
+}
+
+TArray<FLyraTestEvent> ULyraTestEventPublisher::GetEventsSince(int64 SinceSequence, int32 MaxEvents) const
+{
+	LYRA_TEST_SCOPE(EventQuery);
+	TArray<FLyraTestEvent> Result;
+	Events.ReadSince(SinceSequence, MaxEvents, Result);
+	return Result;
+}
+
+FString ULyraTestEventPublisher::GetEventsSinceBase64(int64 SinceSequence, int32 MaxEvents) const
+{
+	LYRA_TEST_SCOPE(EventQuery);
+	TArray<FLyraTestEvent> Result;
+	int64 Lost = 0;
+	Events.ReadSince(SinceSequence, MaxEvents, Result, &Lost);
+	TArray<uint8> Bytes;
+	LyraTestEventStream::SerializeToBytes(Result, Bytes, Lost);
+	return FBase64::Encode(Bytes);
+}
+
+bool ULyraTestEventPublisher::WaitForEvent(int64 SinceSequence, TFunctionRef<bool(const FLyraTestEvent&)> Predicate, double TimeoutSeconds, FLyraTestEvent& OutEvent) const
+{
+	check(!IsInGameThread());
+
+	const double Deadline = FPlatformTime::Seconds() + TimeoutSeconds;
+	int64 Cursor = SinceSequence;
+	TArray<FLyraTestEvent> Batch;
+	for (;;)
+	{
+		Batch.Reset();
+		Events.ReadSince(Cursor, 0, Batch);
+		for (const FLyraTestEvent& Event : Batch)
+		{
+			Cursor = Event.Sequence;
+			if (Predicate(Event))
+			{
+				OutEvent = Event;
+				return true;
+			}
+		}
+
+		const double Remaining = Deadline - FPlatformTime::Seconds();
+		if (Remaining <= 0.0 || !EventPublishedSignal)
+		{
+			return false;
+		}
+		EventPublishedSignal->Wait(FTimespan::FromSeconds(FMath::Min(Remaining, 0.05)));
+	}
+}
+
+void ULyraTestEventPublisher::HandleWorldInitializedActors(const FActorsInitializedParams& Params)
+{
+	if (Params.World && Params.World->GetGameInstance() == GetGameInstance())
+	{
+		TryHookExperience(Params.World);
+	}
+}
+
+void ULyraTestEventPublisher::TryHookExperience(UWorld* World)
+{
+	if (!World || ExperienceHookedWorld.Get() == World)
+	{
+		return;
+	}
+	AGameStateBase* GameState = World->GetGameState();
+	ULyraExperienceManagerComponent* ExperienceComponent = GameState ? GameState->FindComponentByClass<ULyraExperienceManagerComponent>() : nullptr;
+	if (!ExperienceComponent)
+	{
+		return;
+	}
+	ExperienceHookedWorld = World;
+	ExperienceComponent->CallOrRegister_OnExperienceLoaded_LowPriority(FOnLyraExperienceLoaded::FDelegate::CreateUObject(this, &ThisClass::HandleExperienceLoaded));
+}
+
+void ULyraTestEventPublisher::HandleExperienceLoaded(const ULyraExperienceDefinition* Experience)
+{
+	Publish(ELyraTestEventType::ExperienceLoaded, Experience);
+
+	UWorld* World = ExperienceHookedWorld.Get();
+	if (!World)
+	{
+		return;
+	}
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+	{
+		APlayerController* PC = It->Get();
+		if (PC && PC->IsLocalController() && PC->GetHUD())
+		{
+			Publish(ELyraTestEventType::HudShown, PC->GetHUD(), PC);
+		}
+	}
+}
+
+void ULyraTestEventPublisher::HandlePawnControllerChanged(APawn* Pawn, AController* Controller)
+{
+	if (!Pawn)
+	{
+		return;
+	}
+	TryHookExperience(Pawn->GetWorld());
+
+	const APlayerController* PC = Cast<APlayerController>(Controller);
+	if (PC && PC->IsLocalController())
+	{
+		Publish(ELyraTestEventType::PawnPossessed, Pawn, Controller, 0.f, Pawn->GetActorLocation());
+	}
+}
@@ -0,0 +1,59 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Testing/LyraTestEventStream.h"
+#include "LyraTestEventPublisher.generated.h"
+
+class AController;
+class APawn;
+class ULyraExperienceDefinition;
+class UWorld;
+struct FActorsInitializedParams;
+
+/**
+ * Records world events the test suite would otherwise poll for (possession, experience load, HUD, enemy
+ * spawn/death, damage) into a lock-free ring that clients read by sequence number.
+ */
+UCLASS(meta = (DisplayName = "Lyra Test Event Publisher"))
+class LYRAGAME_API ULyraTestEventPublisher : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static ULyraTestEventPublisher* Get(const UObject* WorldContextObject);
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	int64 Publish(ELyraTestEventType Type, const UObject* Subject, const UObject* Other = nullptr, float Value = 0.f, const FVector& Location = FVector::ZeroVector);
+
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
+	int64 GetLatestEventSequence() const;
+
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
+	TArray<FLyraTestEvent> GetEventsSince(int64 SinceSequence, int32 MaxEvents = 0) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
+	FString GetEventsSinceBase64(int64 SinceSequence, int32 MaxEvents = 0) const;
+
+	/**
+	 * Blocks the calling thread until an event after SinceSequence satisfies Predicate or the timeout elapses.
+	 * Must not be called on the game thread, which is the only producer of most events.
+	 */
+	bool WaitForEvent(int64 SinceSequence, TFunctionRef<bool(const FLyraTestEvent&)> Predicate, double TimeoutSeconds, FLyraTestEvent& OutEvent) const;
+
+private:
+	void HandleWorldInitializedActors(const FActorsInitializedParams& Params);
+	void TryHookExperience(UWorld* World);
+	void HandleExperienceLoaded(const ULyraExperienceDefinition* Experience);
+
+	UFUNCTION()
+	void HandlePawnControllerChanged(APawn* Pawn, AController* Controller);
+
+	TLyraTestSequencedRing<FLyraTestEvent> Events{4096};
+	FEvent* EventPublishedSignal = nullptr;
+	FDelegateHandle WorldInitializedActorsHandle;
+	TWeakObjectPtr<UWorld> ExperienceHookedWorld;
+};
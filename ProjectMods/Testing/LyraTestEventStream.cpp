@@ -0,0 +1,73 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Testing/LyraTestEventStream.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(LyraTestEventStream)
+
+static_assert(PLATFORM_LITTLE_ENDIAN, "LyraTestEventStream wire format is written little endian.");
+
+template <typename T>
+static FORCEINLINE void WriteEventValue(uint8* Dest, int32 Offset, T Value)
+{
+	FMemory::Memcpy(Dest + Offset, &Value, sizeof(T));
+}
+
+void LyraTestEventStream::SerializeToBytes(const TArray<FLyraTestEvent>& Events, TArray<uint8>& OutBytes, int64 LostCount)
+{
+	OutBytes.Reset();
+	OutBytes.AddZeroed(HeaderSize + Events.Num() * RecordStride);
+	uint8* Data = OutBytes.GetData();
+
+	WriteEventValue<uint32>(Data, 0, Magic);
+	WriteEventValue<uint16>(Data, 4, Version);
+	WriteEventValue<uint16>(Data, 6, static_cast<uint16>(RecordStride));
+	WriteEventValue<uint32>(Data, 8, static_cast<uint32>(Events.Num()));
+	WriteEventValue<uint32>(Data, 12, static_cast<uint32>(FMath::Min<int64>(LostCount, MAX_uint32)));
+
+	uint8* RecordData = Data + HeaderSize;
+	for (const FLyraTestEvent& Event : Events)
+	{
+		WriteEventValue<int64>(RecordData, 0, Event.Sequence);
+		WriteEventValue<uint64>(RecordData, 8, static_cast<uint64>(Event.FrameNumber));
+		WriteEventValue<double>(RecordData, 16, Event.WorldTimeSeconds);
+		WriteEventValue<uint8>(RecordData, 24, static_cast<uint8>(Event.Type));
+		WriteEventValue<float>(RecordData, 28, Event.Value);
+		WriteEventValue<int64>(RecordData, 32, Event.SubjectId);
+		WriteEventValue<int64>(RecordData, 40, Event.OtherId);
+		WriteEventValue<float>(RecordData, 48, static_cast<float>(Event.Location.X));
+		WriteEventValue<float>(RecordData, 52, static_cast<float>(Event.Location.Y));
+		WriteEventValue<float>(RecordData, 56, static_cast<float>(Event.Location.Z));
+		RecordData += RecordStride;
+	}
+}
+
+void LyraTestCombatLog::SerializeToBytes(const TArray<FLyraTestCombatRecord>& Records, TArray<uint8>& OutBytes, int64 LostCount)
+{
+	OutBytes.Reset();
+	OutBytes.AddZeroed(HeaderSize + Records.Num() * RecordStride);
+	uint8* Data = OutBytes.GetData();
+
+	WriteEventValue<uint32>(Data, 0, Magic);
+	WriteEventValue<uint16>(Data, 4, Version);
+	WriteEventValue<uint16>(Data, 6, static_cast<uint16>(RecordStride));
+	WriteEventValue<uint32>(Data, 8, static_cast<uint32>(Records.Num()));
+	WriteEventValue<uint32>(Data, 12, static_cast<uint32>(FMath::Min<int64>(LostCount, MAX_uint32)));
+
+	uint8* RecordData = Data + HeaderSize;
+	for (const FLyraTestCombatRecord& Record : Records)
+	{
+		WriteEventValue<int64>(RecordData, 0, Record.Sequence);
+		WriteEventValue<uint64>(RecordData, 8, static_cast<uint64>(Record.FrameNumber));
+		WriteEventValue<double>(RecordData, 16, Record.WorldTimeSeconds);
+		WriteEventValue<uint8>(RecordData, 24, static_cast<uint8>(Record.Kind));
+		WriteEventValue<float>(RecordData, 28, Record.Damage);
+		WriteEventValue<int64>(RecordData, 32, Record.InstigatorId);
+		WriteEventValue<int64>(RecordData, 40, Record.VictimId);
+		WriteEventValue<int64>(RecordData, 48, Record.WeaponId);
+		WriteEventValue<float>(RecordData, 56, static_cast<float>(Record.HitLocation.X));
+		WriteEventValue<float>(RecordData, 60, static_cast<float>(Record.HitLocation.Y));
+		WriteEventValue<float>(RecordData, 64, static_cast<float>(Record.HitLocation.Z));
+		WriteEventValue<float>(RecordData, 68, Record.VictimHealth);
+		RecordData += RecordStride;
+	}
+}
@@ -0,0 +1,234 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/UniquePtr.h"
+#include <atomic>
+#include "LyraTestEventStream.generated.h"
+
+UENUM(BlueprintType)
+enum class ELyraTestEventType : uint8
+{
+	None,
+	PawnPossessed,
+	ExperienceLoaded,
+	HudShown,
+	EnemySpawned,
+	EnemyDied,
+	PlayerDied,
+	DamageDealt,
+	AimSettled,
+	SessionReady,
+	WorldReset
+};
+
+USTRUCT(BlueprintType)
+struct LYRAGAME_API FLyraTestEvent
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	int64 Sequence = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	int64 FrameNumber = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	double WorldTimeSeconds = 0.0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	ELyraTestEventType Type = ELyraTestEventType::None;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	int64 SubjectId = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	int64 OtherId = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	float Value = 0.f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	FVector Location = FVector::ZeroVector;
+};
+
+UENUM(BlueprintType)
+enum class ELyraTestCombatRecordKind : uint8
+{
+	Damage,
+	Kill
+};
+
+USTRUCT(BlueprintType)
+struct LYRAGAME_API FLyraTestCombatRecord
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	int64 Sequence = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	int64 FrameNumber = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	double WorldTimeSeconds = 0.0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	ELyraTestCombatRecordKind Kind = ELyraTestCombatRecordKind::Damage;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	int64 InstigatorId = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	int64 VictimId = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	int64 WeaponId = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	float Damage = 0.f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	float VictimHealth = 0.f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	FVector HitLocation = FVector::ZeroVector;
+};
+
+/**
+ * Fixed-capacity, overwrite-oldest ring of sequenced records. Any thread may push; readers never consume,
+ * they copy everything after a sequence number they remember, so several clients can follow one ring.
+ * T must be trivially copyable apart from the Sequence member the ring assigns.
+ */
+template <typename T>
+class TLyraTestSequencedRing
+{
+public:
+	explicit TLyraTestSequencedRing(int32 InCapacity = 1024)
+		: Capacity(FMath::RoundUpToPowerOfTwo(FMath::Max(InCapacity, 2)))
+		, Slots(MakeUnique<FSlot[]>(Capacity))
+	{
+	}
+
+	int64 Push(T Record)
+	{
+		const int64 Sequence = WriteCursor.fetch_add(1, std::memory_order_acq_rel) + 1;
+		FSlot& Slot = Slots[(Sequence - 1) & (Capacity - 1)];
+		Slot.Sequence.store(0, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		Record.Sequence = Sequence;
+		Slot.Record = Record;
+		Slot.Sequence.store(Sequence, std::memory_order_release);
+		return Sequence;
+	}
+
+	int64 GetLatestSequence() const
+	{
+		return WriteCursor.load(std::memory_order_acquire);
+	}
+
+	/** Hides every record pushed so far from readers. Sequence numbers keep counting, so reader cursors stay valid. */
+	void Clear()
+	{
+		ClearedThrough.store(GetLatestSequence(), std::memory_order_release);
+	}
+
+	/**
+	 * Appends records with Sequence > SinceSequence (oldest first, at most MaxRecords when > 0) and returns how many were appended.
+	 * Records overwritten before they could be read are skipped; OutLost receives how many were skipped before the last appended
+	 * record, so a caller that resumes from that record's sequence sees each gap exactly once.
+	 */
+	int32 ReadSince(int64 SinceSequence, int32 MaxRecords, TArray<T>& OutRecords, int64* OutLost = nullptr) const
+	{
+		const int64 Latest = GetLatestSequence();
+		int64 Sequence = FMath::Max3<int64>(SinceSequence + 1, ClearedThrough.load(std::memory_order_acquire) + 1, 1);
+		int64 Skipped = 0;
+		int64 Lost = 0;
+		int32 Count = 0;
+		while (Sequence <= Latest && (MaxRecords <= 0 || Count < MaxRecords))
+		{
+			// Re-read every step: writers may lap the reader while it copies.
+			const int64 Oldest = GetLatestSequence() - static_cast<int64>(Capacity) + 1;
+			if (Sequence < Oldest)
+			{
+				const int64 Resume = FMath::Min(Oldest, Latest + 1);
+				Skipped += Resume - Sequence;
+				Sequence = Resume;
+				continue;
+			}
+
+			const FSlot& Slot = Slots[(Sequence - 1) & (Capacity - 1)];
+			if (Slot.Sequence.load(std::memory_order_acquire) == Sequence)
+			{
+				T Copy = Slot.Record;
+				std::atomic_thread_fence(std::memory_order_acquire);
+				if (Slot.Sequence.load(std::memory_order_relaxed) == Sequence)
+				{
+					OutRecords.Add(Copy);
+					++Count;
+					++Sequence;
+					Lost += Skipped;
+					Skipped = 0;
+					continue;
+				}
+			}
+
+			// The slot holds something else. If a writer has lapped it the next pass skips ahead; otherwise it is
+			// reserved but not published yet and later records cannot be returned in order.
+			if (GetLatestSequence() - static_cast<int64>(Capacity) + 1 <= Sequence)
+			{
+				break;
+			}
+		}
+		if (OutLost)
+		{
+			*OutLost = Lost;
+		}
+		return Count;
+	}
+
+	int32 GetCapacity() const { return static_cast<int32>(Capacity); }
+
+private:
+	struct FSlot
+	{
+		std::atomic<int64> Sequence{0};
+		T Record;
+	};
+
+	const uint32 Capacity;
+	TUniquePtr<FSlot[]> Slots;
+	std::atomic<int64> WriteCursor{0};
+	std::atomic<int64> ClearedThrough{0};
+};
+
+namespace LyraTestEventStream
+{
+	// Packed wire layout (little endian): 16-byte header then fixed-stride records.
+	//   Header  [0] uint32 Magic 'LTEV'  [4] uint16 Version  [6] uint16 RecordStride  [8] uint32 RecordCount  [12] uint32 LostCount
+	//   Record  [0] int64 Sequence  [8] uint64 FrameNumber  [16] double WorldTimeSeconds  [24] uint8 Type  [25..27] Reserved
+	//           [28] float Value  [32] int64 SubjectId  [40] int64 OtherId  [48] float Location[3]  [60] uint32 Reserved
+	static constexpr uint32 Magic = 0x5645544C; // "LTEV"
+	static constexpr uint16 Version = 1;
+	static constexpr int32 HeaderSize = 16;
+	static constexpr int32 RecordStride = 64;
+
+	/** LostCount is the ReadSince OutLost for these events, i.e. how many the reader missed to ring overwrites. */
+	LYRAGAME_API void SerializeToBytes(const TArray<FLyraTestEvent>& Events, TArray<uint8>& OutBytes, int64 LostCount = 0);
+}
+
+namespace LyraTestCombatLog
+{
+	// Packed wire layout (little endian): 16-byte header then fixed-stride records.
+	//   Header  [0] uint32 Magic 'LTCL'  [4] uint16 Version  [6] uint16 RecordStride  [8] uint32 RecordCount  [12] uint32 LostCount
+	//   Record  [0] int64 Sequence  [8] uint64 FrameNumber  [16] double WorldTimeSeconds  [24] uint8 Kind  [25..27] Reserved
+	//           [28] float Damage  [32] int64 InstigatorId  [40] int64 VictimId  [48] int64 WeaponId
+	//           [56] float HitLocation[3]  [68] float VictimHealth
+	static constexpr uint32 Magic = 0x4C43544C; // "LTCL"
+	static constexpr uint16 Version = 1;
+	static constexpr int32 HeaderSize = 16;
+	static constexpr int32 RecordStride = 72;
+
+	LYRAGAME_API void SerializeToBytes(const TArray<FLyraTestCombatRecord>& Records, TArray<uint8>& OutBytes, int64 LostCount = 0);
+}
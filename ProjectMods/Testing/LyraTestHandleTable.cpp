@@ -0,0 +1,87 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Testing/LyraTestHandleTable.h"
+
+// Generations stay below 2^31 so handles are positive.
+static constexpr uint32 MaxHandleGeneration = 0x7FFFFFFF;
+static constexpr int32 MinSweepSize = 256;
+
+FLyraTestHandleTable& FLyraTestHandleTable::Get()
+{
+	static FLyraTestHandleTable Table;
+	return Table;
+}
+
+int64 FLyraTestHandleTable::GetHandle(const UObject* Object)
+{
+	if (!Object)
+	{
+		return 0;
+	}
+	const TObjectKey<UObject> Key(Object);
+	if (const int32* Index = ObjectToSlot.Find(Key))
+	{
+		return MakeHandle(*Index, Slots[*Index].Generation);
+	}
+
+	if (FreeSlots.IsEmpty() && Slots.Num() >= NextSweepSize)
+	{
+		Sweep();
+	}
+	int32 Index;
+	if (!FreeSlots.IsEmpty())
+	{
+		Index = FreeSlots.Pop(false);
+	}
+	else
+	{
+		Index = Slots.AddDefaulted();
+	}
+	FSlot& Slot = Slots[Index];
+	Slot.Object = const_cast<UObject*>(Object);
+	Slot.Key = Key;
+	ObjectToSlot.Add(Key, Index);
+	return MakeHandle(Index, Slot.Generation);
+}
+
+const FLyraTestHandleTable::FSlot* FLyraTestHandleTable::FindSlot(int64 Handle) const
+{
+	const int32 Index = static_cast<int32>(Handle & 0xFFFFFFFF);
+	const uint32 Generation = static_cast<uint32>(Handle >> 32);
+	if (Handle <= 0 || !Slots.IsValidIndex(Index))
+	{
+		return nullptr;
+	}
+	const FSlot& Slot = Slots[Index];
+	// An older generation means the slot was freed after its object died.
+	return Generation <= Slot.Generation ? &Slot : nullptr;
+}
+
+UObject* FLyraTestHandleTable::Resolve(int64 Handle) const
+{
+	const FSlot* Slot = FindSlot(Handle);
+	return Slot && Slot->Generation == static_cast<uint32>(Handle >> 32) ? Slot->Object.Get() : nullptr;
+}
+
+bool FLyraTestHandleTable::IsStale(int64 Handle) const
+{
+	return FindSlot(Handle) && !Resolve(Handle);
+}
+
+void FLyraTestHandleTable::Sweep()
+{
+	for (int32 Index = 0; Index < Slots.Num(); ++Index)
+	{
+		FSlot& Slot = Slots[Index];
+		if (Slot.Object.IsValid() || Slot.Key == TObjectKey<UObject>())
+		{
+			continue;
+		}
+		ObjectToSlot.Remove(Slot.Key);
+		Slot.Object.Reset();
+		Slot.Key = TObjectKey<UObject>();
+		Slot.Generation = Slot.Generation < MaxHandleGeneration ? Slot.Generation + 1 : 1;
+		FreeSlots.Add(Index);
+	}
+	NextSweepSize = FMath::Max(MinSweepSize, NumLive() * 2);
+}
@@ -0,0 +1,60 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+/**
+ * Process-wide table of stable test handles for pawns, controllers, weapons or any other object the harness
+ * reports. A handle is (generation << 32 | slot index): resolving is an array lookup plus a generation check,
+ * and a handle whose object is gone stays stale even after its slot is reused. Handles are never 0 or negative.
+ * Game thread only.
+ */
+class LYRAGAME_API FLyraTestHandleTable
+{
+public:
+	static FLyraTestHandleTable& Get();
+
+	/** Handle for Object, assigning one on first use; 0 for null. */
+	int64 GetHandle(const UObject* Object);
+
+	/** Object for Handle, or null when the handle is 0, stale or was never issued. */
+	UObject* Resolve(int64 Handle) const;
+
+	template <typename T>
+	T* Resolve(int64 Handle) const
+	{
+		return Cast<T>(Resolve(Handle));
+	}
+
+	/** True for a handle that was issued but whose object has been destroyed. */
+	bool IsStale(int64 Handle) const;
+
+	int32 NumLive() const { return Slots.Num() - FreeSlots.Num(); }
+
+private:
+#if WITH_DEV_AUTOMATION_TESTS
+	friend class FLyraTestHandleTableStaleTest;
+	friend class FLyraTestHandleTableGenerationTest;
+#endif
+
+	struct FSlot
+	{
+		TWeakObjectPtr<UObject> Object;
+		TObjectKey<UObject> Key;
+		uint32 Generation = 1;
+	};
+
+	static int64 MakeHandle(int32 Index, uint32 Generation) { return (static_cast<int64>(Generation) << 32) | static_cast<uint32>(Index); }
+	const FSlot* FindSlot(int64 Handle) const;
+
+	/** Frees slots of destroyed objects; run when the table has doubled since the last sweep. */
+	void Sweep();
+
+	TArray<FSlot> Slots;
+	TArray<int32> FreeSlots;
+	TMap<TObjectKey<UObject>, int32> ObjectToSlot;
+	int32 NextSweepSize = 256;
+};
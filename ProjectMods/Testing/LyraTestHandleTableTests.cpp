@@ -0,0 +1,89 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Testing/LyraTestHandleTable.h"
+
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+static int32 GetHandleSlotIndex(int64 Handle)
+{
+	return static_cast<int32>(Handle & 0xFFFFFFFF);
+}
+
+static int64 GetHandleGeneration(int64 Handle)
+{
+	return Handle >> 32;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLyraTestHandleTableStaleTest, "LyraGame.Testing.HandleTable.StaleHandles",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FLyraTestHandleTableStaleTest::RunTest(const FString& Parameters)
+{
+	FLyraTestHandleTable Table;
+	UObject* First = NewObject<UObject>(GetTransientPackage());
+
+	TestEqual(TEXT("Null has handle 0"), Table.GetHandle(nullptr), int64(0));
+	const int64 FirstHandle = Table.GetHandle(First);
+	TestTrue(TEXT("Handles are positive"), FirstHandle > 0);
+	TestEqual(TEXT("Same object, same handle"), Table.GetHandle(First), FirstHandle);
+	TestTrue(TEXT("Handle resolves"), Table.Resolve(FirstHandle) == First);
+	TestFalse(TEXT("Live handle is not stale"), Table.IsStale(FirstHandle));
+
+	TestNull(TEXT("0 resolves to null"), Table.Resolve(0));
+	TestNull(TEXT("Negative handle resolves to null"), Table.Resolve(-FirstHandle));
+	TestNull(TEXT("Unissued slot resolves to null"), Table.Resolve(FirstHandle + 1));
+	TestNull(TEXT("Future generation resolves to null"), Table.Resolve(FirstHandle + (int64(1) << 32)));
+	TestFalse(TEXT("Unissued handle is not stale"), Table.IsStale(FirstHandle + 1));
+
+	First->MarkAsGarbage();
+	TestNull(TEXT("Dead object's handle resolves to null"), Table.Resolve(FirstHandle));
+	TestTrue(TEXT("Dead object's handle is stale"), Table.IsStale(FirstHandle));
+
+	// The sweep frees the slot; its next owner gets a new generation, so the old handle stays stale.
+	Table.Sweep();
+	TestEqual(TEXT("Sweep frees the dead slot"), Table.NumLive(), 0);
+	UObject* Second = NewObject<UObject>(GetTransientPackage());
+	const int64 SecondHandle = Table.GetHandle(Second);
+	TestEqual(TEXT("Freed slot is reused"), GetHandleSlotIndex(SecondHandle), GetHandleSlotIndex(FirstHandle));
+	TestEqual(TEXT("Reused slot has the next generation"), GetHandleGeneration(SecondHandle), GetHandleGeneration(FirstHandle) + 1);
+	TestTrue(TEXT("New handle resolves"), Table.Resolve(SecondHandle) == Second);
+	TestNull(TEXT("Old handle does not resolve to the new owner"), Table.Resolve(FirstHandle));
+	TestTrue(TEXT("Old handle is still stale"), Table.IsStale(FirstHandle));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLyraTestHandleTableGenerationTest, "LyraGame.Testing.HandleTable.GenerationWrap",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FLyraTestHandleTableGenerationTest::RunTest(const FString& Parameters)
+{
+	FLyraTestHandleTable Table;
+	UObject* First = NewObject<UObject>(GetTransientPackage());
+	Table.GetHandle(First);
+
+	// Skip to the last generation instead of sweeping the slot 2^31 times.
+	First->MarkAsGarbage();
+	Table.Slots[0].Generation = 0x7FFFFFFE;
+	Table.Sweep();
+
+	UObject* Last = NewObject<UObject>(GetTransientPackage());
+	const int64 LastHandle = Table.GetHandle(Last);
+	TestEqual(TEXT("Slot reaches the last generation"), GetHandleGeneration(LastHandle), int64(0x7FFFFFFF));
+	TestTrue(TEXT("Last generation handle is positive"), LastHandle > 0);
+	TestTrue(TEXT("Last generation handle resolves"), Table.Resolve(LastHandle) == Last);
+
+	Last->MarkAsGarbage();
+	Table.Sweep();
+	UObject* Wrapped = NewObject<UObject>(GetTransientPackage());
+	const int64 WrappedHandle = Table.GetHandle(Wrapped);
+	TestEqual(TEXT("Generation wraps to 1, never 0"), GetHandleGeneration(WrappedHandle), int64(1));
+	TestTrue(TEXT("Wrapped handle is positive"), WrappedHandle > 0);
+	TestTrue(TEXT("Wrapped handle resolves"), Table.Resolve(WrappedHandle) == Wrapped);
+	TestNull(TEXT("Pre-wrap handle is rejected"), Table.Resolve(LastHandle));
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,134 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Testing/LyraTestInputScheduler.h"
+
+FLyraTestInputScheduler::FChannel& FLyraTestInputScheduler::GetChannel(int32 PlayerIndex)
+{
+	check(PlayerIndex >= 0);
+	if (!Channels.IsValidIndex(PlayerIndex))
+	{
+		Channels.SetNum(PlayerIndex + 1);
+	}
+	return Channels[PlayerIndex];
+}
+
+void FLyraTestInputScheduler::UpdateActive(FChannel& Channel)
+{
+	const bool bActive = Channel.bHeld || Channel.bTapPending || Channel.bPattern;
+	if (bActive != Channel.bActive)
+	{
+		Channel.bActive = bActive;
+		NumActiveChannels += bActive ? 1 : -1;
+	}
+}
+
+void FLyraTestInputScheduler::Tap(int32 PlayerIndex, uint64 Frame, int32 HoldFrames)
+{
+	FChannel& Channel = GetChannel(PlayerIndex);
+	const int32 Hold = FMath::Max(HoldFrames, 1);
+	if (Channel.bHeld)
+	{
+		Channel.ReleaseFrame = FMath::Max(Channel.ReleaseFrame, Frame + Hold);
+	}
+	else
+	{
+		Channel.bTapPending = true;
+		Channel.TapHoldFrames = Hold;
+	}
+	UpdateActive(Channel);
+}
+
+void FLyraTestInputScheduler::StartPattern(int32 PlayerIndex, uint64 Frame, int32 ShotCount, int32 HoldFrames, int32 IntervalFrames)
+{
+	FChannel& Channel = GetChannel(PlayerIndex);
+	Channel.bPattern = true;
+	Channel.ShotsRemaining = ShotCount > 0 ? ShotCount : INDEX_NONE;
+	Channel.HoldFrames = FMath::Max(HoldFrames, 1);
+	// A new press needs at least one released frame in between or the game sees one long hold.
+	Channel.IntervalFrames = FMath::Max(IntervalFrames, Channel.HoldFrames + 1);
+	Channel.PressFrame = Frame;
+	UpdateActive(Channel);
+}
+
+void FLyraTestInputScheduler::Stop(int32 PlayerIndex, uint64 Frame)
+{
+	if (!Channels.IsValidIndex(PlayerIndex))
+	{
+		return;
+	}
+	FChannel& Channel = Channels[PlayerIndex];
+	Channel.bPattern = false;
+	Channel.bTapPending = false;
+	if (Channel.bHeld)
+	{
+		Channel.ReleaseFrame = Frame;
+	}
+	UpdateActive(Channel);
+}
+
+void FLyraTestInputScheduler::Press(int32 PlayerIndex, FChannel& Channel, uint64 Frame, int32 HoldFrames, TFunctionRef<void(int32, ELyraTestInputEdge)> Apply)
+{
+	Channel.bHeld = true;
+	Channel.ReleaseFrame = Frame + HoldFrames;
+	Channel.LastEdgeFrame = Frame;
+	Apply(PlayerIndex, ELyraTestInputEdge::Press);
+}
+
+void FLyraTestInputScheduler::Tick(uint64 Frame, TFunctionRef<void(int32 PlayerIndex, ELyraTestInputEdge Edge)> Apply)
+{
+	if (NumActiveChannels == 0)
+	{
+		return;
+	}
+	for (int32 PlayerIndex = 0; PlayerIndex < Channels.Num(); ++PlayerIndex)
+	{
+		FChannel& Channel = Channels[PlayerIndex];
+		if (!Channel.bActive)
+		{
+			continue;
+		}
+
+		if (Channel.bHeld)
+		{
+			if (Frame >= Channel.ReleaseFrame)
+			{
+				Channel.bHeld = false;
+				Channel.LastEdgeFrame = Frame;
+				Apply(PlayerIndex, ELyraTestInputEdge::Release);
+			}
+			else if (Frame != Channel.LastEdgeFrame)
+			{
+				Channel.LastEdgeFrame = Frame;
+				Apply(PlayerIndex, ELyraTestInputEdge::Hold);
+			}
+		}
+		else if (Frame != Channel.LastEdgeFrame)
+		{
+			if (Channel.bPattern && Frame >= Channel.PressFrame)
+			{
+				Channel.PressFrame = Frame + Channel.IntervalFrames;
+				if (Channel.ShotsRemaining > 0 && --Channel.ShotsRemaining == 0)
+				{
+					Channel.bPattern = false;
+				}
+				Channel.bTapPending = false;
+				Press(PlayerIndex, Channel, Frame, Channel.HoldFrames, Apply);
+			}
+			else if (Channel.bTapPending)
+			{
+				Channel.bTapPending = false;
+				Press(PlayerIndex, Channel, Frame, Channel.TapHoldFrames, Apply);
+			}
+		}
+		UpdateActive(Channel);
+	}
+}
+
+void FLyraTestInputScheduler::Reset()
+{
+	for (FChannel& Channel : Channels)
+	{
+		Channel = FChannel();
+	}
+	NumActiveChannels = 0;
+}
@@ -0,0 +1,61 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum class ELyraTestInputEdge : uint8
+{
+	Press,
+	Hold,
+	Release
+};
+
+/**
+ * Frame-indexed press/hold/release timeline for one input per local player. Taps and fire patterns are
+ * stored as per-player channel state that is reused for the whole session, so steady auto-fire costs no
+ * allocations, and a press that arrives while the input is held extends the hold instead of stacking.
+ */
+class LYRAGAME_API FLyraTestInputScheduler
+{
+public:
+	/** Presses on the next Tick at or after Frame and releases HoldFrames later. */
+	void Tap(int32 PlayerIndex, uint64 Frame, int32 HoldFrames);
+
+	/** ShotCount presses (0 = until stopped), each held HoldFrames, starting one every IntervalFrames. */
+	void StartPattern(int32 PlayerIndex, uint64 Frame, int32 ShotCount, int32 HoldFrames, int32 IntervalFrames);
+
+	/** Ends a pattern; an input that is currently held is released on the next Tick. */
+	void Stop(int32 PlayerIndex, uint64 Frame);
+
+	/** Emits every edge due at Frame. Hold is emitted once per frame for held inputs that need re-injection. */
+	void Tick(uint64 Frame, TFunctionRef<void(int32 PlayerIndex, ELyraTestInputEdge Edge)> Apply);
+
+	bool HasWork() const { return NumActiveChannels > 0; }
+	bool IsHeld(int32 PlayerIndex) const { return Channels.IsValidIndex(PlayerIndex) && Channels[PlayerIndex].bHeld; }
+
+	void Reset();
+
+private:
+	struct FChannel
+	{
+		bool bHeld = false;
+		bool bTapPending = false;
+		bool bPattern = false;
+		bool bActive = false;
+		int32 ShotsRemaining = 0;
+		int32 HoldFrames = 1;
+		int32 IntervalFrames = 1;
+		uint64 PressFrame = 0;
+		uint64 ReleaseFrame = 0;
+		uint64 LastEdgeFrame = 0;
+		int32 TapHoldFrames = 1;
+	};
+
+	FChannel& GetChannel(int32 PlayerIndex);
+	void Press(int32 PlayerIndex, FChannel& Channel, uint64 Frame, int32 HoldFrames, TFunctionRef<void(int32, ELyraTestInputEdge)> Apply);
+	void UpdateActive(FChannel& Channel);
+
+	TArray<FChannel> Channels;
+	int32 NumActiveChannels = 0;
+};
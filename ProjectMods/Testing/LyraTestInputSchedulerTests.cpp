@@ -0,0 +1,92 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Testing/LyraTestInputScheduler.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Ticks frames First..Last inclusive and appends each edge as "Player:FrameEdge", e.g. "0:10P 0:11H 0:12R". */
+static void TickInputFrames(FLyraTestInputScheduler& Scheduler, uint64 First, uint64 Last, FString& InOutEdges)
+{
+	for (uint64 Frame = First; Frame <= Last; ++Frame)
+	{
+		Scheduler.Tick(Frame, [&InOutEdges, Frame](int32 PlayerIndex, ELyraTestInputEdge Edge)
+		{
+			const TCHAR EdgeChar = Edge == ELyraTestInputEdge::Press ? TEXT('P') : Edge == ELyraTestInputEdge::Hold ? TEXT('H') : TEXT('R');
+			InOutEdges += FString::Printf(TEXT("%s%d:%llu%c"), InOutEdges.IsEmpty() ? TEXT("") : TEXT(" "), PlayerIndex, Frame, EdgeChar);
+		});
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLyraTestInputSchedulerTapTest, "LyraGame.Testing.InputScheduler.Tap",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FLyraTestInputSchedulerTapTest::RunTest(const FString& Parameters)
+{
+	FLyraTestInputScheduler Scheduler;
+	FString Edges;
+
+	Scheduler.Tap(0, 10, 3);
+	TestTrue(TEXT("Pending tap is work"), Scheduler.HasWork());
+	TickInputFrames(Scheduler, 10, 20, Edges);
+	TestEqual(TEXT("Tap presses, holds HoldFrames - 1 frames and releases"), Edges, FString(TEXT("0:10P 0:11H 0:12H 0:13R")));
+	TestFalse(TEXT("Released tap leaves no work"), Scheduler.HasWork());
+
+	// A second tap while held extends the hold instead of pressing again.
+	Edges.Reset();
+	Scheduler.Tap(0, 30, 3);
+	TickInputFrames(Scheduler, 30, 31, Edges);
+	Scheduler.Tap(0, 31, 5);
+	TickInputFrames(Scheduler, 32, 40, Edges);
+	TestEqual(TEXT("Tap while held extends the hold"), Edges, FString(TEXT("0:30P 0:31H 0:32H 0:33H 0:34H 0:35H 0:36R")));
+
+	// Zero hold still holds for one frame; other players' channels are independent.
+	Edges.Reset();
+	Scheduler.Tap(1, 50, 0);
+	TickInputFrames(Scheduler, 50, 55, Edges);
+	TestEqual(TEXT("Zero hold on player 1"), Edges, FString(TEXT("1:50P 1:51R")));
+	TestFalse(TEXT("Player 0 is not held"), Scheduler.IsHeld(0));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLyraTestInputSchedulerPatternTest, "LyraGame.Testing.InputScheduler.Pattern",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FLyraTestInputSchedulerPatternTest::RunTest(const FString& Parameters)
+{
+	FLyraTestInputScheduler Scheduler;
+	FString Edges;
+
+	Scheduler.StartPattern(0, 10, 2, 2, 5);
+	TickInputFrames(Scheduler, 10, 30, Edges);
+	TestEqual(TEXT("Two shots, one every IntervalFrames"), Edges, FString(TEXT("0:10P 0:11H 0:12R 0:15P 0:16H 0:17R")));
+	TestFalse(TEXT("Finished pattern leaves no work"), Scheduler.HasWork());
+
+	// IntervalFrames is raised to HoldFrames + 1 so the game sees separate presses.
+	Edges.Reset();
+	Scheduler.StartPattern(0, 40, 2, 3, 1);
+	TickInputFrames(Scheduler, 40, 60, Edges);
+	TestEqual(TEXT("Interval clamped to leave a released frame"), Edges, FString(TEXT("0:40P 0:41H 0:42H 0:43R 0:44P 0:45H 0:46H 0:47R")));
+
+	// Auto-fire runs until stopped; stopping mid-hold releases on the next tick.
+	Edges.Reset();
+	Scheduler.StartPattern(0, 70, 0, 2, 4);
+	TickInputFrames(Scheduler, 70, 74, Edges);
+	Scheduler.Stop(0, 75);
+	TickInputFrames(Scheduler, 75, 90, Edges);
+	TestEqual(TEXT("Auto-fire stops on Stop"), Edges, FString(TEXT("0:70P 0:71H 0:72R 0:74P 0:75R")));
+	TestFalse(TEXT("Stopped pattern leaves no work"), Scheduler.HasWork());
+
+	// Reset drops held inputs without emitting a release.
+	Edges.Reset();
+	Scheduler.StartPattern(0, 100, 0, 2, 4);
+	TickInputFrames(Scheduler, 100, 100, Edges);
+	Scheduler.Reset();
+	TickInputFrames(Scheduler, 101, 110, Edges);
+	TestEqual(TEXT("Reset emits nothing further"), Edges, FString(TEXT("0:100P")));
+	TestFalse(TEXT("Reset leaves no work"), Scheduler.HasWork());
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,45 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Testing/LyraTestInstanceConfig.h"
+#include "Math/UnrealMathUtility.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(LyraTestInstanceConfig)
+
+static FLyraTestInstanceConfig ParseInstanceConfig(const TCHAR* CommandLine)
+{
+	FLyraTestInstanceConfig Config;
+	FParse::Value(CommandLine, TEXT("LyraTestInstance="), Config.InstanceId);
+	FParse::Value(CommandLine, TEXT("LyraTestAgentPort="), Config.AgentPort);
+	FParse::Value(CommandLine, TEXT("LyraTestAppName="), Config.AppName);
+	FParse::Value(CommandLine, TEXT("LyraTestInstanceMap="), Config.MapName);
+	FParse::Value(CommandLine, TEXT("LyraTestInstanceExperience="), Config.Experience);
+	Config.bHasSeed = FParse::Value(CommandLine, TEXT("LyraTestSeed="), Config.Seed);
+	FParse::Value(CommandLine, TEXT("LyraTestBots="), Config.BotCount);
+	Config.BotCount = FMath::Max(Config.BotCount, -1);
+	return Config;
+}
+
+const FLyraTestInstanceConfig& LyraTestInstanceConfig::Get()
+{
+	static const FLyraTestInstanceConfig Config = ParseInstanceConfig(FCommandLine::Get());
+	return Config;
+}
+
+void LyraTestInstanceConfig::ApplySeed()
+{
+	const FLyraTestInstanceConfig& Config = Get();
+	if (Config.bHasSeed)
+	{
+		FMath::RandInit(Config.Seed);
+		FMath::SRandInit(Config.Seed);
+	}
+}
+
+FString LyraTestInstanceConfig::ToJson(const FLyraTestInstanceConfig& Config)
+{
+	return FString::Printf(TEXT("{\"instanceId\":%d,\"agentPort\":%d,\"appName\":\"%s\",\"map\":\"%s\",\"experience\":\"%s\",\"seed\":%s,\"botCount\":%d}"),
+		Config.InstanceId, Config.AgentPort, *Config.AppName.ReplaceCharWithEscapedChar(), *Config.MapName.ReplaceCharWithEscapedChar(),
+		*Config.Experience.ReplaceCharWithEscapedChar(), Config.bHasSeed ? *LexToString(Config.Seed) : TEXT("null"), Config.BotCount);
+}
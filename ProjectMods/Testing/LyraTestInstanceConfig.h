@@ -0,0 +1,57 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LyraTestInstanceConfig.generated.h"
+
+/**
+ * Identity and defaults of one game instance when several run side by side on an agent, read once from the
+ * command line: -LyraTestInstance=, -LyraTestAgentPort=, -LyraTestAppName=, -LyraTestInstanceMap=,
+ * -LyraTestInstanceExperience=, -LyraTestSeed=, -LyraTestBots=. Unset values keep the single-instance behavior.
+ */
+USTRUCT(BlueprintType)
+struct LYRAGAME_API FLyraTestInstanceConfig
+{
+	GENERATED_BODY()
+
+	/** -1 when the process was not started as one of several instances. */
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	int32 InstanceId = -1;
+
+	/** AltTester port and app name the launcher gave this instance; reported so a driver can check it reached the right one. */
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	int32 AgentPort = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	FString AppName;
+
+	/** Default map and experience for test sessions and scenarios that do not name one. */
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	FString MapName;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	FString Experience;
+
+	/** Seeds FMath::Rand / FRand at startup and at every session start. */
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	bool bHasSeed = false;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	int32 Seed = 0;
+
+	/** Passed as the NumBots URL option of session travel; -1 keeps the experience's bot count. */
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	int32 BotCount = -1;
+};
+
+namespace LyraTestInstanceConfig
+{
+	/** The configuration of this process, parsed on first use. */
+	LYRAGAME_API const FLyraTestInstanceConfig& Get();
+
+	/** Reseeds the engine's global random streams when a seed was given. */
+	LYRAGAME_API void ApplySeed();
+
+	LYRAGAME_API FString ToJson(const FLyraTestInstanceConfig& Config);
+}
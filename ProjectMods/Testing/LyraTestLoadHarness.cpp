@@ -0,0 +1,235 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Testing/LyraTestLoadHarness.h"
+#include "Testing/LyraTestNetComponent.h"
+#include "Testing/LyraTestStats.h"
+#include "Testing/LyraTestSupportSubsystem.h"
+#include "Character/LyraPawnExtensionComponent.h"
+#include "Engine/GameInstance.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "GameFramework/GameModeBase.h"
+#include "GameFramework/PlayerController.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(LyraTestLoadHarness)
+
+static const TCHAR* LoadReportName = TEXT("LoadTest");
+
+void ULyraTestLoadHarness::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	Collection.InitializeDependency<ULyraTestSupportSubsystem>();
+
+#if !UE_BUILD_SHIPPING
+	const TCHAR* CommandLine = FCommandLine::Get();
+	bServer = FParse::Param(CommandLine, TEXT("LyraTestLoadServer"));
+	bClient = !bServer && FParse::Param(CommandLine, TEXT("LyraTestLoadClient"));
+	FParse::Value(CommandLine, TEXT("LyraTestLoadReport="), ReportDirectory);
+	FParse::Value(CommandLine, TEXT("LyraTestLoadWarmup="), WarmupSeconds);
+	WarmupSeconds = FMath::Max(WarmupSeconds, 0.f);
+#endif
+
+	if (bServer)
+	{
+		PostLoginHandle = FGameModeEvents::GameModePostLoginEvent.AddUObject(this, &ThisClass::HandlePostLogin);
+	}
+}
+
+void ULyraTestLoadHarness::Deinitialize()
+{
+	FGameModeEvents::GameModePostLoginEvent.Remove(PostLoginHandle);
+	PostLoginHandle.Reset();
+	if (bServer)
+	{
+		CloseWindow();
+	}
+	bServer = false;
+	bClient = false;
+	Super::Deinitialize();
+}
+
+bool ULyraTestLoadHarness::IsTickable() const
+{
+	return !HasAnyFlags(RF_ClassDefaultObject) && (bServer || (bClient && !bClientStarted));
+}
+
+TStatId ULyraTestLoadHarness::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(ULyraTestLoadHarness, STATGROUP_Tickables);
+}
+
+void ULyraTestLoadHarness::HandlePostLogin(AGameModeBase* GameMode, APlayerController* NewPlayer)
+{
+	// A listen server's own players already run their cheats through the local slots.
+	if (NewPlayer && !NewPlayer->IsLocalController() && GameMode && GameMode->GetGameInstance() == GetGameInstance())
+	{
+		ULyraTestNetComponent::AddTo(NewPlayer);
+	}
+}
+
+void ULyraTestLoadHarness::Tick(float DeltaTime)
+{
+	LYRA_TEST_SCOPE(LoadHarness);
+	if (bClient)
+	{
+		TickClient();
+		return;
+	}
+
+	const UWorld* World = GetGameInstance()->GetWorld();
+	if (UNetDriver* NetDriver = World ? World->GetNetDriver() : nullptr)
+	{
+		TickServer(NetDriver);
+	}
+}
+
+void ULyraTestLoadHarness::TickClient()
+{
+	ULyraTestSupportSubsystem* Support = GetGameInstance()->GetSubsystem<ULyraTestSupportSubsystem>();
+	const APlayerController* PC = Support ? Support->GetLocalPlayerController(0) : nullptr;
+	// Cheats and fire input go through the ability system, so wait for it rather than just possession.
+	const ULyraPawnExtensionComponent* PawnExt = PC ? ULyraPawnExtensionComponent::FindPawnExtensionComponent(PC->GetPawn()) : nullptr;
+	if (!PawnExt || !PawnExt->GetLyraAbilitySystemComponent())
+	{
+		return;
+	}
+	// Both cheats are desired state, so they follow later pawns and reach the server once its net component replicates.
+	Support->SetPlayerInvincible(0, true);
+	Support->SetPlayerInfiniteAmmo(0, true);
+	Support->SetContinuousAimFireEnabledForPlayer(0, true);
+	bClientStarted = true;
+}
+
+void ULyraTestLoadHarness::TickServer(UNetDriver* NetDriver)
+{
+	const double Now = FPlatformTime::Seconds();
+	const double FrameSeconds = LastFrameSeconds > 0.0 ? Now - LastFrameSeconds : 0.0;
+	LastFrameSeconds = Now;
+
+	int32 Clients = 0;
+	for (const UNetConnection* Connection : NetDriver->ClientConnections)
+	{
+		Clients += Connection && Connection->PlayerController ? 1 : 0;
+	}
+	if (Clients != WindowClients)
+	{
+		CloseWindow();
+		BeginWindow(Clients);
+		return;
+	}
+	if (FrameSeconds <= 0.0 || Now - WindowStartSeconds < WarmupSeconds)
+	{
+		return;
+	}
+
+	const float FrameMsValue = static_cast<float>(FrameSeconds * 1000.0);
+	const float TickMsValue = FMath::Max(0.f, static_cast<float>((FrameSeconds - FApp::GetIdleTime()) * 1000.0));
+	FrameMs.Add(FrameMsValue);
+	TickMs.Add(TickMsValue);
+	const float MaxTickRate = NetDriver->GetNetServerMaxTickRate();
+	if (MaxTickRate > 0.f && TickMsValue > 1000.f / MaxTickRate)
+	{
+		++OverBudgetFrames;
+	}
+	InBytesPerSecondSum += NetDriver->InBytesPerSecond;
+	OutBytesPerSecondSum += NetDriver->OutBytesPerSecond;
+
+	for (UNetConnection* Connection : NetDriver->ClientConnections)
+	{
+		if (!Connection || !Connection->PlayerController)
+		{
+			continue;
+		}
+		// Data still queued at the end of the frame did not fit the connection's net speed.
+		const bool bSaturated = !Connection->IsNetReady(false);
+		FIntPoint& Saturation = ConnectionSaturation.FindOrAdd(Connection);
+		++Saturation.X;
+		Saturation.Y += bSaturated ? 1 : 0;
+		++ConnectionFrames;
+		SaturatedConnectionFrames += bSaturated ? 1 : 0;
+		MaxConnectionOutBytesPerSecond = FMath::Max(MaxConnectionOutBytesPerSecond, static_cast<double>(Connection->OutBytesPerSecond));
+		MaxAvgLagMs = FMath::Max(MaxAvgLagMs, static_cast<float>(Connection->AvgLag * 1000.0));
+	}
+}
+
+void ULyraTestLoadHarness::BeginWindow(int32 Clients)
+{
+	WindowClients = Clients;
+	WindowStartSeconds = FPlatformTime::Seconds();
+	FrameMs.Reset();
+	TickMs.Reset();
+	OverBudgetFrames = 0;
+	InBytesPerSecondSum = 0.0;
+	OutBytesPerSecondSum = 0.0;
+	MaxConnectionOutBytesPerSecond = 0.0;
+	ConnectionFrames = 0;
+	SaturatedConnectionFrames = 0;
+	ConnectionSaturation.Reset();
+	MaxAvgLagMs = 0.f;
+}
+
+void ULyraTestLoadHarness::CloseWindow()
+{
+	// A count that changed again during warmup has nothing worth reporting.
+	if (WindowClients == INDEX_NONE || FrameMs.Num() == 0)
+	{
+		return;
+	}
+
+	FLyraTestLoadSample& Sample = Samples.AddDefaulted_GetRef();
+	Sample.Clients = WindowClients;
+	Sample.Frames = FrameMs.Num();
+	Sample.DurationSeconds = FPlatformTime::Seconds() - WindowStartSeconds - WarmupSeconds;
+	Sample.OverBudgetFraction = static_cast<float>(OverBudgetFrames) / Sample.Frames;
+	Sample.FrameMs = LyraTestPerfCapture::MakeStat(FrameMs);
+	Sample.TickMs = LyraTestPerfCapture::MakeStat(TickMs);
+	Sample.InKBytesPerSecond = InBytesPerSecondSum / Sample.Frames / 1024.0;
+	Sample.OutKBytesPerSecond = OutBytesPerSecondSum / Sample.Frames / 1024.0;
+	Sample.MaxConnectionOutKBytesPerSecond = MaxConnectionOutBytesPerSecond / 1024.0;
+	Sample.SaturatedFraction = ConnectionFrames > 0 ? static_cast<float>(SaturatedConnectionFrames) / ConnectionFrames : 0.f;
+	for (const TPair<TObjectKey<UNetConnection>, FIntPoint>& Pair : ConnectionSaturation)
+	{
+		if (Pair.Value.X > 0)
+		{
+			Sample.MaxConnectionSaturatedFraction = FMath::Max(Sample.MaxConnectionSaturatedFraction, static_cast<float>(Pair.Value.Y) / Pair.Value.X);
+		}
+	}
+	Sample.MaxAvgLagMs = MaxAvgLagMs;
+
+	WindowClients = INDEX_NONE;
+	FrameMs.Reset();
+	TickMs.Reset();
+	WriteReports();
+}
+
+void ULyraTestLoadHarness::WriteReports() const
+{
+	FString Csv = TEXT("clients,frames,seconds,frame_mean_ms,frame_p95_ms,frame_p99_ms,tick_mean_ms,tick_p50_ms,tick_p95_ms,tick_p99_ms,tick_max_ms,over_budget,in_kbps,out_kbps,max_conn_out_kbps,saturated,max_conn_saturated,max_lag_ms\n");
+	TArray<FString> Rows;
+	for (const FLyraTestLoadSample& Sample : Samples)
+	{
+		Csv += FString::Printf(TEXT("%d,%d,%.2f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.4f,%.2f,%.2f,%.2f,%.4f,%.4f,%.1f\n"),
+			Sample.Clients, Sample.Frames, Sample.DurationSeconds,
+			Sample.FrameMs.Mean, Sample.FrameMs.P95, Sample.FrameMs.P99,
+			Sample.TickMs.Mean, Sample.TickMs.P50, Sample.TickMs.P95, Sample.TickMs.P99, Sample.TickMs.Max,
+			Sample.OverBudgetFraction, Sample.InKBytesPerSecond, Sample.OutKBytesPerSecond, Sample.MaxConnectionOutKBytesPerSecond,
+			Sample.SaturatedFraction, Sample.MaxConnectionSaturatedFraction, Sample.MaxAvgLagMs);
+		Rows.Add(FString::Printf(TEXT("{\"clients\":%d,\"frames\":%d,\"durationSeconds\":%.2f,\"frameMs\":%s,\"tickMs\":%s,\"overBudgetFraction\":%.4f,")
+			TEXT("\"inKBytesPerSecond\":%.2f,\"outKBytesPerSecond\":%.2f,\"maxConnectionOutKBytesPerSecond\":%.2f,")
+			TEXT("\"saturatedFraction\":%.4f,\"maxConnectionSaturatedFraction\":%.4f,\"maxAvgLagMs\":%.1f}"),
+			Sample.Clients, Sample.Frames, Sample.DurationSeconds, *LyraTestPerfCapture::StatToJson(Sample.FrameMs), *LyraTestPerfCapture::StatToJson(Sample.TickMs), Sample.OverBudgetFraction,
+			Sample.InKBytesPerSecond, Sample.OutKBytesPerSecond, Sample.MaxConnectionOutKBytesPerSecond,
+			Sample.SaturatedFraction, Sample.MaxConnectionSaturatedFraction, Sample.MaxAvgLagMs));
+	}
+	const FString Json = FString::Printf(TEXT("{\"samples\":[%s]}"), *FString::Join(Rows, TEXT(",")));
+
+	const FString Directory = ReportDirectory.IsEmpty() ? FPaths::ProjectSavedDir() / TEXT("TestScenarios") : ReportDirectory;
+	FFileHelper::SaveStringToFile(Csv, *(Directory / LoadReportName + TEXT(".csv")), FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+	FFileHelper::SaveStringToFile(Json, *(Directory / LoadReportName + TEXT(".json")), FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+}
@@ -0,0 +1,131 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Testing/LyraTestPerfCapture.h"
+#include "Tickable.h"
+#include "UObject/ObjectKey.h"
+#include "LyraTestLoadHarness.generated.h"
+
+class AGameModeBase;
+class APlayerController;
+class UNetConnection;
+class UNetDriver;
+
+/** Server load over one stretch of frames with a constant number of connected clients. */
+USTRUCT(BlueprintType)
+struct LYRAGAME_API FLyraTestLoadSample
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	int32 Clients = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	int32 Frames = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	double DurationSeconds = 0.0;
+
+	/** Wall clock server frame, including the sleep that holds the server tick rate. */
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	FLyraTestPerfStat FrameMs;
+
+	/** Frame minus idle time: the part of the tick budget the server actually used. */
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	FLyraTestPerfStat TickMs;
+
+	/** Frames whose TickMs exceeded the budget of one tick at the net driver's max tick rate. */
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	float OverBudgetFraction = 0.f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	double InKBytesPerSecond = 0.0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	double OutKBytesPerSecond = 0.0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	double MaxConnectionOutKBytesPerSecond = 0.0;
+
+	/** Fraction of connection frames that ended with unsent data queued, i.e. over the connection's net speed. */
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	float SaturatedFraction = 0.f;
+
+	/** Worst single connection's saturated fraction. */
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	float MaxConnectionSaturatedFraction = 0.f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	float MaxAvgLagMs = 0.f;
+};
+
+/**
+ * Load test on one Linux box: a dedicated server started with -LyraTestLoadServer plus any number of
+ * -nullrhi clients started with -LyraTestLoadClient. Non-shipping builds only.
+ *
+ * Server: gives every joining player controller a ULyraTestNetComponent so its client's cheats reach the
+ * server, and samples frame / tick time, bandwidth and per-connection saturation every frame. A sample
+ * window closes whenever the client count changes, so ramping clients up yields one row per count in
+ * LoadTest.csv / .json (-LyraTestLoadReport=, default Saved/TestScenarios), rewritten as windows close.
+ *
+ * Client: once its pawn is possessed, requests invincibility and infinite ammo and runs the continuous
+ * aim-fire loop of the test support subsystem for local player 0.
+ */
+UCLASS(meta = (DisplayName = "Lyra Test Load Harness"))
+class LYRAGAME_API ULyraTestLoadHarness : public UGameInstanceSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual ETickableTickType GetTickableTickType() const override { return ETickableTickType::Conditional; }
+	virtual TStatId GetStatId() const override;
+
+	/** Closed windows so far, in order. */
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
+	TArray<FLyraTestLoadSample> GetLoadSamples() const { return Samples; }
+
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
+	bool IsLoadServer() const { return bServer; }
+
+private:
+	void HandlePostLogin(AGameModeBase* GameMode, APlayerController* NewPlayer);
+
+	void TickServer(UNetDriver* NetDriver);
+	void TickClient();
+	void BeginWindow(int32 Clients);
+	void CloseWindow();
+	void WriteReports() const;
+
+	UPROPERTY(Transient)
+	TArray<FLyraTestLoadSample> Samples;
+
+	bool bServer = false;
+	bool bClient = false;
+	FString ReportDirectory;
+	float WarmupSeconds = 2.f;
+	FDelegateHandle PostLoginHandle;
+
+	int32 WindowClients = INDEX_NONE;
+	double WindowStartSeconds = 0.0;
+	double LastFrameSeconds = 0.0;
+	TArray<float> FrameMs;
+	TArray<float> TickMs;
+	int32 OverBudgetFrames = 0;
+	double InBytesPerSecondSum = 0.0;
+	double OutBytesPerSecondSum = 0.0;
+	double MaxConnectionOutBytesPerSecond = 0.0;
+	int32 ConnectionFrames = 0;
+	int32 SaturatedConnectionFrames = 0;
+	// Per connection: X frames sampled, Y of them saturated.
+	TMap<TObjectKey<UNetConnection>, FIntPoint> ConnectionSaturation;
+	float MaxAvgLagMs = 0.f;
+
+	bool bClientStarted = false;
+};
@@ -0,0 +1,74 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Testing/LyraTestNetComponent.h"
+#include "Testing/LyraTestStats.h"
+#include "Testing/LyraTestSupportSubsystem.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(LyraTestNetComponent)
+
+ULyraTestNetComponent::ULyraTestNetComponent(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	SetIsReplicatedByDefault(true);
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+ULyraTestNetComponent* ULyraTestNetComponent::Find(const AController* Controller)
+{
+	return Controller ? Controller->FindComponentByClass<ULyraTestNetComponent>() : nullptr;
+}
+
+ULyraTestNetComponent* ULyraTestNetComponent::AddTo(APlayerController* PC)
+{
+	if (!PC || !PC->HasAuthority())
+	{
+		return nullptr;
+	}
+	if (ULyraTestNetComponent* Existing = Find(PC))
+	{
+		return Existing;
+	}
+	ULyraTestNetComponent* Component = NewObject<ULyraTestNetComponent>(PC, TEXT("LyraTestNet"));
+	Component->RegisterComponent();
+	return Component;
+}
+
+static ULyraTestSupportSubsystem* GetOwnerTestSupportSubsystem(const UActorComponent* Component)
+{
+	const UWorld* World = Component->GetWorld();
+	UGameInstance* GI = World ? World->GetGameInstance() : nullptr;
+	return GI ? GI->GetSubsystem<ULyraTestSupportSubsystem>() : nullptr;
+}
+
+void ULyraTestNetComponent::ServerSetCheats_Implementation(bool bInInvincible, bool bInInfiniteAmmo)
+{
+	LYRA_TEST_SCOPE(Cheats);
+	bInvincible = bInInvincible;
+	bInfiniteAmmo = bInInfiniteAmmo;
+	if (ULyraTestSupportSubsystem* Support = GetOwnerTestSupportSubsystem(this))
+	{
+		Support->ApplyControllerCheats(Cast<AController>(GetOwner()));
+	}
+}
+
+void ULyraTestNetComponent::ServerSetTarget_Implementation(AActor* InTarget)
+{
+	Target = InTarget;
+}
+
+void ULyraTestNetComponent::BeginPlay()
+{
+	Super::BeginPlay();
+	// The component replicates after the controller, so cheats requested before it arrived are sent now.
+	const APlayerController* PC = Cast<APlayerController>(GetOwner());
+	if (PC && PC->IsLocalController() && !PC->HasAuthority())
+	{
+		if (ULyraTestSupportSubsystem* Support = GetOwnerTestSupportSubsystem(this))
+		{
+			Support->ApplyControllerCheats(PC);
+		}
+	}
+}
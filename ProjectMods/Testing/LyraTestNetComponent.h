@@ -0,0 +1,54 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Components/ActorComponent.h"
+#include "LyraTestNetComponent.generated.h"
+
+class AActor;
+class AController;
+class APlayerController;
+
+/**
+ * Replicated player controller component that carries test commands from a remote client to the server.
+ * Only the server adds it, and only when it runs the load harness, so a build without it cannot be sent
+ * cheats. The server keeps the requested cheats here and the test support subsystem re-applies them to
+ * the controller's pawns just as it does for local players. Aim and fire need no routing: the client
+ * drives its own input, which already reaches the server through movement and ability activation RPCs.
+ * The client's current target is forwarded for the server's bot LOD.
+ */
+UCLASS(NotBlueprintable, Transient, meta = (DisplayName = "Lyra Test Net"))
+class LYRAGAME_API ULyraTestNetComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	ULyraTestNetComponent(const FObjectInitializer& ObjectInitializer);
+
+	static ULyraTestNetComponent* Find(const AController* Controller);
+
+	/** Server only; returns the existing component when there is one. */
+	static ULyraTestNetComponent* AddTo(APlayerController* PC);
+
+	UFUNCTION(Server, Reliable)
+	void ServerSetCheats(bool bInInvincible, bool bInInfiniteAmmo);
+
+	/** The enemy the client's harness is aiming at, so the server's bot LOD keeps it at full fidelity. */
+	UFUNCTION(Server, Unreliable)
+	void ServerSetTarget(AActor* InTarget);
+
+	/** Cheats the owning client requested; only meaningful on the server. */
+	bool IsInvincible() const { return bInvincible; }
+	bool IsInfiniteAmmo() const { return bInfiniteAmmo; }
+
+	/** Last target the owning client reported; server only. */
+	AActor* GetTarget() const { return Target.Get(); }
+
+protected:
+	virtual void BeginPlay() override;
+
+private:
+	bool bInvincible = false;
+	bool bInfiniteAmmo = false;
+	TWeakObjectPtr<AActor> Target;
+};
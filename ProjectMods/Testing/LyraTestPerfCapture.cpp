@@ -0,0 +1,299 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Testing/LyraTestPerfCapture.h"
+#include "Testing/LyraTestStats.h"
+#include "Dom/JsonObject.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "RenderCore.h"
+#include "RHI.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/UObjectGlobals.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(LyraTestPerfCapture)
+
+static constexpr double BytesPerMB = 1024.0 * 1024.0;
+
+// Samples keep a capture of a few minutes at 60 Hz allocation free after the first frame.
+static constexpr int32 ReservedFrameSamples = 8192;
+
+FLyraTestPerfStat LyraTestPerfCapture::MakeStat(TArray<float>& Samples)
+{
+	FLyraTestPerfStat Stat;
+	if (Samples.IsEmpty())
+	{
+		return Stat;
+	}
+	Samples.Sort();
+	double Total = 0.0;
+	for (float Sample : Samples)
+	{
+		Total += Sample;
+	}
+	const auto GetSortedPercentile = [&Samples](double Percentile)
+	{
+		const int32 Rank = FMath::Clamp(FMath::CeilToInt32(Samples.Num() * Percentile), 1, Samples.Num());
+		return static_cast<double>(Samples[Rank - 1]);
+	};
+	Stat.Mean = Total / Samples.Num();
+	Stat.P50 = GetSortedPercentile(0.5);
+	Stat.P95 = GetSortedPercentile(0.95);
+	Stat.P99 = GetSortedPercentile(0.99);
+	Stat.Max = Samples.Last();
+	return Stat;
+}
+
+FLyraTestPerfCapture::~FLyraTestPerfCapture()
+{
+	UnbindGarbageCollect();
+}
+
+void FLyraTestPerfCapture::Begin(const FString& InName, float InHitchThresholdMs)
+{
+	UnbindGarbageCollect();
+	Name = InName;
+	HitchThresholdMs = FMath::Max(InHitchThresholdMs, 1.f);
+	bRunning = true;
+	StartSeconds = FPlatformTime::Seconds();
+	LastFrameSeconds = 0.0;
+	GCStartSeconds = 0.0;
+	for (TArray<float>* Samples : { &FrameMs, &GameThreadMs, &RenderThreadMs, &GPUMs })
+	{
+		Samples->Reset(ReservedFrameSamples);
+	}
+	GCPauseMs.Reset();
+	Hitches = 0;
+	HitchTotalMs = 0.0;
+
+	const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+	StartUsedPhysical = MemoryStats.UsedPhysical;
+	PeakUsedPhysical = MemoryStats.UsedPhysical;
+	PeakUsedVirtual = MemoryStats.UsedVirtual;
+
+	PreGCHandle = FCoreUObjectDelegates::GetPreGarbageCollectDelegate().AddRaw(this, &FLyraTestPerfCapture::HandlePreGarbageCollect);
+	PostGCHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(this, &FLyraTestPerfCapture::HandlePostGarbageCollect);
+}
+
+void FLyraTestPerfCapture::Tick()
+{
+	LYRA_TEST_SCOPE(PerfCapture);
+	const double Now = FPlatformTime::Seconds();
+	if (LastFrameSeconds <= 0.0)
+	{
+		// Begin ran part way through a frame whose stat unit values predate the capture.
+		LastFrameSeconds = Now;
+		return;
+	}
+	const float DeltaMs = static_cast<float>((Now - LastFrameSeconds) * 1000.0);
+	LastFrameSeconds = Now;
+
+	FrameMs.Add(DeltaMs);
+	GameThreadMs.Add(static_cast<float>(FPlatformTime::ToMilliseconds(GGameThreadTime)));
+	RenderThreadMs.Add(static_cast<float>(FPlatformTime::ToMilliseconds(GRenderThreadTime)));
+	GPUMs.Add(static_cast<float>(FPlatformTime::ToMilliseconds(RHIGetGPUFrameCycles())));
+	if (DeltaMs > HitchThresholdMs)
+	{
+		++Hitches;
+		HitchTotalMs += DeltaMs;
+	}
+
+	const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+	PeakUsedPhysical = FMath::Max<uint64>(PeakUsedPhysical, MemoryStats.UsedPhysical);
+	PeakUsedVirtual = FMath::Max<uint64>(PeakUsedVirtual, MemoryStats.UsedVirtual);
+}
+
+FLyraTestPerfCaptureResult FLyraTestPerfCapture::End()
+{
+	FLyraTestPerfCaptureResult Result;
+	if (!bRunning)
+	{
+		return Result;
+	}
+	bRunning = false;
+	UnbindGarbageCollect();
+
+	Result.Name = Name;
+	Result.bValid = true;
+	Result.Frames = FrameMs.Num();
+	Result.DurationSeconds = FPlatformTime::Seconds() - StartSeconds;
+	Result.FrameMs = LyraTestPerfCapture::MakeStat(FrameMs);
+	Result.GameThreadMs = LyraTestPerfCapture::MakeStat(GameThreadMs);
+	Result.RenderThreadMs = LyraTestPerfCapture::MakeStat(RenderThreadMs);
+	Result.GPUMs = LyraTestPerfCapture::MakeStat(GPUMs);
+	Result.GCCount = GCPauseMs.Num();
+	for (float Pause : GCPauseMs)
+	{
+		Result.GCPauseTotalMs += Pause;
+		Result.GCPauseMaxMs = FMath::Max<double>(Result.GCPauseMaxMs, Pause);
+	}
+	Result.HitchThresholdMs = HitchThresholdMs;
+	Result.Hitches = Hitches;
+	Result.HitchTotalMs = HitchTotalMs;
+	Result.StartUsedPhysicalMB = StartUsedPhysical / BytesPerMB;
+	Result.PeakUsedPhysicalMB = PeakUsedPhysical / BytesPerMB;
+	Result.PeakUsedVirtualMB = PeakUsedVirtual / BytesPerMB;
+	return Result;
+}
+
+void FLyraTestPerfCapture::HandlePreGarbageCollect()
+{
+	GCStartSeconds = FPlatformTime::Seconds();
+}
+
+void FLyraTestPerfCapture::HandlePostGarbageCollect()
+{
+	if (GCStartSeconds > 0.0)
+	{
+		GCPauseMs.Add(static_cast<float>((FPlatformTime::Seconds() - GCStartSeconds) * 1000.0));
+		GCStartSeconds = 0.0;
+	}
+}
+
+void FLyraTestPerfCapture::UnbindGarbageCollect()
+{
+	FCoreUObjectDelegates::GetPreGarbageCollectDelegate().Remove(PreGCHandle);
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGCHandle);
+	PreGCHandle.Reset();
+	PostGCHandle.Reset();
+}
+
+FString LyraTestPerfCapture::GetDefaultBaselineDirectory()
+{
+	return FPaths::ProjectDir() / TEXT("Build/PerfBaselines");
+}
+
+FString LyraTestPerfCapture::GetBaselinePath(const FString& Directory, const FString& Name)
+{
+	return (Directory.IsEmpty() ? GetDefaultBaselineDirectory() : Directory) / Name + TEXT(".perfbaseline.json");
+}
+
+FString LyraTestPerfCapture::StatToJson(const FLyraTestPerfStat& Stat)
+{
+	return FString::Printf(TEXT("{\"mean\": %.3f, \"p50\": %.3f, \"p95\": %.3f, \"p99\": %.3f, \"max\": %.3f}"), Stat.Mean, Stat.P50, Stat.P95, Stat.P99, Stat.Max);
+}
+
+FString LyraTestPerfCapture::ToJson(const FLyraTestPerfCaptureResult& Result)
+{
+	FString Json = FString::Printf(TEXT("{\n  \"name\": \"%s\",\n  \"frames\": %d,\n  \"durationSeconds\": %.3f,\n"),
+		*Result.Name.ReplaceCharWithEscapedChar(), Result.Frames, Result.DurationSeconds);
+	Json += FString::Printf(TEXT("  \"frameMs\": %s,\n  \"gameThreadMs\": %s,\n  \"renderThreadMs\": %s,\n  \"gpuMs\": %s,\n"),
+		*StatToJson(Result.FrameMs), *StatToJson(Result.GameThreadMs), *StatToJson(Result.RenderThreadMs), *StatToJson(Result.GPUMs));
+	Json += FString::Printf(TEXT("  \"gcCount\": %d,\n  \"gcPauseTotalMs\": %.3f,\n  \"gcPauseMaxMs\": %.3f,\n"), Result.GCCount, Result.GCPauseTotalMs, Result.GCPauseMaxMs);
+	Json += FString::Printf(TEXT("  \"hitchThresholdMs\": %.1f,\n  \"hitches\": %d,\n  \"hitchTotalMs\": %.3f,\n"), Result.HitchThresholdMs, Result.Hitches, Result.HitchTotalMs);
+	Json += FString::Printf(TEXT("  \"startUsedPhysicalMB\": %.1f,\n  \"peakUsedPhysicalMB\": %.1f,\n  \"peakUsedVirtualMB\": %.1f\n}\n"),
+		Result.StartUsedPhysicalMB, Result.PeakUsedPhysicalMB, Result.PeakUsedVirtualMB);
+	return Json;
+}
+
+static void ReadGateOverrides(const FJsonObject& Baseline, FLyraTestPerfGateSettings& InOutGate)
+{
+	const TSharedPtr<FJsonObject>* Gate = nullptr;
+	if (!Baseline.TryGetObjectField(TEXT("gate"), Gate))
+	{
+		return;
+	}
+	double Value = 0.0;
+	if ((*Gate)->TryGetNumberField(TEXT("percentileTolerancePercent"), Value)) InOutGate.PercentileTolerancePercent = static_cast<float>(Value);
+	if ((*Gate)->TryGetNumberField(TEXT("minRegressionMs"), Value)) InOutGate.MinRegressionMs = static_cast<float>(Value);
+	if ((*Gate)->TryGetNumberField(TEXT("maxAdditionalHitches"), Value)) InOutGate.MaxAdditionalHitches = static_cast<int32>(Value);
+	if ((*Gate)->TryGetNumberField(TEXT("maxGCPauseIncreaseMs"), Value)) InOutGate.MaxGCPauseIncreaseMs = static_cast<float>(Value);
+	if ((*Gate)->TryGetNumberField(TEXT("maxPeakMemoryIncreaseMB"), Value)) InOutGate.MaxPeakMemoryIncreaseMB = static_cast<float>(Value);
+}
+
+static void CompareTimes(const FJsonObject& Baseline, const TCHAR* Field, const FLyraTestPerfStat& Current, const FLyraTestPerfGateSettings& Gate, TArray<FString>& OutRegressions)
+{
+	const TSharedPtr<FJsonObject>* BaselineStat = nullptr;
+	if (Gate.PercentileTolerancePercent < 0.f || !Baseline.TryGetObjectField(Field, BaselineStat))
+	{
+		return;
+	}
+	const TPair<const TCHAR*, double> Percentiles[] = { { TEXT("p50"), Current.P50 }, { TEXT("p95"), Current.P95 }, { TEXT("p99"), Current.P99 } };
+	for (const TPair<const TCHAR*, double>& Percentile : Percentiles)
+	{
+		double BaselineValue = 0.0;
+		// A zero baseline means the value was not reported when it was recorded (e.g. GPU time under -nullrhi).
+		if (!(*BaselineStat)->TryGetNumberField(Percentile.Key, BaselineValue) || BaselineValue <= 0.0)
+		{
+			continue;
+		}
+		const double Allowed = FMath::Max<double>(Gate.MinRegressionMs, BaselineValue * Gate.PercentileTolerancePercent / 100.0);
+		if (Percentile.Value - BaselineValue > Allowed)
+		{
+			OutRegressions.Add(FString::Printf(TEXT("%s.%s %.2f ms > baseline %.2f ms (+%.1f%%)"),
+				Field, Percentile.Key, Percentile.Value, BaselineValue, (Percentile.Value / BaselineValue - 1.0) * 100.0));
+		}
+	}
+}
+
+static void CompareValue(const FJsonObject& Baseline, const TCHAR* Field, double Current, double MaxIncrease, const TCHAR* Unit, TArray<FString>& OutRegressions)
+{
+	double BaselineValue = 0.0;
+	if (MaxIncrease < 0.0 || !Baseline.TryGetNumberField(Field, BaselineValue))
+	{
+		return;
+	}
+	if (Current - BaselineValue > MaxIncrease)
+	{
+		OutRegressions.Add(FString::Printf(TEXT("%s %.1f%s > baseline %.1f%s + %.1f"), Field, Current, Unit, BaselineValue, Unit, MaxIncrease));
+	}
+}
+
+FLyraTestPerfComparison LyraTestPerfCapture::CompareToBaseline(const FLyraTestPerfCaptureResult& Result, const FString& Directory, const FLyraTestPerfGateSettings& DefaultGate)
+{
+	FLyraTestPerfComparison Comparison;
+	Comparison.BaselinePath = GetBaselinePath(Directory, Result.Name);
+	FString Text;
+	if (!FFileHelper::LoadFileToString(Text, *Comparison.BaselinePath))
+	{
+		return Comparison;
+	}
+	TSharedPtr<FJsonObject> Baseline;
+	if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Text), Baseline) || !Baseline.IsValid())
+	{
+		Comparison.bPassed = false;
+		Comparison.Regressions.Add(FString::Printf(TEXT("Baseline %s is not valid JSON"), *Comparison.BaselinePath));
+		return Comparison;
+	}
+	Comparison.bBaselineFound = true;
+
+	FLyraTestPerfGateSettings Gate = DefaultGate;
+	ReadGateOverrides(*Baseline, Gate);
+	CompareTimes(*Baseline, TEXT("frameMs"), Result.FrameMs, Gate, Comparison.Regressions);
+	CompareTimes(*Baseline, TEXT("gameThreadMs"), Result.GameThreadMs, Gate, Comparison.Regressions);
+	CompareTimes(*Baseline, TEXT("renderThreadMs"), Result.RenderThreadMs, Gate, Comparison.Regressions);
+	CompareTimes(*Baseline, TEXT("gpuMs"), Result.GPUMs, Gate, Comparison.Regressions);
+	CompareValue(*Baseline, TEXT("hitches"), Result.Hitches, Gate.MaxAdditionalHitches, TEXT(""), Comparison.Regressions);
+	CompareValue(*Baseline, TEXT("gcPauseMaxMs"), Result.GCPauseMaxMs, Gate.MaxGCPauseIncreaseMs, TEXT(" ms"), Comparison.Regressions);
+	CompareValue(*Baseline, TEXT("peakUsedPhysicalMB"), Result.PeakUsedPhysicalMB, Gate.MaxPeakMemoryIncreaseMB, TEXT(" MB"), Comparison.Regressions);
+	Comparison.bPassed = Comparison.Regressions.IsEmpty();
+	return Comparison;
+}
+
+bool LyraTestPerfCapture::SaveBaseline(const FLyraTestPerfCaptureResult& Result, const FString& Directory)
+{
+	if (!Result.bValid)
+	{
+		return false;
+	}
+	const FString Path = GetBaselinePath(Directory, Result.Name);
+	FString Json = ToJson(Result);
+
+	// Gate overrides are hand-edited into the baseline, so they survive re-recording it.
+	FString Existing;
+	TSharedPtr<FJsonObject> Baseline;
+	const TSharedPtr<FJsonObject>* Gate = nullptr;
+	if (FFileHelper::LoadFileToString(Existing, *Path) && FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Existing), Baseline)
+		&& Baseline.IsValid() && Baseline->TryGetObjectField(TEXT("gate"), Gate))
+	{
+		FString GateJson;
+		FJsonSerializer::Serialize(Gate->ToSharedRef(), TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&GateJson));
+		Json.RemoveFromEnd(TEXT("\n}\n"));
+		Json += FString::Printf(TEXT(",\n  \"gate\": %s\n}\n"), *GateJson);
+	}
+	return FFileHelper::SaveStringToFile(Json, *Path, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+}
@@ -0,0 +1,203 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LyraTestPerfCapture.generated.h"
+
+/** Distribution of one per-frame value over a capture, in milliseconds. */
+USTRUCT(BlueprintType)
+struct LYRAGAME_API FLyraTestPerfStat
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	double Mean = 0.0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	double P50 = 0.0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	double P95 = 0.0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	double P99 = 0.0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	double Max = 0.0;
+};
+
+USTRUCT(BlueprintType)
+struct LYRAGAME_API FLyraTestPerfCaptureResult
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	FString Name;
+
+	/** False when no capture was running. */
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	bool bValid = false;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	int32 Frames = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	double DurationSeconds = 0.0;
+
+	/** Wall clock time between frames. */
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	FLyraTestPerfStat FrameMs;
+
+	/** Engine thread timings as shown by stat unit; 0 where the platform or RHI does not report them (GPU under -nullrhi). */
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	FLyraTestPerfStat GameThreadMs;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	FLyraTestPerfStat RenderThreadMs;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	FLyraTestPerfStat GPUMs;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	int32 GCCount = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	double GCPauseTotalMs = 0.0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	double GCPauseMaxMs = 0.0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	float HitchThresholdMs = 0.f;
+
+	/** Frames longer than HitchThresholdMs. */
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	int32 Hitches = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	double HitchTotalMs = 0.0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	double StartUsedPhysicalMB = 0.0;
+
+	/** Highest per-frame sample inside the capture, not the process lifetime peak. */
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	double PeakUsedPhysicalMB = 0.0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	double PeakUsedVirtualMB = 0.0;
+};
+
+/** Allowed deltas against a baseline; a negative value disables that check. A baseline file may override them with a "gate" object. */
+USTRUCT(BlueprintType)
+struct LYRAGAME_API FLyraTestPerfGateSettings
+{
+	GENERATED_BODY()
+
+	/** Applies to p50 / p95 / p99 of the frame, thread and GPU times. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	float PercentileTolerancePercent = 15.f;
+
+	/** Time increases below this are noise, whatever their percentage. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	float MinRegressionMs = 1.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	int32 MaxAdditionalHitches = 2;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	float MaxGCPauseIncreaseMs = 10.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	float MaxPeakMemoryIncreaseMB = 128.f;
+};
+
+USTRUCT(BlueprintType)
+struct LYRAGAME_API FLyraTestPerfComparison
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	FString BaselinePath;
+
+	/** A missing baseline passes, so a new scenario can seed one. */
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	bool bBaselineFound = false;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	bool bPassed = true;
+
+	/** One line per value over its allowed delta. */
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	TArray<FString> Regressions;
+};
+
+/**
+ * Frame time, GC and memory capture over a test region, owned and ticked once per frame by the test support
+ * subsystem. Engine thread times come from the previous frame's stat unit values, so the first frame of a
+ * capture only sets the clock. Game thread only.
+ */
+class LYRAGAME_API FLyraTestPerfCapture
+{
+public:
+	~FLyraTestPerfCapture();
+
+	/** Starts a new capture, discarding one in progress. */
+	void Begin(const FString& InName, float InHitchThresholdMs);
+
+	void Tick();
+
+	/** Stops the capture and returns its result; bValid is false when none was running. */
+	FLyraTestPerfCaptureResult End();
+
+	bool IsRunning() const { return bRunning; }
+
+private:
+	void HandlePreGarbageCollect();
+	void HandlePostGarbageCollect();
+	void UnbindGarbageCollect();
+
+	FString Name;
+	float HitchThresholdMs = 0.f;
+	bool bRunning = false;
+	double StartSeconds = 0.0;
+	double LastFrameSeconds = 0.0;
+	double GCStartSeconds = 0.0;
+	TArray<float> FrameMs;
+	TArray<float> GameThreadMs;
+	TArray<float> RenderThreadMs;
+	TArray<float> GPUMs;
+	TArray<float> GCPauseMs;
+	int32 Hitches = 0;
+	double HitchTotalMs = 0.0;
+	uint64 StartUsedPhysical = 0;
+	uint64 PeakUsedPhysical = 0;
+	uint64 PeakUsedVirtual = 0;
+	FDelegateHandle PreGCHandle;
+	FDelegateHandle PostGCHandle;
+};
+
+namespace LyraTestPerfCapture
+{
+	/** Mean and percentiles of Samples; sorts them in place. */
+	LYRAGAME_API FLyraTestPerfStat MakeStat(TArray<float>& Samples);
+
+	/** {"mean", "p50", "p95", "p99", "max"} object for one stat. */
+	LYRAGAME_API FString StatToJson(const FLyraTestPerfStat& Stat);
+
+	/** Project Build/PerfBaselines, meant to be checked in next to the scenarios. */
+	LYRAGAME_API FString GetDefaultBaselineDirectory();
+
+	/** <Directory>/<Name>.perfbaseline.json; the default directory when Directory is empty. */
+	LYRAGAME_API FString GetBaselinePath(const FString& Directory, const FString& Name);
+
+	/** The result as JSON, in the same layout a baseline file uses. */
+	LYRAGAME_API FString ToJson(const FLyraTestPerfCaptureResult& Result);
+
+	/** Checks Result against its scenario's baseline with the baseline's gate, falling back to DefaultGate. */
+	LYRAGAME_API FLyraTestPerfComparison CompareToBaseline(const FLyraTestPerfCaptureResult& Result, const FString& Directory, const FLyraTestPerfGateSettings& DefaultGate);
+
+	/** Writes Result as the baseline for its name; false on a file error. */
+	LYRAGAME_API bool SaveBaseline(const FLyraTestPerfCaptureResult& Result, const FString& Directory);
+}
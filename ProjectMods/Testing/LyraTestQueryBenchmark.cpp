@@ -0,0 +1,198 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Testing/LyraTestQueryBenchmark.h"
+#include "Testing/LyraTestEnemyQuery.h"
+#include "Testing/LyraTestStats.h"
+#include "Testing/LyraTestSupportSubsystem.h"
+#include "AIController.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "Misc/FileHelper.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(LyraTestQueryBenchmark)
+
+ALyraTestBenchmarkCharacter::ALyraTestBenchmarkCharacter(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	PrimaryActorTick.bCanEverTick = false;
+	GetCharacterMovement()->PrimaryComponentTick.bStartWithTickEnabled = false;
+	AIControllerClass = AAIController::StaticClass();
+	AutoPossessAI = EAutoPossessAI::Spawned;
+	SetCanBeDamaged(false);
+}
+
+void ALyraTestBenchmarkCharacter::SetGenericTeamId(const FGenericTeamId& NewTeamID)
+{
+	const FGenericTeamId OldTeamID = TeamId;
+	TeamId = NewTeamID;
+	ConditionalBroadcastTeamChanged(this, OldTeamID, NewTeamID);
+}
+
+void LyraTestQueryBenchmark::SpawnBots(UWorld* World, const FVector& Center, int32 Count, int32 NumTeams, TArray<TWeakObjectPtr<ALyraTestBenchmarkCharacter>>& InOutBots)
+{
+	InOutBots.RemoveAll([](const TWeakObjectPtr<ALyraTestBenchmarkCharacter>& Bot) { return !Bot.IsValid(); });
+	if (!World)
+	{
+		return;
+	}
+
+	NumTeams = FMath::Max(NumTeams, 1);
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	SpawnParams.bDeferConstruction = true;
+	for (int32 Index = InOutBots.Num(); Index < Count; ++Index)
+	{
+		// Sunflower spiral: even density out to about 25 m at 1000 bots, spread over all view directions.
+		const float Angle = Index * 2.39996323f;
+		const float Radius = 300.f + 75.f * FMath::Sqrt(static_cast<float>(Index));
+		const FTransform SpawnTransform(Center + FVector(Radius * FMath::Cos(Angle), Radius * FMath::Sin(Angle), 0.f));
+		ALyraTestBenchmarkCharacter* Bot = World->SpawnActor<ALyraTestBenchmarkCharacter>(ALyraTestBenchmarkCharacter::StaticClass(), SpawnTransform, SpawnParams);
+		if (!Bot)
+		{
+			break;
+		}
+		// Team before construction finishes, so the registry sees it when possession adds the bot.
+		Bot->SetGenericTeamId(FGenericTeamId(static_cast<uint8>(1 + Index % NumTeams)));
+		Bot->FinishSpawning(SpawnTransform);
+		InOutBots.Add(Bot);
+	}
+}
+
+void LyraTestQueryBenchmark::DestroyBots(TArray<TWeakObjectPtr<ALyraTestBenchmarkCharacter>>& InOutBots)
+{
+	for (const TWeakObjectPtr<ALyraTestBenchmarkCharacter>& Bot : InOutBots)
+	{
+		if (ALyraTestBenchmarkCharacter* Character = Bot.Get())
+		{
+			if (AController* Controller = Character->GetController())
+			{
+				Controller->Destroy();
+			}
+			Character->Destroy();
+		}
+	}
+	InOutBots.Reset();
+}
+
+static double GetSortedPercentile(const TArray<double>& SortedSamples, double Percentile)
+{
+	const int32 Rank = FMath::Clamp(FMath::CeilToInt32(SortedSamples.Num() * Percentile), 1, SortedSamples.Num());
+	return SortedSamples[Rank - 1];
+}
+
+void LyraTestQueryBenchmark::Measure(UWorld* World, int32 PlayerIndex, int32 BotCount, int32 Iterations, int64 EventSinceSequence, TArray<FLyraTestBenchmarkResult>& OutResults)
+{
+	UGameInstance* GI = World ? World->GetGameInstance() : nullptr;
+	ULyraTestSupportSubsystem* Support = GI ? GI->GetSubsystem<ULyraTestSupportSubsystem>() : nullptr;
+	if (!Support)
+	{
+		return;
+	}
+
+	FVector AimTarget = FVector::ZeroVector;
+	if (const APlayerController* PC = Support->GetLocalPlayerController(PlayerIndex))
+	{
+		AimTarget = PC->GetPawn() ? PC->GetPawn()->GetActorLocation() + FVector(1000.f, 0.f, 0.f) : AimTarget;
+	}
+
+	// Each case returns the number of bytes handed back to the caller.
+	const TPair<const TCHAR*, TFunction<int64()>> Cases[] = {
+		{ TEXT("GetEnemyLocationsAsString"), [&]() { return static_cast<int64>(ULyraTestEnemyQuery::GetEnemyLocationsAsString(World, PlayerIndex).Len()); } },
+		{ TEXT("GetTestPositionsAsString"), [&]() { return static_cast<int64>(ULyraTestEnemyQuery::GetTestPositionsAsString(World, PlayerIndex).Len()); } },
+		{ TEXT("GetEnemyOnlyTestPositionsAsString"), [&]() { return static_cast<int64>(ULyraTestEnemyQuery::GetEnemyOnlyTestPositionsAsString(World, PlayerIndex).Len()); } },
+		{ TEXT("GetTestSnapshot"), [&]()
+			{
+				FLyraTestSnapshot Snapshot;
+				ULyraTestEnemyQuery::GetTestSnapshot(World, PlayerIndex, true, Snapshot);
+				return static_cast<int64>(Snapshot.Records.Num() * sizeof(FLyraTestSnapshotRecord));
+			} },
+		{ TEXT("GetTestSnapshotBytes"), [&]() { return static_cast<int64>(ULyraTestEnemyQuery::GetTestSnapshotBytes(World, PlayerIndex, true).Num()); } },
+		{ TEXT("GetTestSnapshotBase64"), [&]() { return static_cast<int64>(ULyraTestEnemyQuery::GetTestSnapshotBase64(World, PlayerIndex, true).Len()); } },
+		{ TEXT("FindNearestEnemyId"), [&]() { ULyraTestEnemyQuery::FindNearestEnemyId(World, PlayerIndex, AimTarget.X, AimTarget.Y, AimTarget.Z); return int64(sizeof(int64)); } },
+		{ TEXT("GetNearestEnemiesBase64"), [&]() { return static_cast<int64>(ULyraTestEnemyQuery::GetNearestEnemiesBase64(World, PlayerIndex, AimTarget.X, AimTarget.Y, AimTarget.Z, 8).Len()); } },
+		{ TEXT("GetEnemiesInRadiusBase64"), [&]() { return static_cast<int64>(ULyraTestEnemyQuery::GetEnemiesInRadiusBase64(World, PlayerIndex, AimTarget.X, AimTarget.Y, AimTarget.Z, 2000.f).Len()); } },
+		{ TEXT("GetEnemiesInViewConeBase64"), [&]() { return static_cast<int64>(ULyraTestEnemyQuery::GetEnemiesInViewConeBase64(World, PlayerIndex, 30.f, 10000.f).Len()); } },
+		{ TEXT("GetEnemyOnlyPositionsAndAimAt"), [&]() { return static_cast<int64>(ULyraTestEnemyQuery::GetEnemyOnlyPositionsAndAimAt(World, PlayerIndex, AimTarget.X, AimTarget.Y, AimTarget.Z, false).Len()); } },
+		{ TEXT("SetLocalPlayerInvincible"), [&]() { ULyraTestEnemyQuery::SetLocalPlayerInvincible(World, true); return int64(0); } },
+		{ TEXT("SetLocalPlayerInfiniteAmmo"), [&]() { ULyraTestEnemyQuery::SetLocalPlayerInfiniteAmmo(World, true); return int64(0); } },
+		{ TEXT("GetLocalPlayerPawnId"), [&]() { ULyraTestEnemyQuery::GetLocalPlayerPawnId(World, PlayerIndex); return int64(sizeof(int64)); } },
+		{ TEXT("GetLatestTestEventSequence"), [&]() { ULyraTestEnemyQuery::GetLatestTestEventSequence(World); return int64(sizeof(int64)); } },
+		{ TEXT("GetTestEventsSinceBase64"), [&]() { return static_cast<int64>(ULyraTestEnemyQuery::GetTestEventsSinceBase64(World, EventSinceSequence).Len()); } },
+		{ TEXT("GetLatestCombatSequence"), [&]() { ULyraTestEnemyQuery::GetLatestCombatSequence(World); return int64(sizeof(int64)); } },
+		{ TEXT("GetCombatLogSinceBase64"), [&]() { return static_cast<int64>(ULyraTestEnemyQuery::GetCombatLogSinceBase64(World, 0).Len()); } },
+		{ TEXT("FindKillSince"), [&]() { ULyraTestEnemyQuery::FindKillSince(World, 0); return int64(sizeof(int64)); } },
+		{ TEXT("ExecuteTestCommands"), [&]() { return static_cast<int64>(ULyraTestEnemyQuery::ExecuteTestCommands(World, PlayerIndex, TEXT("snap 1")).Len()); } },
+		// Batches that complete inline are not kept, so this measures the unknown-batch reply.
+		{ TEXT("GetTestCommandResults"), [&]() { return static_cast<int64>(ULyraTestEnemyQuery::GetTestCommandResults(World, 0).Len()); } },
+		{ TEXT("GetTestStatsSummary"), [&]() { return static_cast<int64>(ULyraTestEnemyQuery::GetTestStatsSummary(World, false).Len()); } },
+		{ TEXT("TickContinuousAimFire"), [&]() { Support->TickContinuousAimFire(PlayerIndex); return int64(0); } },
+	};
+
+	TArray<double> Samples;
+	Samples.Reserve(Iterations);
+	for (const TPair<const TCHAR*, TFunction<int64()>>& Case : Cases)
+	{
+		// One untimed call so first-use allocations (lazy components, grown buffers) are not charged to the first sample.
+		Case.Value();
+
+		Samples.Reset();
+		uint64 TotalAllocs = 0;
+		int64 TotalBytes = 0;
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			const uint64 StartAllocs = LyraTestStats::GetAllocationCount();
+			const uint64 StartCycles = FPlatformTime::Cycles64();
+			TotalBytes += Case.Value();
+			const uint64 Cycles = FPlatformTime::Cycles64() - StartCycles;
+			TotalAllocs += LyraTestStats::GetAllocationCount() - StartAllocs;
+			Samples.Add(FPlatformTime::ToSeconds64(Cycles) * 1e6);
+		}
+		if (Samples.Num() == 0)
+		{
+			continue;
+		}
+		Samples.Sort();
+
+		FLyraTestBenchmarkResult& Result = OutResults.AddDefaulted_GetRef();
+		Result.BotCount = BotCount;
+		Result.Function = Case.Key;
+		Result.Calls = Samples.Num();
+		double TotalMicroseconds = 0.0;
+		for (double Sample : Samples)
+		{
+			TotalMicroseconds += Sample;
+		}
+		Result.MeanMicroseconds = TotalMicroseconds / Samples.Num();
+		Result.P50Microseconds = GetSortedPercentile(Samples, 0.5);
+		Result.P95Microseconds = GetSortedPercentile(Samples, 0.95);
+		Result.P99Microseconds = GetSortedPercentile(Samples, 0.99);
+		Result.MaxMicroseconds = Samples.Last();
+		Result.AllocationsPerCall = static_cast<double>(TotalAllocs) / Samples.Num();
+		Result.BytesPerCall = static_cast<double>(TotalBytes) / Samples.Num();
+	}
+
+	// TickContinuousAimFire taps fire and the aim cases rotate the controller; leave the player idle.
+	Support->StopFirePattern(PlayerIndex);
+}
+
+void LyraTestQueryBenchmark::WriteReports(const FString& Directory, const FString& Name, int32 Iterations, TConstArrayView<FLyraTestBenchmarkResult> Results)
+{
+	FString Csv = TEXT("bots,function,calls,mean_us,p50_us,p95_us,p99_us,max_us,allocs_per_call,bytes_per_call\n");
+	FString Json = FString::Printf(TEXT("{\n  \"benchmark\": \"%s\",\n  \"iterations\": %d,\n  \"results\": ["), *Name, Iterations);
+	for (int32 Index = 0; Index < Results.Num(); ++Index)
+	{
+		const FLyraTestBenchmarkResult& Result = Results[Index];
+		Csv += FString::Printf(TEXT("%d,%s,%d,%.3f,%.3f,%.3f,%.3f,%.3f,%.2f,%.1f\n"),
+			Result.BotCount, *Result.Function, Result.Calls, Result.MeanMicroseconds, Result.P50Microseconds, Result.P95Microseconds,
+			Result.P99Microseconds, Result.MaxMicroseconds, Result.AllocationsPerCall, Result.BytesPerCall);
+		Json += FString::Printf(TEXT("%s\n    {\"bots\": %d, \"function\": \"%s\", \"calls\": %d, \"meanUs\": %.3f, \"p50Us\": %.3f, \"p95Us\": %.3f, \"p99Us\": %.3f, \"maxUs\": %.3f, \"allocsPerCall\": %.2f, \"bytesPerCall\": %.1f}"),
+			Index > 0 ? TEXT(",") : TEXT(""), Result.BotCount, *Result.Function, Result.Calls, Result.MeanMicroseconds, Result.P50Microseconds,
+			Result.P95Microseconds, Result.P99Microseconds, Result.MaxMicroseconds, Result.AllocationsPerCall, Result.BytesPerCall);
+	}
+	Json += TEXT("\n  ]\n}\n");
+
+	FFileHelper::SaveStringToFile(Csv, *(Directory / Name + TEXT(".csv")), FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+	FFileHelper::SaveStringToFile(Json, *(Directory / Name + TEXT(".json")), FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+}
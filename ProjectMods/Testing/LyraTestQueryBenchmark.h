@@ -0,0 +1,82 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "GameFramework/Character.h"
+#include "Teams/LyraTeamAgentInterface.h"
+#include "LyraTestQueryBenchmark.generated.h"
+
+/**
+ * Bare AI-possessed character on a fixed team, used to populate the enemy registry at benchmark scale.
+ * No mesh, movement or health, so the measured cost is the harness and not the bots.
+ */
+UCLASS(NotPlaceable, Transient)
+class LYRAGAME_API ALyraTestBenchmarkCharacter : public ACharacter, public ILyraTeamAgentInterface
+{
+	GENERATED_BODY()
+
+public:
+	ALyraTestBenchmarkCharacter(const FObjectInitializer& ObjectInitializer);
+
+	virtual void SetGenericTeamId(const FGenericTeamId& NewTeamID) override;
+	virtual FGenericTeamId GetGenericTeamId() const override { return TeamId; }
+	virtual FOnLyraTeamIndexChangedDelegate* GetOnTeamIndexChangedDelegate() override { return &OnTeamChangedDelegate; }
+
+private:
+	UPROPERTY()
+	FOnLyraTeamIndexChangedDelegate OnTeamChangedDelegate;
+
+	FGenericTeamId TeamId;
+};
+
+USTRUCT(BlueprintType)
+struct LYRAGAME_API FLyraTestBenchmarkResult
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	int32 BotCount = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	FString Function;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	int32 Calls = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	double MeanMicroseconds = 0.0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	double P50Microseconds = 0.0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	double P95Microseconds = 0.0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	double P99Microseconds = 0.0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	double MaxMicroseconds = 0.0;
+
+	/** Process wide heap allocations per call; 0 in shipping builds. */
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	double AllocationsPerCall = 0.0;
+
+	/** Size of the returned string, byte array or snapshot records. */
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	double BytesPerCall = 0.0;
+};
+
+namespace LyraTestQueryBenchmark
+{
+	/** Spawns benchmark characters around Center, round-robin over teams 1..NumTeams, until InOutBots holds Count live bots. */
+	LYRAGAME_API void SpawnBots(UWorld* World, const FVector& Center, int32 Count, int32 NumTeams, TArray<TWeakObjectPtr<ALyraTestBenchmarkCharacter>>& InOutBots);
+
+	LYRAGAME_API void DestroyBots(TArray<TWeakObjectPtr<ALyraTestBenchmarkCharacter>>& InOutBots);
+
+	/** Times every ULyraTestEnemyQuery entry point and TickContinuousAimFire Iterations times and appends one result per function. */
+	LYRAGAME_API void Measure(UWorld* World, int32 PlayerIndex, int32 BotCount, int32 Iterations, int64 EventSinceSequence, TArray<FLyraTestBenchmarkResult>& OutResults);
+
+	/** Writes <Name>.csv and <Name>.json into Directory. */
+	LYRAGAME_API void WriteReports(const FString& Directory, const FString& Name, int32 Iterations, TConstArrayView<FLyraTestBenchmarkResult> Results);
+}
@@ -0,0 +1,581 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Testing/LyraTestScenarioRunner.h"
+#include "Testing/LyraTestBotLod.h"
+#include "Testing/LyraTestEnemyQuery.h"
+#include "Testing/LyraTestInstanceConfig.h"
+#include "Testing/LyraTestSessionBootstrap.h"
+#include "Testing/LyraTestSupportSubsystem.h"
+#include "Testing/LyraTestWorlds.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/PlatformMisc.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(LyraTestScenarioRunner)
+
+static const TCHAR* AimShootKillScenarioName = TEXT("AimShootKill");
+static const TCHAR* QueryBenchmarkScenarioName = TEXT("QueryBenchmark");
+
+// Fire pattern used while the aim is settled on the target.
+static constexpr int32 EngageHoldFrames = 3;
+static constexpr int32 EngageIntervalFrames = 6;
+
+static constexpr float FastForwardFixedDeltaSeconds = 1.f / 60.f;
+
+static FString EscapeXml(const FString& Text)
+{
+	FString Out = Text.Replace(TEXT("&"), TEXT("&amp;"));
+	Out.ReplaceInline(TEXT("<"), TEXT("&lt;"));
+	Out.ReplaceInline(TEXT(">"), TEXT("&gt;"));
+	Out.ReplaceInline(TEXT("\""), TEXT("&quot;"));
+	Out.ReplaceInline(TEXT("'"), TEXT("&apos;"));
+	return Out;
+}
+
+static FString EscapeJson(const FString& Text)
+{
+	FString Out;
+	Out.Reserve(Text.Len());
+	for (TCHAR Ch : Text)
+	{
+		switch (Ch)
+		{
+		case TEXT('"'): Out += TEXT("\\\""); break;
+		case TEXT('\\'): Out += TEXT("\\\\"); break;
+		case TEXT('\n'): Out += TEXT("\\n"); break;
+		case TEXT('\r'): Out += TEXT("\\r"); break;
+		case TEXT('\t'): Out += TEXT("\\t"); break;
+		default:
+			if (Ch < 0x20)
+			{
+				Out += FString::Printf(TEXT("\\u%04x"), static_cast<uint32>(Ch));
+			}
+			else
+			{
+				Out.AppendChar(Ch);
+			}
+			break;
+		}
+	}
+	return Out;
+}
+
+int32 ULyraTestScenarioRunner::PendingExitScenarios = 0;
+bool ULyraTestScenarioRunner::bAnyExitScenarioFailed = false;
+
+static FString GetPhaseName(ELyraTestScenarioPhase Phase)
+{
+	return StaticEnum<ELyraTestScenarioPhase>()->GetNameStringByValue(static_cast<int64>(Phase));
+}
+
+bool ULyraTestScenarioRunner::ParseCommandLineSettings(const TCHAR* CommandLine, FLyraTestScenarioSettings& OutSettings)
+{
+	if (!FParse::Value(CommandLine, TEXT("LyraTestScenario="), OutSettings.ScenarioName))
+	{
+		return false;
+	}
+	const FLyraTestInstanceConfig& Instance = LyraTestInstanceConfig::Get();
+	if (!Instance.MapName.IsEmpty())
+	{
+		OutSettings.MapName = Instance.MapName;
+		OutSettings.Experience = Instance.Experience;
+	}
+	FParse::Value(CommandLine, TEXT("LyraTestScenarioMap="), OutSettings.MapName);
+	FParse::Value(CommandLine, TEXT("LyraTestScenarioExperience="), OutSettings.Experience);
+	FParse::Value(CommandLine, TEXT("LyraTestScenarioKills="), OutSettings.KillCount);
+	FParse::Value(CommandLine, TEXT("LyraTestScenarioTimeout="), OutSettings.KillTimeoutSeconds);
+	FParse::Value(CommandLine, TEXT("LyraTestScenarioReport="), OutSettings.ReportDirectory);
+	FParse::Value(CommandLine, TEXT("LyraTestFastForward="), OutSettings.FastForwardTimeDilation);
+	FParse::Value(CommandLine, TEXT("LyraTestBenchmarkIterations="), OutSettings.BenchmarkIterations);
+	FString BotCounts;
+	if (FParse::Value(CommandLine, TEXT("LyraTestBenchmarkBots="), BotCounts, false))
+	{
+		TArray<FString> Tokens;
+		BotCounts.ParseIntoArray(Tokens, TEXT(","), true);
+		OutSettings.BenchmarkBotCounts.Reset();
+		for (const FString& Token : Tokens)
+		{
+			int32 Count = 0;
+			if (LexTryParseString(Count, *Token))
+			{
+				OutSettings.BenchmarkBotCounts.Add(Count);
+			}
+		}
+	}
+	FParse::Value(CommandLine, TEXT("LyraTestPerfBaseline="), OutSettings.PerfBaselineDirectory);
+	FParse::Value(CommandLine, TEXT("LyraTestPerfHitchMs="), OutSettings.PerfHitchThresholdMs);
+	OutSettings.bUpdatePerfBaseline = FParse::Param(CommandLine, TEXT("LyraTestPerfUpdateBaseline"));
+	OutSettings.bCapturePerf = !FParse::Param(CommandLine, TEXT("LyraTestNoPerf"));
+	OutSettings.bLoadMap = !FParse::Param(CommandLine, TEXT("LyraTestScenarioNoLoad"));
+	OutSettings.bExitWhenDone = true;
+	return true;
+}
+
+void ULyraTestScenarioRunner::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	Collection.InitializeDependency<ULyraTestSupportSubsystem>();
+	Collection.InitializeDependency<ULyraTestSessionBootstrap>();
+
+	FLyraTestScenarioSettings CommandLineSettings;
+	const bool bCommandLineScenario = ParseCommandLineSettings(FCommandLine::Get(), CommandLineSettings);
+	TArray<FString> ScenarioNames;
+	if (bCommandLineScenario && CommandLineSettings.ScenarioName.ParseIntoArray(ScenarioNames, TEXT(","), true) > 1)
+	{
+		CommandLineSettings.ScenarioName = ScenarioNames[FMath::Max(LyraTestWorlds::GetWorldId(GetGameInstance()), 0) % ScenarioNames.Num()];
+	}
+	if (bCommandLineScenario && !StartScenario(CommandLineSettings))
+	{
+		// Unknown scenario: report it rather than leaving a CI agent waiting on a process that never exits.
+		Settings = CommandLineSettings;
+		Results.Reset();
+		RunStartTime = FPlatformTime::Seconds();
+		BeginCase(TEXT("Setup"));
+		EndCase(false, FString::Printf(TEXT("Unknown scenario '%s'"), *CommandLineSettings.ScenarioName));
+		Finish();
+	}
+}
+
+void ULyraTestScenarioRunner::Deinitialize()
+{
+	if (bPendingExit)
+	{
+		--PendingExitScenarios;
+		bPendingExit = false;
+	}
+	Phase = ELyraTestScenarioPhase::Idle;
+	Super::Deinitialize();
+}
+
+bool ULyraTestScenarioRunner::StartScenario(const FLyraTestScenarioSettings& InSettings)
+{
+	if (IsScenarioRunning() || (InSettings.ScenarioName != AimShootKillScenarioName && InSettings.ScenarioName != QueryBenchmarkScenarioName))
+	{
+		return false;
+	}
+	Settings = InSettings;
+	Settings.KillCount = FMath::Max(Settings.KillCount, 1);
+	Settings.PlayerIndex = FMath::Max(Settings.PlayerIndex, 0);
+	Settings.BenchmarkIterations = FMath::Max(Settings.BenchmarkIterations, 1);
+	// Bots are only ever added between steps, so counts run ascending.
+	Settings.BenchmarkBotCounts.RemoveAll([](int32 Count) { return Count <= 0; });
+	Settings.BenchmarkBotCounts.Sort();
+	BenchmarkResults.Reset();
+	BenchmarkStep = 0;
+	PerfResult = FLyraTestPerfCaptureResult();
+	bCapturingPerf = false;
+	Results.Reset();
+	KillsAttempted = 0;
+	TargetId = 0;
+	bFiring = false;
+	SessionToken = 0;
+	RunStartTime = FPlatformTime::Seconds();
+	RunSimulatedSeconds = 0.0;
+
+	if (Settings.FastForwardTimeDilation > 0.f)
+	{
+		if (ULyraTestSupportSubsystem* Support = GetGameInstance()->GetSubsystem<ULyraTestSupportSubsystem>())
+		{
+			Support->SetFastForwardEnabled(true, FastForwardFixedDeltaSeconds, Settings.FastForwardTimeDilation);
+		}
+	}
+
+	if (Settings.bExitWhenDone && !bPendingExit)
+	{
+		++PendingExitScenarios;
+		bPendingExit = true;
+	}
+
+	BeginCase(TEXT("Setup"));
+	EnterPhase(Settings.bLoadMap ? ELyraTestScenarioPhase::LoadMap : ELyraTestScenarioPhase::WaitForExperience);
+	return true;
+}
+
+bool ULyraTestScenarioRunner::IsScenarioRunning() const
+{
+	return Phase != ELyraTestScenarioPhase::Idle && Phase != ELyraTestScenarioPhase::Finished;
+}
+
+bool ULyraTestScenarioRunner::IsTickable() const
+{
+	return !HasAnyFlags(RF_ClassDefaultObject) && IsScenarioRunning();
+}
+
+TStatId ULyraTestScenarioRunner::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(ULyraTestScenarioRunner, STATGROUP_Tickables);
+}
+
+void ULyraTestScenarioRunner::Tick(float DeltaTime)
+{
+	UGameInstance* GI = GetGameInstance();
+	UWorld* World = GI ? GI->GetWorld() : nullptr;
+	ULyraTestSupportSubsystem* Support = GI ? GI->GetSubsystem<ULyraTestSupportSubsystem>() : nullptr;
+	APlayerController* PC = Support ? Support->GetLocalPlayerController(Settings.PlayerIndex) : nullptr;
+
+	// Dilated delta of the last world tick, so kill timeouts follow game time under fast-forward.
+	const double SimulatedDelta = World ? World->GetDeltaSeconds() : 0.0;
+	CaseSimulatedSeconds += SimulatedDelta;
+	RunSimulatedSeconds += SimulatedDelta;
+
+	switch (Phase)
+	{
+	case ELyraTestScenarioPhase::LoadMap:
+	case ELyraTestScenarioPhase::WaitForExperience:
+	case ELyraTestScenarioPhase::WaitForPawn:
+		TickLoad(World);
+		break;
+	case ELyraTestScenarioPhase::AcquireTarget:
+	case ELyraTestScenarioPhase::Engage:
+		TickKill(World, PC, Support);
+		break;
+	case ELyraTestScenarioPhase::Benchmark:
+		TickBenchmark(World, PC, Support);
+		break;
+	default:
+		break;
+	}
+}
+
+void ULyraTestScenarioRunner::TickLoad(UWorld* World)
+{
+	ULyraTestSessionBootstrap* Bootstrap = GetGameInstance()->GetSubsystem<ULyraTestSessionBootstrap>();
+	if (!Bootstrap)
+	{
+		return;
+	}
+	if (SessionToken == 0)
+	{
+		// The game instance has no world yet while subsystems initialize, so the session starts on the first tick.
+		if (!World)
+		{
+			return;
+		}
+		FLyraTestSessionSettings SessionSettings;
+		if (Settings.bLoadMap)
+		{
+			SessionSettings.MapName = Settings.MapName;
+			SessionSettings.Experience = Settings.Experience;
+			SessionSettings.BotCount = LyraTestInstanceConfig::Get().BotCount;
+		}
+		SessionSettings.PlayerIndex = Settings.PlayerIndex;
+		SessionSettings.bSkipWarmup = false;
+		SessionSettings.TimeoutSeconds = Settings.LoadTimeoutSeconds;
+		SessionToken = Bootstrap->StartSession(SessionSettings);
+	}
+
+	switch (Bootstrap->GetSessionState(SessionToken))
+	{
+	case ELyraTestSessionState::Traveling:
+		break;
+	case ELyraTestSessionState::WaitForExperience:
+		EnterPhase(ELyraTestScenarioPhase::WaitForExperience);
+		break;
+	case ELyraTestSessionState::WaitForPawn:
+	case ELyraTestSessionState::WaitForWarmup:
+		EnterPhase(ELyraTestScenarioPhase::WaitForPawn);
+		break;
+	case ELyraTestSessionState::Ready:
+		EndCase(true);
+		if (IsBenchmarkScenario())
+		{
+			BeginNextBenchmarkStepOrFinish();
+		}
+		else
+		{
+			BeginNextKillOrFinish();
+		}
+		break;
+	case ELyraTestSessionState::Failed:
+		EndCase(false, Bootstrap->GetSessionFailure(SessionToken));
+		Finish();
+		break;
+	default:
+		EndCase(false, TEXT("Session bootstrap was restarted by another caller"));
+		Finish();
+		break;
+	}
+}
+
+void ULyraTestScenarioRunner::TickKill(UWorld* World, APlayerController* PC, ULyraTestSupportSubsystem* Support)
+{
+	if (CaseSimulatedSeconds > Settings.KillTimeoutSeconds)
+	{
+		StopEngaging(Support);
+		EndCase(false, Phase == ELyraTestScenarioPhase::AcquireTarget
+			? FString::Printf(TEXT("No visible target within %.0f s"), Settings.KillTimeoutSeconds)
+			: FString::Printf(TEXT("No kill confirmed on target %lld within %.0f s"), TargetId, Settings.KillTimeoutSeconds));
+		BeginNextKillOrFinish();
+		return;
+	}
+	if (!World || !PC || !Support)
+	{
+		return;
+	}
+
+	const int32 PlayerIndex = Settings.PlayerIndex;
+	if (Phase == ELyraTestScenarioPhase::AcquireTarget)
+	{
+		// Line of sight resolves from async traces, so this usually takes a few frames.
+		const int64 SelectedId = Support->SelectTargetForPlayer(PlayerIndex);
+		if (SelectedId != 0 && Support->StartAimTracking(PlayerIndex, SelectedId, false))
+		{
+			TargetId = SelectedId;
+			Results.Last().TargetId = SelectedId;
+			KillSinceSequence = Support->GetLatestCombatSequence();
+			EnterPhase(ELyraTestScenarioPhase::Engage);
+		}
+		return;
+	}
+
+	const int64 PlayerPawnId = ULyraTestEnemyQuery::GetTestObjectId(PC->GetPawn());
+	if (PlayerPawnId != 0 && Support->FindKillSince(KillSinceSequence, TargetId, PlayerPawnId) != 0)
+	{
+		StopEngaging(Support);
+		EndCase(true);
+		BeginNextKillOrFinish();
+		return;
+	}
+	if (Support->FindKillSince(KillSinceSequence, TargetId, 0) != 0)
+	{
+		// Someone else got the kill; pick a new target inside the same case.
+		StopEngaging(Support);
+		EnterPhase(ELyraTestScenarioPhase::AcquireTarget);
+		return;
+	}
+
+	const bool bSettled = Support->IsAimSettled(PlayerIndex);
+	if (bSettled != bFiring)
+	{
+		if (bSettled)
+		{
+			Support->StartFirePattern(PlayerIndex, 0, EngageHoldFrames, EngageIntervalFrames);
+		}
+		else
+		{
+			Support->StopFirePattern(PlayerIndex);
+		}
+		bFiring = bSettled;
+	}
+}
+
+void ULyraTestScenarioRunner::TickBenchmark(UWorld* World, APlayerController* PC, ULyraTestSupportSubsystem* Support)
+{
+	if (!World || !Support)
+	{
+		return;
+	}
+
+	const int32 BotCount = Settings.BenchmarkBotCounts[BenchmarkStep - 1];
+	if (!bBenchmarkBotsSpawned)
+	{
+		BenchmarkEventSequence = ULyraTestEnemyQuery::GetLatestTestEventSequence(World);
+		const APawn* PlayerPawn = PC ? PC->GetPawn() : nullptr;
+		LyraTestQueryBenchmark::SpawnBots(World, PlayerPawn ? PlayerPawn->GetActorLocation() : FVector::ZeroVector, BotCount, Settings.BenchmarkTeamCount, BenchmarkBots);
+		bBenchmarkBotsSpawned = true;
+		// Measure on the next frame, once possession has registered the new bots.
+		return;
+	}
+
+	const int32 NumSpawned = BenchmarkBots.Num();
+	LyraTestQueryBenchmark::Measure(World, Settings.PlayerIndex, NumSpawned, Settings.BenchmarkIterations, BenchmarkEventSequence, BenchmarkResults);
+	EndCase(NumSpawned >= BotCount, NumSpawned >= BotCount ? FString() : FString::Printf(TEXT("Spawned %d of %d bots"), NumSpawned, BotCount));
+	BeginNextBenchmarkStepOrFinish();
+}
+
+void ULyraTestScenarioRunner::EnterPhase(ELyraTestScenarioPhase NewPhase)
+{
+	Phase = NewPhase;
+}
+
+void ULyraTestScenarioRunner::BeginCase(const FString& Name)
+{
+	FLyraTestScenarioCaseResult& Result = Results.AddDefaulted_GetRef();
+	Result.Name = Name;
+	CaseStartTime = FPlatformTime::Seconds();
+	CaseSimulatedSeconds = 0.0;
+	CaseStartFrame = GFrameCounter;
+}
+
+void ULyraTestScenarioRunner::EndCase(bool bPassed, const FString& Failure)
+{
+	FLyraTestScenarioCaseResult& Result = Results.Last();
+	Result.bPassed = bPassed;
+	Result.Phase = Phase;
+	Result.Failure = Failure;
+	Result.DurationSeconds = FPlatformTime::Seconds() - CaseStartTime;
+	Result.SimulatedSeconds = CaseSimulatedSeconds;
+	Result.Frames = static_cast<int64>(GFrameCounter - CaseStartFrame);
+}
+
+void ULyraTestScenarioRunner::BeginNextKillOrFinish()
+{
+	if (KillsAttempted >= Settings.KillCount)
+	{
+		Finish();
+		return;
+	}
+	if (KillsAttempted == 0 && Settings.bCapturePerf)
+	{
+		if (ULyraTestSupportSubsystem* Support = GetGameInstance()->GetSubsystem<ULyraTestSupportSubsystem>())
+		{
+			Support->BeginPerfCapture(Settings.ScenarioName, Settings.PerfHitchThresholdMs);
+			bCapturingPerf = true;
+		}
+	}
+	++KillsAttempted;
+	TargetId = 0;
+	BeginCase(FString::Printf(TEXT("Kill%d"), KillsAttempted));
+	EnterPhase(ELyraTestScenarioPhase::AcquireTarget);
+}
+
+void ULyraTestScenarioRunner::BeginNextBenchmarkStepOrFinish()
+{
+	if (BenchmarkStep >= Settings.BenchmarkBotCounts.Num())
+	{
+		Finish();
+		return;
+	}
+	BeginCase(FString::Printf(TEXT("Bots%d"), Settings.BenchmarkBotCounts[BenchmarkStep]));
+	++BenchmarkStep;
+	bBenchmarkBotsSpawned = false;
+	EnterPhase(ELyraTestScenarioPhase::Benchmark);
+}
+
+bool ULyraTestScenarioRunner::IsBenchmarkScenario() const
+{
+	return Settings.ScenarioName == QueryBenchmarkScenarioName;
+}
+
+void ULyraTestScenarioRunner::StopEngaging(ULyraTestSupportSubsystem* Support)
+{
+	if (Support)
+	{
+		Support->StopFirePattern(Settings.PlayerIndex);
+		Support->StopAimTracking(Settings.PlayerIndex);
+	}
+	bFiring = false;
+}
+
+void ULyraTestScenarioRunner::EndPerfCase(ULyraTestSupportSubsystem* Support)
+{
+	bCapturingPerf = false;
+	PerfResult = Support ? Support->EndPerfCapture() : FLyraTestPerfCaptureResult();
+	if (!PerfResult.bValid)
+	{
+		return;
+	}
+	const FLyraTestPerfComparison Comparison = Support->ComparePerfCaptureToBaseline(PerfResult, Settings.PerfBaselineDirectory, Settings.PerfGate);
+	if ((Comparison.bPassed && !Comparison.bBaselineFound) || Settings.bUpdatePerfBaseline)
+	{
+		LyraTestPerfCapture::SaveBaseline(PerfResult, Settings.PerfBaselineDirectory);
+	}
+
+	BeginCase(TEXT("Perf"));
+	EndCase(Comparison.bPassed, FString::Join(Comparison.Regressions, TEXT("; ")));
+	FLyraTestScenarioCaseResult& Result = Results.Last();
+	Result.DurationSeconds = PerfResult.DurationSeconds;
+	Result.Frames = PerfResult.Frames;
+}
+
+void ULyraTestScenarioRunner::Finish()
+{
+	EnterPhase(ELyraTestScenarioPhase::Finished);
+	LyraTestQueryBenchmark::DestroyBots(BenchmarkBots);
+	ULyraTestSupportSubsystem* Support = GetGameInstance()->GetSubsystem<ULyraTestSupportSubsystem>();
+	if (bCapturingPerf)
+	{
+		EndPerfCase(Support);
+	}
+	WriteReports();
+	if (Settings.FastForwardTimeDilation > 0.f && Support)
+	{
+		Support->SetFastForwardEnabled(false);
+	}
+	if (Settings.bExitWhenDone)
+	{
+		bAnyExitScenarioFailed |= Results.ContainsByPredicate([](const FLyraTestScenarioCaseResult& Result) { return !Result.bPassed; });
+		if (bPendingExit)
+		{
+			--PendingExitScenarios;
+			bPendingExit = false;
+		}
+		if (PendingExitScenarios == 0)
+		{
+			FPlatformMisc::RequestExitWithStatus(false, bAnyExitScenarioFailed ? 1 : 0);
+		}
+	}
+}
+
+FString ULyraTestScenarioRunner::GetReportName() const
+{
+	// Worlds sharing a process would otherwise overwrite each other's reports.
+	const UGameInstance* GI = GetGameInstance();
+	return LyraTestWorlds::IsSharedProcess(GI) ? FString::Printf(TEXT("%s.w%d"), *Settings.ScenarioName, LyraTestWorlds::GetWorldId(GI)) : Settings.ScenarioName;
+}
+
+void ULyraTestScenarioRunner::WriteReports() const
+{
+	const FString Directory = Settings.ReportDirectory.IsEmpty() ? FPaths::ProjectSavedDir() / TEXT("TestScenarios") : Settings.ReportDirectory;
+	const FString SuiteName = FString::Printf(TEXT("LyraTestScenario.%s"), *Settings.ScenarioName);
+	const double TotalSeconds = FPlatformTime::Seconds() - RunStartTime;
+	int32 NumFailed = 0;
+	for (const FLyraTestScenarioCaseResult& Result : Results)
+	{
+		NumFailed += Result.bPassed ? 0 : 1;
+	}
+
+	FString Xml = TEXT("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
+	Xml += FString::Printf(TEXT("<testsuites tests=\"%d\" failures=\"%d\" time=\"%.3f\">\n"), Results.Num(), NumFailed, TotalSeconds);
+	Xml += FString::Printf(TEXT("  <testsuite name=\"%s\" tests=\"%d\" failures=\"%d\" time=\"%.3f\">\n"), *EscapeXml(SuiteName), Results.Num(), NumFailed, TotalSeconds);
+	for (const FLyraTestScenarioCaseResult& Result : Results)
+	{
+		Xml += FString::Printf(TEXT("    <testcase classname=\"%s\" name=\"%s\" time=\"%.3f\""), *EscapeXml(SuiteName), *EscapeXml(Result.Name), Result.DurationSeconds);
+		if (Result.bPassed)
+		{
+			Xml += TEXT("/>\n");
+		}
+		else
+		{
+			Xml += FString::Printf(TEXT(">\n      <failure message=\"%s\" type=\"%s\"/>\n    </testcase>\n"), *EscapeXml(Result.Failure), *EscapeXml(GetPhaseName(Result.Phase)));
+		}
+	}
+	Xml += TEXT("  </testsuite>\n</testsuites>\n");
+
+	FString Json = TEXT("{\n");
+	Json += FString::Printf(TEXT("  \"scenario\": \"%s\",\n  \"map\": \"%s\",\n  \"experience\": \"%s\",\n  \"instance\": %s,\n"),
+		*EscapeJson(Settings.ScenarioName), *EscapeJson(Settings.bLoadMap ? Settings.MapName : FString()), *EscapeJson(Settings.Experience),
+		*LyraTestInstanceConfig::ToJson(LyraTestInstanceConfig::Get()));
+	if (const ULyraTestBotLod* BotLod = GetGameInstance()->GetSubsystem<ULyraTestBotLod>())
+	{
+		Json += FString::Printf(TEXT("  \"botLod\": %s,\n"), *BotLod->GetBotLodCountsJson());
+	}
+	Json += FString::Printf(TEXT("  \"tests\": %d,\n  \"failures\": %d,\n  \"durationSeconds\": %.3f,\n  \"simulatedSeconds\": %.3f,\n  \"simulatedTimeRatio\": %.3f,\n  \"cases\": ["),
+		Results.Num(), NumFailed, TotalSeconds, RunSimulatedSeconds, TotalSeconds > 0.0 ? RunSimulatedSeconds / TotalSeconds : 0.0);
+	for (int32 Index = 0; Index < Results.Num(); ++Index)
+	{
+		const FLyraTestScenarioCaseResult& Result = Results[Index];
+		Json += FString::Printf(TEXT("%s\n    {\"name\": \"%s\", \"passed\": %s, \"phase\": \"%s\", \"failure\": \"%s\", \"durationSeconds\": %.3f, \"simulatedSeconds\": %.3f, \"frames\": %lld, \"targetId\": %lld}"),
+			Index > 0 ? TEXT(",") : TEXT(""), *EscapeJson(Result.Name), Result.bPassed ? TEXT("true") : TEXT("false"), *EscapeJson(GetPhaseName(Result.Phase)),
+			*EscapeJson(Result.Failure), Result.DurationSeconds, Result.SimulatedSeconds, Result.Frames, Result.TargetId);
+	}
+	Json += TEXT("\n  ]\n}\n");
+
+	const FString ReportName = GetReportName();
+	FFileHelper::SaveStringToFile(Xml, *(Directory / ReportName + TEXT(".junit.xml")), FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+	FFileHelper::SaveStringToFile(Json, *(Directory / ReportName + TEXT(".json")), FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+	if (PerfResult.bValid)
+	{
+		FFileHelper::SaveStringToFile(LyraTestPerfCapture::ToJson(PerfResult), *(Directory / ReportName + TEXT(".perf.json")), FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+	}
+	if (IsBenchmarkScenario())
+	{
+		LyraTestQueryBenchmark::WriteReports(Directory, ReportName + TEXT("Results"), Settings.BenchmarkIterations, BenchmarkResults);
+	}
+}
@@ -0,0 +1,226 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Testing/LyraTestPerfCapture.h"
+#include "Testing/LyraTestQueryBenchmark.h"
+#include "Tickable.h"
+#include "LyraTestScenarioRunner.generated.h"
+
+class APlayerController;
+class ULyraTestSupportSubsystem;
+class UWorld;
+
+UENUM(BlueprintType)
+enum class ELyraTestScenarioPhase : uint8
+{
+	Idle,
+	LoadMap,
+	WaitForExperience,
+	WaitForPawn,
+	AcquireTarget,
+	Engage,
+	Benchmark,
+	Finished
+};
+
+USTRUCT(BlueprintType)
+struct LYRAGAME_API FLyraTestScenarioSettings
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	FString ScenarioName = TEXT("AimShootKill");
+
+	/** Map opened before the scenario; ignored when bLoadMap is false (run on the current map). From the command line, defaults to the instance configuration's map and experience. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	FString MapName = TEXT("/ShooterMaps/Maps/L_Expanse");
+
+	/** Passed as the Experience URL option; empty uses the map's default experience. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	FString Experience = TEXT("B_ShooterGame_Elimination");
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	bool bLoadMap = true;
+
+	/** Each kill is reported as its own test case. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	int32 KillCount = 1;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	int32 PlayerIndex = 0;
+
+	/** Covers map load, experience load and pawn possession. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	float LoadTimeoutSeconds = 120.f;
+
+	/** Covers acquiring a target plus killing it, per kill, in game seconds. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	float KillTimeoutSeconds = 30.f;
+
+	/** QueryBenchmark: synthetic bot counts measured in ascending order, each reported as its own test case. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	TArray<int32> BenchmarkBotCounts = { 1, 10, 50, 100, 200, 500, 1000 };
+
+	/** QueryBenchmark: timed calls per function and bot count. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	int32 BenchmarkIterations = 200;
+
+	/** QueryBenchmark: synthetic bots are spread round-robin over teams 1..BenchmarkTeamCount. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	int32 BenchmarkTeamCount = 2;
+
+	/** When > 0 the run uses the test support subsystem's fast-forward mode with this time dilation. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	float FastForwardTimeDilation = 0.f;
+
+	/** AimShootKill: the kill cases run inside one perf capture, reported as an extra Perf case gated on the scenario's baseline. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	bool bCapturePerf = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	float PerfHitchThresholdMs = 50.f;
+
+	/** Directory of <ScenarioName>.perfbaseline.json; empty uses Build/PerfBaselines. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	FString PerfBaselineDirectory;
+
+	/** Overwrite the baseline with this run's capture; a missing baseline is always written. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	bool bUpdatePerfBaseline = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	FLyraTestPerfGateSettings PerfGate;
+
+	/** Directory for <ScenarioName>.junit.xml / .json (<ScenarioName>.w<WorldId>.* in a PIE instance); empty uses Saved/TestScenarios. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	FString ReportDirectory;
+
+	/** Exit the process when done with code 0 (all passed) or 1; set for command line runs. With several worlds in the process, once every world's scenario is done. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	bool bExitWhenDone = false;
+};
+
+USTRUCT(BlueprintType)
+struct LYRAGAME_API FLyraTestScenarioCaseResult
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	FString Name;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	bool bPassed = false;
+
+	/** Phase the case ended in; for failures, the phase that timed out. */
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	ELyraTestScenarioPhase Phase = ELyraTestScenarioPhase::Idle;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	FString Failure;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	double DurationSeconds = 0.0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	double SimulatedSeconds = 0.0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	int64 Frames = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	int64 TargetId = 0;
+};
+
+/**
+ * Runs the aim-shoot-kill flow inside the game as a per-frame state machine: load map, wait for the
+ * experience and pawn, apply cheats, then acquire, aim at, fire on and confirm the kill of KillCount
+ * targets. Needs no rendering or external driver, so it runs under -nullrhi -unattended. Results are
+ * written as JUnit XML and JSON. Started from the command line with -LyraTestScenario=AimShootKill.
+ * The kills are also a perf datapoint: frame, GC and memory stats over all of them are written to
+ * <ScenarioName>.perf.json and gated on the scenario's baseline as the Perf case.
+ *
+ * The QueryBenchmark scenario shares the load phases, then spawns synthetic bots up to each of
+ * BenchmarkBotCounts and times the query entry points at that count (see LyraTestQueryBenchmark),
+ * additionally writing QueryBenchmarkResults.csv / .json.
+ */
+UCLASS(meta = (DisplayName = "Lyra Test Scenario Runner"))
+class LYRAGAME_API ULyraTestScenarioRunner : public UGameInstanceSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual ETickableTickType GetTickableTickType() const override { return ETickableTickType::Conditional; }
+	virtual TStatId GetStatId() const override;
+
+	/** False if a scenario is already running or the scenario name is unknown. */
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
+	bool StartScenario(const FLyraTestScenarioSettings& InSettings);
+
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
+	bool IsScenarioRunning() const;
+
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
+	TArray<FLyraTestScenarioCaseResult> GetScenarioResults() const { return Results; }
+
+	/** Settings from -LyraTestScenario= (a comma separated list runs entry WorldId % count in each world), -LyraTestScenarioMap=, -LyraTestScenarioExperience=, -LyraTestScenarioKills=, -LyraTestScenarioTimeout=, -LyraTestScenarioReport=, -LyraTestScenarioNoLoad, -LyraTestFastForward=, -LyraTestBenchmarkBots= (comma separated), -LyraTestBenchmarkIterations=, -LyraTestPerfBaseline=, -LyraTestPerfHitchMs=, -LyraTestPerfUpdateBaseline and -LyraTestNoPerf. */
+	static bool ParseCommandLineSettings(const TCHAR* CommandLine, FLyraTestScenarioSettings& OutSettings);
+
+private:
+	void TickLoad(UWorld* World);
+	void TickKill(UWorld* World, APlayerController* PC, ULyraTestSupportSubsystem* Support);
+	void TickBenchmark(UWorld* World, APlayerController* PC, ULyraTestSupportSubsystem* Support);
+
+	void EnterPhase(ELyraTestScenarioPhase NewPhase);
+	void BeginCase(const FString& Name);
+	void EndCase(bool bPassed, const FString& Failure = FString());
+	void BeginNextKillOrFinish();
+	void BeginNextBenchmarkStepOrFinish();
+	bool IsBenchmarkScenario() const;
+	void StopEngaging(ULyraTestSupportSubsystem* Support);
+	void EndPerfCase(ULyraTestSupportSubsystem* Support);
+	void Finish();
+	void WriteReports() const;
+	FString GetReportName() const;
+
+	// Exit-when-done scenarios still running in any world of the process; the last one to finish exits.
+	static int32 PendingExitScenarios;
+	static bool bAnyExitScenarioFailed;
+
+	UPROPERTY(Transient)
+	FLyraTestScenarioSettings Settings;
+
+	UPROPERTY(Transient)
+	TArray<FLyraTestScenarioCaseResult> Results;
+
+	UPROPERTY(Transient)
+	TArray<FLyraTestBenchmarkResult> BenchmarkResults;
+
+	UPROPERTY(Transient)
+	FLyraTestPerfCaptureResult PerfResult;
+
+	TArray<TWeakObjectPtr<ALyraTestBenchmarkCharacter>> BenchmarkBots;
+
+	ELyraTestScenarioPhase Phase = ELyraTestScenarioPhase::Idle;
+	int64 SessionToken = 0;
+	double RunStartTime = 0.0;
+	double CaseStartTime = 0.0;
+	double CaseSimulatedSeconds = 0.0;
+	double RunSimulatedSeconds = 0.0;
+	uint64 CaseStartFrame = 0;
+	int32 KillsAttempted = 0;
+	int64 TargetId = 0;
+	int64 KillSinceSequence = 0;
+	bool bFiring = false;
+	bool bCapturingPerf = false;
+	int32 BenchmarkStep = 0;
+	int64 BenchmarkEventSequence = 0;
+	bool bBenchmarkBotsSpawned = false;
+	bool bPendingExit = false;
+};
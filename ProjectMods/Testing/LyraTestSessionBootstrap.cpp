@@ -0,0 +1,262 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Testing/LyraTestSessionBootstrap.h"
+#include "Testing/LyraTestEventPublisher.h"
+#include "Testing/LyraTestInstanceConfig.h"
+#include "Testing/LyraTestStats.h"
+#include "Testing/LyraTestSupportSubsystem.h"
+#include "AbilitySystem/Phases/LyraGamePhaseSubsystem.h"
+#include "Character/LyraPawnExtensionComponent.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "GameModes/LyraExperienceManagerComponent.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/PackageName.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(LyraTestSessionBootstrap)
+
+static constexpr float WarmupFixedDeltaSeconds = 1.f / 60.f;
+
+void ULyraTestSessionBootstrap::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	Collection.InitializeDependency<ULyraTestSupportSubsystem>();
+	Collection.InitializeDependency<ULyraTestEventPublisher>();
+	LyraTestInstanceConfig::ApplySeed();
+	WorldInitializedActorsHandle = FWorldDelegates::OnWorldInitializedActors.AddUObject(this, &ThisClass::HandleWorldInitializedActors);
+	if (UGameInstance* GI = GetGameInstance())
+	{
+		GI->OnPawnControllerChangedDelegates.AddDynamic(this, &ThisClass::HandlePawnControllerChanged);
+	}
+}
+
+void ULyraTestSessionBootstrap::Deinitialize()
+{
+	FWorldDelegates::OnWorldInitializedActors.Remove(WorldInitializedActorsHandle);
+	WorldInitializedActorsHandle.Reset();
+	if (UGameInstance* GI = GetGameInstance())
+	{
+		GI->OnPawnControllerChangedDelegates.RemoveDynamic(this, &ThisClass::HandlePawnControllerChanged);
+	}
+	SetWarmupFastForward(false);
+	State = ELyraTestSessionState::None;
+	Super::Deinitialize();
+}
+
+bool ULyraTestSessionBootstrap::IsTickable() const
+{
+	return !HasAnyFlags(RF_ClassDefaultObject) && IsSessionInProgress();
+}
+
+TStatId ULyraTestSessionBootstrap::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(ULyraTestSessionBootstrap, STATGROUP_Tickables);
+}
+
+bool ULyraTestSessionBootstrap::IsSessionInProgress() const
+{
+	return State != ELyraTestSessionState::None && State != ELyraTestSessionState::Ready && State != ELyraTestSessionState::Failed;
+}
+
+int64 ULyraTestSessionBootstrap::StartSession(const FLyraTestSessionSettings& InSettings)
+{
+	if (IsSessionInProgress())
+	{
+		SetWarmupFastForward(false);
+	}
+
+	Settings = InSettings;
+	Settings.PlayerIndex = FMath::Max(Settings.PlayerIndex, 0);
+	LyraTestInstanceConfig::ApplySeed();
+	Token = ++LastToken;
+	Failure.Reset();
+	StartTime = FPlatformTime::Seconds();
+	bExperienceLoaded = false;
+	bTravelIssued = false;
+	TravelFromWorld.Reset();
+	ExperienceHookedWorld.Reset();
+	State = Settings.MapName.IsEmpty() ? ELyraTestSessionState::WaitForExperience : ELyraTestSessionState::Traveling;
+	AdvanceSession();
+	return Token;
+}
+
+ELyraTestSessionState ULyraTestSessionBootstrap::GetSessionState(int64 InToken) const
+{
+	return InToken != 0 && InToken == Token ? State : ELyraTestSessionState::None;
+}
+
+FString ULyraTestSessionBootstrap::GetSessionFailure(int64 InToken) const
+{
+	return InToken != 0 && InToken == Token ? Failure : FString();
+}
+
+void ULyraTestSessionBootstrap::Tick(float DeltaTime)
+{
+	LYRA_TEST_SCOPE(Session);
+	if (FPlatformTime::Seconds() - StartTime > Settings.TimeoutSeconds)
+	{
+		FinishSession(ELyraTestSessionState::Failed, FString::Printf(TEXT("Timed out after %.0f s in %s"), Settings.TimeoutSeconds,
+			*StaticEnum<ELyraTestSessionState>()->GetNameStringByValue(static_cast<int64>(State))));
+		return;
+	}
+	AdvanceSession();
+}
+
+void ULyraTestSessionBootstrap::HandleWorldInitializedActors(const FActorsInitializedParams& Params)
+{
+	if (IsSessionInProgress() && Params.World && Params.World->GetGameInstance() == GetGameInstance())
+	{
+		AdvanceSession();
+	}
+}
+
+void ULyraTestSessionBootstrap::HandlePawnControllerChanged(APawn* Pawn, AController* Controller)
+{
+	if (IsSessionInProgress())
+	{
+		AdvanceSession();
+	}
+}
+
+void ULyraTestSessionBootstrap::HandleExperienceLoaded(const ULyraExperienceDefinition* Experience, TWeakObjectPtr<UWorld> World)
+{
+	// Ignore late callbacks from a world hooked by a superseded session.
+	if (World.IsValid() && World == ExperienceHookedWorld)
+	{
+		bExperienceLoaded = true;
+		AdvanceSession();
+	}
+}
+
+void ULyraTestSessionBootstrap::TryHookExperience(UWorld* World)
+{
+	if (!World || ExperienceHookedWorld.Get() == World)
+	{
+		return;
+	}
+	AGameStateBase* GameState = World->GetGameState();
+	ULyraExperienceManagerComponent* ExperienceComponent = GameState ? GameState->FindComponentByClass<ULyraExperienceManagerComponent>() : nullptr;
+	if (!ExperienceComponent)
+	{
+		return;
+	}
+	ExperienceHookedWorld = World;
+	bExperienceLoaded = false;
+	// Fires immediately if the experience is already loaded.
+	ExperienceComponent->CallOrRegister_OnExperienceLoaded_LowPriority(FOnLyraExperienceLoaded::FDelegate::CreateUObject(this, &ThisClass::HandleExperienceLoaded, TWeakObjectPtr<UWorld>(World)));
+}
+
+void ULyraTestSessionBootstrap::AdvanceSession()
+{
+	UGameInstance* GI = GetGameInstance();
+	UWorld* World = GI ? GI->GetWorld() : nullptr;
+	if (!World)
+	{
+		return;
+	}
+
+	if (State == ELyraTestSessionState::Traveling)
+	{
+		if (!bTravelIssued)
+		{
+			// The old world may be collected before the new one is up, so the issued flag is kept separately.
+			bTravelIssued = true;
+			TravelFromWorld = World;
+			FString Options = Settings.Experience.IsEmpty() ? FString() : FString::Printf(TEXT("Experience=%s"), *Settings.Experience);
+			if (Settings.BotCount >= 0)
+			{
+				Options += FString::Printf(TEXT("%sNumBots=%d"), Options.IsEmpty() ? TEXT("") : TEXT("?"), Settings.BotCount);
+			}
+			UGameplayStatics::OpenLevel(World, FName(*Settings.MapName), true, Options);
+			return;
+		}
+		if (World == TravelFromWorld.Get() || World->GetMapName() != FPackageName::GetShortName(Settings.MapName))
+		{
+			return;
+		}
+		State = ELyraTestSessionState::WaitForExperience;
+	}
+
+	if (State == ELyraTestSessionState::WaitForExperience)
+	{
+		TryHookExperience(World);
+		if (!bExperienceLoaded || ExperienceHookedWorld.Get() != World)
+		{
+			return;
+		}
+		State = ELyraTestSessionState::WaitForPawn;
+	}
+
+	ULyraTestSupportSubsystem* Support = GI->GetSubsystem<ULyraTestSupportSubsystem>();
+	if (State == ELyraTestSessionState::WaitForPawn)
+	{
+		// Cheats and fire input go through the ability system, so wait for it rather than just possession.
+		const APlayerController* PC = Support ? Support->GetLocalPlayerController(Settings.PlayerIndex) : nullptr;
+		const ULyraPawnExtensionComponent* PawnExt = PC ? ULyraPawnExtensionComponent::FindPawnExtensionComponent(PC->GetPawn()) : nullptr;
+		if (!PawnExt || !PawnExt->GetLyraAbilitySystemComponent())
+		{
+			return;
+		}
+		if (Settings.bApplyCheats)
+		{
+			Support->SetPlayerInvincible(Settings.PlayerIndex, true);
+			Support->SetPlayerInfiniteAmmo(Settings.PlayerIndex, true);
+		}
+		State = ELyraTestSessionState::WaitForWarmup;
+	}
+
+	if (State == ELyraTestSessionState::WaitForWarmup)
+	{
+		const FGameplayTag WarmupTag = FGameplayTag::RequestGameplayTag(FName(*Settings.WarmupPhaseTag), false);
+		const ULyraGamePhaseSubsystem* PhaseSubsystem = World->GetSubsystem<ULyraGamePhaseSubsystem>();
+		if (WarmupTag.IsValid() && PhaseSubsystem && PhaseSubsystem->IsPhaseActive(WarmupTag))
+		{
+			// Without bSkipWarmup the warm-up simply runs out in real time.
+			if (Settings.bSkipWarmup)
+			{
+				SetWarmupFastForward(true);
+			}
+			return;
+		}
+		FinishSession(ELyraTestSessionState::Ready);
+	}
+}
+
+void ULyraTestSessionBootstrap::FinishSession(ELyraTestSessionState FinalState, const FString& InFailure)
+{
+	SetWarmupFastForward(false);
+	State = FinalState;
+	Failure = InFailure;
+	if (FinalState == ELyraTestSessionState::Ready)
+	{
+		if (ULyraTestEventPublisher* Publisher = GetGameInstance()->GetSubsystem<ULyraTestEventPublisher>())
+		{
+			const APlayerController* PC = ULyraTestSupportSubsystem::FindLocalPlayerController(GetGameInstance(), Settings.PlayerIndex);
+			Publisher->Publish(ELyraTestEventType::SessionReady, PC ? PC->GetPawn() : nullptr, PC, static_cast<float>(Token));
+		}
+	}
+}
+
+void ULyraTestSessionBootstrap::SetWarmupFastForward(bool bEnable)
+{
+	if (bEnable == bWarmupFastForward)
+	{
+		return;
+	}
+	ULyraTestSupportSubsystem* Support = GetGameInstance() ? GetGameInstance()->GetSubsystem<ULyraTestSupportSubsystem>() : nullptr;
+	if (!Support)
+	{
+		bWarmupFastForward = false;
+		return;
+	}
+	// A caller that already runs in fast-forward (e.g. the scenario runner) keeps its own settings.
+	if (bEnable && Support->IsFastForwardEnabled())
+	{
+		return;
+	}
+	Support->SetFastForwardEnabled(bEnable, WarmupFixedDeltaSeconds, Settings.WarmupTimeDilation);
+	bWarmupFastForward = bEnable;
+}
@@ -0,0 +1,127 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Tickable.h"
+#include "LyraTestSessionBootstrap.generated.h"
+
+class AController;
+class APawn;
+class ULyraExperienceDefinition;
+class UWorld;
+struct FActorsInitializedParams;
+
+UENUM(BlueprintType)
+enum class ELyraTestSessionState : uint8
+{
+	None,
+	Traveling,
+	WaitForExperience,
+	WaitForPawn,
+	WaitForWarmup,
+	Ready,
+	Failed
+};
+
+USTRUCT(BlueprintType)
+struct LYRAGAME_API FLyraTestSessionSettings
+{
+	GENERATED_BODY()
+
+	/** Map to travel to; empty stays on the current map. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	FString MapName;
+
+	/** Passed as the Experience URL option; empty uses the map's default experience. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	FString Experience;
+
+	/** Passed as the NumBots URL option; -1 keeps the experience's bot count. Only applies when MapName is set. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	int32 BotCount = -1;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	int32 PlayerIndex = 0;
+
+	/** Turn on invincibility and infinite ammo once the pawn's ability system is up. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	bool bApplyCheats = true;
+
+	/** Fast-forward game time while WarmupPhaseTag is active instead of waiting out the countdown. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	bool bSkipWarmup = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	FString WarmupPhaseTag = TEXT("ShooterGame.GamePhase.Warmup");
+
+	/** Requested time dilation while skipping warm-up; clamped by the world settings. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	float WarmupTimeDilation = 20.f;
+
+	/** Real seconds from start to ready before the session is marked failed. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	float TimeoutSeconds = 120.f;
+};
+
+/**
+ * Gets a test into gameplay without the front-end: travels to a map + experience, then becomes ready
+ * once the experience-loaded callback has fired, the local pawn is possessed with its ability system,
+ * cheats are applied and warm-up is over. Each start returns a token; readiness is reported through
+ * GetSessionState and a SessionReady event (Value = token) on the test event stream. The global random
+ * streams are reseeded at every start when the instance configuration has a seed.
+ */
+UCLASS(meta = (DisplayName = "Lyra Test Session Bootstrap"))
+class LYRAGAME_API ULyraTestSessionBootstrap : public UGameInstanceSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual ETickableTickType GetTickableTickType() const override { return ETickableTickType::Conditional; }
+	virtual TStatId GetStatId() const override;
+
+	/** Starts a new session, superseding any session still in progress; returns its token. */
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
+	int64 StartSession(const FLyraTestSessionSettings& InSettings);
+
+	/** State of the session started with Token; None for unknown or superseded tokens. */
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
+	ELyraTestSessionState GetSessionState(int64 Token) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
+	FString GetSessionFailure(int64 Token) const;
+
+	bool IsSessionInProgress() const;
+
+private:
+	void HandleWorldInitializedActors(const FActorsInitializedParams& Params);
+	void HandleExperienceLoaded(const ULyraExperienceDefinition* Experience, TWeakObjectPtr<UWorld> World);
+
+	UFUNCTION()
+	void HandlePawnControllerChanged(APawn* Pawn, AController* Controller);
+
+	void TryHookExperience(UWorld* World);
+	void AdvanceSession();
+	void FinishSession(ELyraTestSessionState FinalState, const FString& Failure = FString());
+	void SetWarmupFastForward(bool bEnable);
+
+	UPROPERTY(Transient)
+	FLyraTestSessionSettings Settings;
+
+	ELyraTestSessionState State = ELyraTestSessionState::None;
+	int64 Token = 0;
+	int64 LastToken = 0;
+	FString Failure;
+	double StartTime = 0.0;
+	TWeakObjectPtr<UWorld> TravelFromWorld;
+	TWeakObjectPtr<UWorld> ExperienceHookedWorld;
+	bool bTravelIssued = false;
+	bool bExperienceLoaded = false;
+	bool bWarmupFastForward = false;
+	FDelegateHandle WorldInitializedActorsHandle;
+};
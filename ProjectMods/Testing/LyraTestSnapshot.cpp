@@ -0,0 +1,60 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Testing/LyraTestSnapshot.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(LyraTestSnapshot)
+
+static_assert(PLATFORM_LITTLE_ENDIAN, "LyraTestSnapshot wire format is written little endian.");
+
+template <typename T>
+static FORCEINLINE void WriteSnapshotValue(uint8* Dest, int32 Offset, T Value)
+{
+	FMemory::Memcpy(Dest + Offset, &Value, sizeof(T));
+}
+
+void FLyraTestSnapshot::Reset()
+{
+	Version = LyraTestSnapshot::Version;
+	FrameNumber = 0;
+	WorldTimeSeconds = 0.0;
+	Records.Reset();
+}
+
+const FLyraTestSnapshotRecord* FLyraTestSnapshot::FindPlayerRecord() const
+{
+	return Records.FindByPredicate([](const FLyraTestSnapshotRecord& Record) { return Record.Kind == ELyraTestSnapshotRecordKind::Player; });
+}
+
+void FLyraTestSnapshot::SerializeToBytes(TArray<uint8>& OutBytes) const
+{
+	using namespace LyraTestSnapshot;
+
+	OutBytes.Reset();
+	OutBytes.AddZeroed(HeaderSize + Records.Num() * RecordStride);
+	uint8* Data = OutBytes.GetData();
+
+	WriteSnapshotValue<uint32>(Data, 0, Magic);
+	WriteSnapshotValue<uint16>(Data, 4, Version);
+	WriteSnapshotValue<uint16>(Data, 6, static_cast<uint16>(RecordStride));
+	WriteSnapshotValue<uint32>(Data, 8, static_cast<uint32>(Records.Num()));
+	WriteSnapshotValue<uint64>(Data, 16, static_cast<uint64>(FrameNumber));
+	WriteSnapshotValue<double>(Data, 24, WorldTimeSeconds);
+
+	uint8* RecordData = Data + HeaderSize;
+	for (const FLyraTestSnapshotRecord& Record : Records)
+	{
+		WriteSnapshotValue<int64>(RecordData, 0, Record.Id);
+		WriteSnapshotValue<int32>(RecordData, 8, Record.TeamId);
+		WriteSnapshotValue<uint8>(RecordData, 12, static_cast<uint8>(Record.Kind));
+		WriteSnapshotValue<uint8>(RecordData, 13, (Record.bAlive ? RecordFlag_Alive : 0) | (Record.bStale ? RecordFlag_Stale : 0));
+		WriteSnapshotValue<double>(RecordData, 16, Record.Position.X);
+		WriteSnapshotValue<double>(RecordData, 24, Record.Position.Y);
+		WriteSnapshotValue<double>(RecordData, 32, Record.Position.Z);
+		WriteSnapshotValue<float>(RecordData, 40, static_cast<float>(Record.Velocity.X));
+		WriteSnapshotValue<float>(RecordData, 44, static_cast<float>(Record.Velocity.Y));
+		WriteSnapshotValue<float>(RecordData, 48, static_cast<float>(Record.Velocity.Z));
+		WriteSnapshotValue<float>(RecordData, 52, Record.Health);
+		WriteSnapshotValue<float>(RecordData, 56, Record.MaxHealth);
+		RecordData += RecordStride;
+	}
+}
@@ -0,0 +1,91 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LyraTestSnapshot.generated.h"
+
+class AActor;
+
+UENUM(BlueprintType)
+enum class ELyraTestSnapshotRecordKind : uint8
+{
+	Player,
+	Enemy
+};
+
+USTRUCT(BlueprintType)
+struct LYRAGAME_API FLyraTestSnapshotRecord
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	int64 Id = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	int32 TeamId = INDEX_NONE;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	ELyraTestSnapshotRecordKind Kind = ELyraTestSnapshotRecordKind::Enemy;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	FVector Position = FVector::ZeroVector;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	FVector Velocity = FVector::ZeroVector;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	float Health = 0.f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	float MaxHealth = 0.f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	bool bAlive = false;
+
+	/** Requested by handle whose object has since been destroyed. */
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	bool bStale = false;
+
+	/** Native callers only; not part of the wire format. */
+	TWeakObjectPtr<AActor> Actor;
+};
+
+// Packed wire layout (little endian), see LyraTestSnapshot::HeaderSize / RecordStride:
+//   Header  [0]  uint32 Magic 'LTSN'  [4] uint16 Version  [6] uint16 RecordStride  [8] uint32 RecordCount
+//           [12] uint32 Reserved      [16] uint64 FrameNumber  [24] double WorldTimeSeconds
+//   Record  [0]  int64 Id  [8] int32 TeamId  [12] uint8 Kind  [13] uint8 Flags (bit0 = alive, bit1 = stale)  [14] uint16 Reserved
+//           [16] double Position[3]  [40] float Velocity[3]  [52] float Health  [56] float MaxHealth  [60] uint32 Reserved
+USTRUCT(BlueprintType)
+struct LYRAGAME_API FLyraTestSnapshot
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	int32 Version = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	int64 FrameNumber = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	double WorldTimeSeconds = 0.0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	TArray<FLyraTestSnapshotRecord> Records;
+
+	void Reset();
+
+	const FLyraTestSnapshotRecord* FindPlayerRecord() const;
+
+	void SerializeToBytes(TArray<uint8>& OutBytes) const;
+};
+
+namespace LyraTestSnapshot
+{
+	static constexpr uint32 Magic = 0x4E53544C; // "LTSN"
+	static constexpr uint16 Version = 1;
+	static constexpr int32 HeaderSize = 32;
+	static constexpr int32 RecordStride = 64;
+	static constexpr uint8 RecordFlag_Alive = 1 << 0;
+	static constexpr uint8 RecordFlag_Stale = 1 << 1;
+}
@@ -0,0 +1,103 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Testing/LyraTestSpatialGrid.h"
+#include "Algo/Sort.h"
+
+FLyraTestSpatialGrid::FLyraTestSpatialGrid(float InCellSize)
+	: CellSize(FMath::Max(InCellSize, 1.f))
+{
+}
+
+void FLyraTestSpatialGrid::Reset()
+{
+	Positions.Reset();
+	PointCells.Reset();
+	Cells.Reset();
+	MinOccupiedCell = FIntPoint::ZeroValue;
+	MaxOccupiedCell = FIntPoint::ZeroValue;
+}
+
+FIntPoint FLyraTestSpatialGrid::GetCell(const FVector& Position) const
+{
+	return FIntPoint(FMath::FloorToInt32(Position.X / CellSize), FMath::FloorToInt32(Position.Y / CellSize));
+}
+
+void FLyraTestSpatialGrid::AddToCell(const FIntPoint& Cell, int32 Index)
+{
+	if (Cells.Num() == 0)
+	{
+		MinOccupiedCell = Cell;
+		MaxOccupiedCell = Cell;
+	}
+	else
+	{
+		MinOccupiedCell = FIntPoint(FMath::Min(MinOccupiedCell.X, Cell.X), FMath::Min(MinOccupiedCell.Y, Cell.Y));
+		MaxOccupiedCell = FIntPoint(FMath::Max(MaxOccupiedCell.X, Cell.X), FMath::Max(MaxOccupiedCell.Y, Cell.Y));
+	}
+	Cells.FindOrAdd(Cell).Add(Index);
+}
+
+void FLyraTestSpatialGrid::RemoveFromCell(const FIntPoint& Cell, int32 Index)
+{
+	if (TArray<int32>* CellIndices = Cells.Find(Cell))
+	{
+		CellIndices->RemoveSingleSwap(Index, false);
+		if (CellIndices->Num() == 0)
+		{
+			Cells.Remove(Cell);
+		}
+	}
+}
+
+void FLyraTestSpatialGrid::Add(const FVector& Position)
+{
+	const FIntPoint Cell = GetCell(Position);
+	AddToCell(Cell, Positions.Num());
+	Positions.Add(Position);
+	PointCells.Add(Cell);
+}
+
+void FLyraTestSpatialGrid::Move(int32 Index, const FVector& Position)
+{
+	Positions[Index] = Position;
+	const FIntPoint Cell = GetCell(Position);
+	if (Cell != PointCells[Index])
+	{
+		RemoveFromCell(PointCells[Index], Index);
+		AddToCell(Cell, Index);
+		PointCells[Index] = Cell;
+	}
+}
+
+void FLyraTestSpatialGrid::RemoveAtSwap(int32 Index)
+{
+	RemoveFromCell(PointCells[Index], Index);
+	const int32 LastIndex = Positions.Num() - 1;
+	if (Index != LastIndex)
+	{
+		// Relabel the last point, which takes over the removed slot.
+		if (TArray<int32>* CellIndices = Cells.Find(PointCells[LastIndex]))
+		{
+			if (int32* Entry = CellIndices->FindByKey(LastIndex))
+			{
+				*Entry = Index;
+			}
+		}
+	}
+	Positions.RemoveAtSwap(Index, 1, false);
+	PointCells.RemoveAtSwap(Index, 1, false);
+	if (Positions.Num() == 0)
+	{
+		Reset();
+	}
+}
+
+void FLyraTestSpatialGrid::SortCandidates(TArrayView<FCandidate> Candidates, TArray<int32>& OutIndices)
+{
+	Algo::SortBy(Candidates, &FCandidate::DistanceSq);
+	OutIndices.Reset(Candidates.Num());
+	for (const FCandidate& Candidate : Candidates)
+	{
+		OutIndices.Add(Candidate.Index);
+	}
+}
@@ -0,0 +1,185 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Uniform 2D (XY) hash grid over a dense, swap-removed array of points, mirroring the enemy registry's
+ * alive arrays index for index. Moving a point only touches the grid when it crosses a cell boundary.
+ * Distances are full 3D; the grid only bounds which cells are visited.
+ */
+class LYRAGAME_API FLyraTestSpatialGrid
+{
+public:
+	explicit FLyraTestSpatialGrid(float InCellSize = 1000.f);
+
+	void Reset();
+
+	int32 Num() const { return Positions.Num(); }
+	const FVector& GetPosition(int32 Index) const { return Positions[Index]; }
+
+	/** Appends a point; its index is the previous Num(). */
+	void Add(const FVector& Position);
+
+	void Move(int32 Index, const FVector& Position);
+
+	/** Removes Index and moves the last point into its slot, like TArray::RemoveAtSwap. */
+	void RemoveAtSwap(int32 Index);
+
+	/**
+	 * Up to Count indices passing Filter(Index), nearest to Point first, within MaxDistance (<= 0: unbounded).
+	 * Searches rings of cells outward and stops once no closer point can exist.
+	 */
+	template <typename FilterType>
+	void FindNearest(const FVector& Point, int32 Count, float MaxDistance, FilterType&& Filter, TArray<int32>& OutIndices) const;
+
+	/** Indices passing Filter(Index) within Radius of Point, nearest first. */
+	template <typename FilterType>
+	void FindInRadius(const FVector& Point, float Radius, FilterType&& Filter, TArray<int32>& OutIndices) const;
+
+private:
+	struct FCandidate
+	{
+		double DistanceSq;
+		int32 Index;
+	};
+
+	FIntPoint GetCell(const FVector& Position) const;
+	void AddToCell(const FIntPoint& Cell, int32 Index);
+	void RemoveFromCell(const FIntPoint& Cell, int32 Index);
+
+	/** Calls Visit(const TArray<int32>& CellIndices) for each occupied cell in the inclusive cell rectangle. */
+	template <typename VisitType>
+	void ForEachCellInRect(const FIntPoint& MinCell, const FIntPoint& MaxCell, VisitType&& Visit) const;
+
+	static void SortCandidates(TArrayView<FCandidate> Candidates, TArray<int32>& OutIndices);
+
+	float CellSize;
+	TArray<FVector> Positions;
+	TArray<FIntPoint> PointCells;
+	TMap<FIntPoint, TArray<int32>> Cells;
+
+	// Grown as points are added, reset when the grid empties; bounds ring searches.
+	FIntPoint MinOccupiedCell = FIntPoint::ZeroValue;
+	FIntPoint MaxOccupiedCell = FIntPoint::ZeroValue;
+};
+
+template <typename VisitType>
+void FLyraTestSpatialGrid::ForEachCellInRect(const FIntPoint& MinCell, const FIntPoint& MaxCell, VisitType&& Visit) const
+{
+	const FIntPoint ClampedMin(FMath::Max(MinCell.X, MinOccupiedCell.X), FMath::Max(MinCell.Y, MinOccupiedCell.Y));
+	const FIntPoint ClampedMax(FMath::Min(MaxCell.X, MaxOccupiedCell.X), FMath::Min(MaxCell.Y, MaxOccupiedCell.Y));
+	if (ClampedMin.X > ClampedMax.X || ClampedMin.Y > ClampedMax.Y)
+	{
+		return;
+	}
+
+	// Sparse grids: walking the occupied cells is cheaper than probing every cell of a large rectangle.
+	const int64 RectCells = static_cast<int64>(ClampedMax.X - ClampedMin.X + 1) * (ClampedMax.Y - ClampedMin.Y + 1);
+	if (RectCells > Cells.Num())
+	{
+		for (const TPair<FIntPoint, TArray<int32>>& Pair : Cells)
+		{
+			if (Pair.Key.X >= ClampedMin.X && Pair.Key.X <= ClampedMax.X && Pair.Key.Y >= ClampedMin.Y && Pair.Key.Y <= ClampedMax.Y)
+			{
+				Visit(Pair.Value);
+			}
+		}
+		return;
+	}
+	for (int32 Y = ClampedMin.Y; Y <= ClampedMax.Y; ++Y)
+	{
+		for (int32 X = ClampedMin.X; X <= ClampedMax.X; ++X)
+		{
+			if (const TArray<int32>* CellIndices = Cells.Find(FIntPoint(X, Y)))
+			{
+				Visit(*CellIndices);
+			}
+		}
+	}
+}
+
+template <typename FilterType>
+void FLyraTestSpatialGrid::FindNearest(const FVector& Point, int32 Count, float MaxDistance, FilterType&& Filter, TArray<int32>& OutIndices) const
+{
+	OutIndices.Reset();
+	if (Count <= 0 || Positions.Num() == 0)
+	{
+		return;
+	}
+
+	const double MaxDistanceSq = MaxDistance > 0.f ? FMath::Square(static_cast<double>(MaxDistance)) : TNumericLimits<double>::Max();
+	const FIntPoint Center = GetCell(Point);
+	const int32 MaxRing = FMath::Max(
+		FMath::Max(FMath::Abs(Center.X - MinOccupiedCell.X), FMath::Abs(MaxOccupiedCell.X - Center.X)),
+		FMath::Max(FMath::Abs(Center.Y - MinOccupiedCell.Y), FMath::Abs(MaxOccupiedCell.Y - Center.Y)));
+
+	// Max-heap on distance holding the best Count so far.
+	TArray<FCandidate, TInlineAllocator<16>> Best;
+	auto FurtherFirst = [](const FCandidate& A, const FCandidate& B) { return A.DistanceSq > B.DistanceSq; };
+	auto VisitCell = [&](const TArray<int32>& CellIndices)
+	{
+		for (int32 Index : CellIndices)
+		{
+			const double DistanceSq = FVector::DistSquared(Positions[Index], Point);
+			if (DistanceSq > MaxDistanceSq || (Best.Num() == Count && DistanceSq >= Best.HeapTop().DistanceSq) || !Filter(Index))
+			{
+				continue;
+			}
+			if (Best.Num() == Count)
+			{
+				Best.HeapPopDiscard(FurtherFirst, false);
+			}
+			Best.HeapPush({ DistanceSq, Index }, FurtherFirst);
+		}
+	};
+
+	for (int32 Ring = 0; Ring <= MaxRing; ++Ring)
+	{
+		// Every cell in this ring is at least (Ring - 1) cells away from Point in XY.
+		const double RingDistance = FMath::Max(Ring - 1, 0) * static_cast<double>(CellSize);
+		const double RingDistanceSq = RingDistance * RingDistance;
+		if (RingDistanceSq > MaxDistanceSq || (Best.Num() == Count && RingDistanceSq >= Best.HeapTop().DistanceSq))
+		{
+			break;
+		}
+		if (Ring == 0)
+		{
+			ForEachCellInRect(Center, Center, VisitCell);
+			continue;
+		}
+		// Top and bottom rows, then the left and right columns without their corners.
+		ForEachCellInRect(FIntPoint(Center.X - Ring, Center.Y - Ring), FIntPoint(Center.X + Ring, Center.Y - Ring), VisitCell);
+		ForEachCellInRect(FIntPoint(Center.X - Ring, Center.Y + Ring), FIntPoint(Center.X + Ring, Center.Y + Ring), VisitCell);
+		ForEachCellInRect(FIntPoint(Center.X - Ring, Center.Y - Ring + 1), FIntPoint(Center.X - Ring, Center.Y + Ring - 1), VisitCell);
+		ForEachCellInRect(FIntPoint(Center.X + Ring, Center.Y - Ring + 1), FIntPoint(Center.X + Ring, Center.Y + Ring - 1), VisitCell);
+	}
+
+	SortCandidates(Best, OutIndices);
+}
+
+template <typename FilterType>
+void FLyraTestSpatialGrid::FindInRadius(const FVector& Point, float Radius, FilterType&& Filter, TArray<int32>& OutIndices) const
+{
+	OutIndices.Reset();
+	if (Radius <= 0.f || Positions.Num() == 0)
+	{
+		return;
+	}
+
+	const double RadiusSq = FMath::Square(static_cast<double>(Radius));
+	TArray<FCandidate> Found;
+	ForEachCellInRect(GetCell(Point - FVector(Radius)), GetCell(Point + FVector(Radius)), [&](const TArray<int32>& CellIndices)
+	{
+		for (int32 Index : CellIndices)
+		{
+			const double DistanceSq = FVector::DistSquared(Positions[Index], Point);
+			if (DistanceSq <= RadiusSq && Filter(Index))
+			{
+				Found.Add({ DistanceSq, Index });
+			}
+		}
+	});
+	SortCandidates(Found, OutIndices);
+}
@@ -0,0 +1,96 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Testing/LyraTestSpatialGrid.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+static FString JoinGridIndices(const TArray<int32>& Indices)
+{
+	return FString::JoinBy(Indices, TEXT(","), [](int32 Index) { return FString::FromInt(Index); });
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLyraTestSpatialGridNearestTest, "LyraGame.Testing.SpatialGrid.FindNearest",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FLyraTestSpatialGridNearestTest::RunTest(const FString& Parameters)
+{
+	auto All = [](int32) { return true; };
+	TArray<int32> Found;
+
+	FLyraTestSpatialGrid Grid(100.f);
+	Grid.FindNearest(FVector::ZeroVector, 1, 0.f, All, Found);
+	TestEqual(TEXT("Empty grid finds nothing"), Found.Num(), 0);
+
+	Grid.Add(FVector(100.0, 99.0, 0.0));	// 0, cell (1, 0)
+	Grid.Add(FVector(201.0, 50.0, 0.0));	// 1, cell (2, 0)
+	Grid.Add(FVector(1000.0, 1000.0, 0.0));	// 2, cell (10, 10)
+	Grid.Add(FVector(-150.0, 50.0, 0.0));	// 3, cell (-2, 0)
+
+	// The query's own cell holds a point, but the nearest one is across the boundary in ring 1.
+	const FVector Query(199.0, 50.0, 0.0);
+	Grid.FindNearest(Query, 1, 0.f, All, Found);
+	TestEqual(TEXT("Nearest is in the neighbouring cell"), JoinGridIndices(Found), FString(TEXT("1")));
+	Grid.FindNearest(Query, 2, 0.f, All, Found);
+	TestEqual(TEXT("Two nearest, nearest first"), JoinGridIndices(Found), FString(TEXT("1,0")));
+	Grid.FindNearest(Query, 10, 0.f, All, Found);
+	TestEqual(TEXT("Count above Num returns every point"), JoinGridIndices(Found), FString(TEXT("1,0,3,2")));
+	Grid.FindNearest(Query, 10, 150.f, All, Found);
+	TestEqual(TEXT("MaxDistance bounds the search"), JoinGridIndices(Found), FString(TEXT("1,0")));
+	Grid.FindNearest(Query, 1, 0.f, [](int32 Index) { return Index != 1; }, Found);
+	TestEqual(TEXT("Filter skips the nearest"), JoinGridIndices(Found), FString(TEXT("0")));
+
+	// From an empty cell the first hit (ring 1, point 3) is not the nearest (ring 2, point 0).
+	Grid.FindNearest(FVector(-1.0, 50.0, 0.0), 1, 0.f, All, Found);
+	TestEqual(TEXT("Search continues past the first ring with a hit"), JoinGridIndices(Found), FString(TEXT("0")));
+
+	// Distances are 3D even though cells are 2D.
+	Grid.Move(1, FVector(201.0, 50.0, 500.0));
+	Grid.FindNearest(Query, 1, 0.f, All, Found);
+	TestEqual(TEXT("Height counts toward distance"), JoinGridIndices(Found), FString(TEXT("0")));
+
+	// The last point takes over a removed slot.
+	Grid.RemoveAtSwap(1);
+	TestEqual(TEXT("RemoveAtSwap shrinks the grid"), Grid.Num(), 3);
+	Grid.FindNearest(FVector(-150.0, 50.0, 0.0), 1, 0.f, All, Found);
+	TestEqual(TEXT("Moved point is found under its new index"), JoinGridIndices(Found), FString(TEXT("1")));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLyraTestSpatialGridRadiusTest, "LyraGame.Testing.SpatialGrid.FindInRadius",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FLyraTestSpatialGridRadiusTest::RunTest(const FString& Parameters)
+{
+	auto All = [](int32) { return true; };
+	TArray<int32> Found;
+
+	// Points either side of the x = 0 and x = 100 cell boundaries.
+	FLyraTestSpatialGrid Grid(100.f);
+	Grid.Add(FVector(99.9, 0.0, 0.0));	// 0, cell (0, 0)
+	Grid.Add(FVector(100.0, 0.0, 0.0));	// 1, cell (1, 0)
+	Grid.Add(FVector(-0.1, 0.0, 0.0));	// 2, cell (-1, 0)
+	Grid.Add(FVector(200.0, 0.0, 0.0));	// 3, cell (2, 0)
+
+	Grid.FindInRadius(FVector(100.0, 0.0, 0.0), 100.f, All, Found);
+	TestEqual(TEXT("Radius is inclusive and spans cells"), JoinGridIndices(Found), FString(TEXT("1,0,3")));
+	Grid.FindInRadius(FVector(-50.0, 0.0, 0.0), 50.f, All, Found);
+	TestEqual(TEXT("Negative cells floor toward -inf"), JoinGridIndices(Found), FString(TEXT("2")));
+	Grid.FindInRadius(FVector(-0.1, 150.0, 0.0), 150.f, All, Found);
+	TestEqual(TEXT("Query in an empty cell reaches the row below"), JoinGridIndices(Found), FString(TEXT("2")));
+	Grid.FindInRadius(FVector(100.0, 0.0, 0.0), 100.f, [](int32 Index) { return Index != 1; }, Found);
+	TestEqual(TEXT("Filter applies"), JoinGridIndices(Found), FString(TEXT("0,3")));
+	Grid.FindInRadius(FVector(100.0, 0.0, 0.0), 0.f, All, Found);
+	TestEqual(TEXT("Zero radius finds nothing"), Found.Num(), 0);
+
+	// Moving across a boundary re-buckets the point.
+	Grid.Move(0, FVector(450.0, 0.0, 0.0));
+	Grid.FindInRadius(FVector(400.0, 0.0, 0.0), 60.f, All, Found);
+	TestEqual(TEXT("Moved point is found in its new cell"), JoinGridIndices(Found), FString(TEXT("0")));
+	Grid.FindInRadius(FVector(99.9, 0.0, 0.0), 0.05f, All, Found);
+	TestEqual(TEXT("Moved point left its old cell"), Found.Num(), 0);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,160 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Testing/LyraTestStats.h"
+#include "HAL/MemoryBase.h"
+#include <atomic>
+
+#define LYRA_TEST_STAT_DEFINE(Name) DEFINE_STAT(STAT_LyraTest_##Name);
+LYRA_TEST_STAT_SCOPES(LYRA_TEST_STAT_DEFINE)
+#undef LYRA_TEST_STAT_DEFINE
+
+namespace LyraTestStats
+{
+	static const TCHAR* ScopeNames[] = {
+#define LYRA_TEST_STAT_NAME(Name) TEXT(#Name),
+		LYRA_TEST_STAT_SCOPES(LYRA_TEST_STAT_NAME)
+#undef LYRA_TEST_STAT_NAME
+	};
+	static_assert(UE_ARRAY_COUNT(ScopeNames) == static_cast<int32>(ELyraTestStatScope::Count), "Scope name table out of sync");
+
+	// Relaxed atomics: scopes are mostly entered on the game thread, but nothing stops other threads from recording or reading.
+	struct FScopeCounters
+	{
+		std::atomic<uint64> Calls{0};
+		std::atomic<uint64> TotalCycles{0};
+		std::atomic<uint64> MaxCycles{0};
+		std::atomic<uint64> Allocs{0};
+		std::atomic<uint64> Histogram[NumLatencyBuckets] = {};
+	};
+
+	static FScopeCounters Counters[static_cast<int32>(ELyraTestStatScope::Count)];
+	static std::atomic<uint64> OutermostCycles{0};
+	static std::atomic<uint64> ResetFrame{0};
+	static std::atomic<double> ResetSeconds{FPlatformTime::Seconds()};
+	static thread_local int32 ScopeDepth = 0;
+	static thread_local ELyraTestStatScope CurrentScope = ELyraTestStatScope::Count;
+
+	uint64 GetAllocationCount()
+	{
+#if !UE_BUILD_SHIPPING
+		// Process wide, so allocations made by other threads during a scope are attributed to it as well.
+		return static_cast<uint64>(FMalloc::TotalMallocCalls) + static_cast<uint64>(FMalloc::TotalReallocCalls);
+#else
+		return 0;
+#endif
+	}
+
+	static int32 GetLatencyBucket(double Microseconds)
+	{
+		if (Microseconds < 1.0)
+		{
+			return 0;
+		}
+		return FMath::Min(FMath::FloorToInt32(FMath::Log2(Microseconds)) + 1, NumLatencyBuckets - 1);
+	}
+
+	static double GetBucketUpperMicroseconds(int32 Bucket)
+	{
+		return static_cast<double>(1ull << Bucket);
+	}
+
+	static double GetPercentileMicroseconds(const FScopeCounters& Scope, uint64 Calls, double Percentile, double MaxMicroseconds)
+	{
+		const uint64 Rank = FMath::Max<uint64>(1, static_cast<uint64>(FMath::CeilToDouble(Calls * Percentile)));
+		uint64 Seen = 0;
+		for (int32 Bucket = 0; Bucket < NumLatencyBuckets - 1; ++Bucket)
+		{
+			Seen += Scope.Histogram[Bucket].load(std::memory_order_relaxed);
+			if (Seen >= Rank)
+			{
+				return FMath::Min(GetBucketUpperMicroseconds(Bucket), MaxMicroseconds);
+			}
+		}
+		return MaxMicroseconds;
+	}
+
+	static void Record(ELyraTestStatScope Scope, uint64 Cycles, uint64 Allocs, bool bOutermost)
+	{
+		FScopeCounters& Entry = Counters[static_cast<int32>(Scope)];
+		Entry.Calls.fetch_add(1, std::memory_order_relaxed);
+		Entry.TotalCycles.fetch_add(Cycles, std::memory_order_relaxed);
+		Entry.Allocs.fetch_add(Allocs, std::memory_order_relaxed);
+		uint64 PrevMax = Entry.MaxCycles.load(std::memory_order_relaxed);
+		while (Cycles > PrevMax && !Entry.MaxCycles.compare_exchange_weak(PrevMax, Cycles, std::memory_order_relaxed))
+		{
+		}
+		const double Microseconds = FPlatformTime::ToSeconds64(Cycles) * 1e6;
+		Entry.Histogram[GetLatencyBucket(Microseconds)].fetch_add(1, std::memory_order_relaxed);
+		if (bOutermost)
+		{
+			OutermostCycles.fetch_add(Cycles, std::memory_order_relaxed);
+		}
+	}
+
+	void Reset()
+	{
+		for (FScopeCounters& Entry : Counters)
+		{
+			Entry.Calls.store(0, std::memory_order_relaxed);
+			Entry.TotalCycles.store(0, std::memory_order_relaxed);
+			Entry.MaxCycles.store(0, std::memory_order_relaxed);
+			Entry.Allocs.store(0, std::memory_order_relaxed);
+			for (std::atomic<uint64>& Bucket : Entry.Histogram)
+			{
+				Bucket.store(0, std::memory_order_relaxed);
+			}
+		}
+		OutermostCycles.store(0, std::memory_order_relaxed);
+		ResetFrame.store(GFrameCounter, std::memory_order_relaxed);
+		ResetSeconds.store(FPlatformTime::Seconds(), std::memory_order_relaxed);
+	}
+
+	FString BuildSummary()
+	{
+		const uint64 Frames = FMath::Max<uint64>(GFrameCounter - ResetFrame.load(std::memory_order_relaxed), 1);
+		const double WallMs = (FPlatformTime::Seconds() - ResetSeconds.load(std::memory_order_relaxed)) * 1000.0;
+		const double HarnessMs = FPlatformTime::ToMilliseconds64(OutermostCycles.load(std::memory_order_relaxed));
+
+		FString Summary = FString::Printf(TEXT("frames=%llu wall_ms=%.1f harness_ms=%.3f harness_ms_per_frame=%.4f harness_pct=%.3f\n"),
+			Frames, WallMs, HarnessMs, HarnessMs / Frames, WallMs > 0.0 ? HarnessMs * 100.0 / WallMs : 0.0);
+		for (int32 Index = 0; Index < static_cast<int32>(ELyraTestStatScope::Count); ++Index)
+		{
+			const FScopeCounters& Entry = Counters[Index];
+			const uint64 Calls = Entry.Calls.load(std::memory_order_relaxed);
+			if (Calls == 0)
+			{
+				continue;
+			}
+			const double TotalMs = FPlatformTime::ToMilliseconds64(Entry.TotalCycles.load(std::memory_order_relaxed));
+			const double MaxUs = FPlatformTime::ToSeconds64(Entry.MaxCycles.load(std::memory_order_relaxed)) * 1e6;
+			Summary += FString::Printf(TEXT("%s calls=%llu total_ms=%.3f avg_us=%.2f p50_us=%.0f p99_us=%.0f max_us=%.1f allocs_per_call=%.1f\n"),
+				ScopeNames[Index], Calls, TotalMs, TotalMs * 1000.0 / Calls,
+				GetPercentileMicroseconds(Entry, Calls, 0.5, MaxUs), GetPercentileMicroseconds(Entry, Calls, 0.99, MaxUs), MaxUs,
+				static_cast<double>(Entry.Allocs.load(std::memory_order_relaxed)) / Calls);
+		}
+		return Summary;
+	}
+}
+
+FLyraTestStatScope::FLyraTestStatScope(ELyraTestStatScope InScope)
+	: StartCycles(FPlatformTime::Cycles64())
+	, StartAllocs(LyraTestStats::GetAllocationCount())
+	, Scope(InScope)
+	, OuterScope(LyraTestStats::CurrentScope)
+{
+	LyraTestStats::CurrentScope = InScope;
+	++LyraTestStats::ScopeDepth;
+}
+
+FLyraTestStatScope::~FLyraTestStatScope()
+{
+	const uint64 Cycles = FPlatformTime::Cycles64() - StartCycles;
+	const uint64 Allocs = LyraTestStats::GetAllocationCount() - StartAllocs;
+	LyraTestStats::CurrentScope = OuterScope;
+	const bool bOutermost = --LyraTestStats::ScopeDepth == 0;
+	// Wrappers that forward to an entry point of the same kind (query library -> subsystem) count as one call.
+	if (OuterScope != Scope)
+	{
+		LyraTestStats::Record(Scope, Cycles, Allocs, bOutermost);
+	}
+}
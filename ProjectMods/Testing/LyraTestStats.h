@@ -0,0 +1,84 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Stats/Stats.h"
+
+DECLARE_STATS_GROUP(TEXT("LyraTest"), STATGROUP_LyraTest, STATCAT_Advanced);
+
+// Every instrumented Testing entry point. Each gets a cycle stat (stat LyraTest), an Insights CPU scope
+// named LyraTest_<Name> and call count / latency histogram / allocation counters (LyraTestStats::BuildSummary).
+#define LYRA_TEST_STAT_SCOPES(Op) \
+	Op(Query) \
+	Op(BuildSnapshot) \
+	Op(SpatialQuery) \
+	Op(Visibility) \
+	Op(EventQuery) \
+	Op(CombatQuery) \
+	Op(CombatRecord) \
+	Op(LookAt) \
+	Op(AimAtEnemy) \
+	Op(SelectTarget) \
+	Op(AimTrack) \
+	Op(AimTick) \
+	Op(ContinuousAimFire) \
+	Op(Fire) \
+	Op(FireInput) \
+	Op(Cheats) \
+	Op(CommandBatch) \
+	Op(Session) \
+	Op(WorldReset) \
+	Op(PerfCapture) \
+	Op(LoadHarness) \
+	Op(BotLod) \
+	Op(SubsystemTick)
+
+enum class ELyraTestStatScope : uint8
+{
+#define LYRA_TEST_STAT_ENUM(Name) Name,
+	LYRA_TEST_STAT_SCOPES(LYRA_TEST_STAT_ENUM)
+#undef LYRA_TEST_STAT_ENUM
+	Count
+};
+
+#define LYRA_TEST_STAT_DECLARE(Name) DECLARE_CYCLE_STAT_EXTERN(TEXT(#Name), STAT_LyraTest_##Name, STATGROUP_LyraTest, LYRAGAME_API);
+LYRA_TEST_STAT_SCOPES(LYRA_TEST_STAT_DECLARE)
+#undef LYRA_TEST_STAT_DECLARE
+
+/**
+ * Counts one call of Scope. Nested scopes are recorded too, but only outermost ones add to the harness total,
+ * and a scope directly inside one of the same kind is folded into it.
+ */
+class LYRAGAME_API FLyraTestStatScope
+{
+public:
+	explicit FLyraTestStatScope(ELyraTestStatScope InScope);
+	~FLyraTestStatScope();
+
+private:
+	uint64 StartCycles;
+	uint64 StartAllocs;
+	ELyraTestStatScope Scope;
+	ELyraTestStatScope OuterScope;
+};
+
+#define LYRA_TEST_SCOPE(Name) \
+	SCOPE_CYCLE_COUNTER(STAT_LyraTest_##Name); \
+	TRACE_CPUPROFILER_EVENT_SCOPE(LyraTest_##Name); \
+	FLyraTestStatScope LyraTestStatScope_##Name(ELyraTestStatScope::Name)
+
+namespace LyraTestStats
+{
+	/** Bucket 0 is under 1 us, bucket N covers [2^(N-1), 2^N) us, the last bucket is open ended. */
+	static constexpr int32 NumLatencyBuckets = 16;
+
+	/** One line per scope that was called since the last reset: calls, total / avg / p50 / p99 / max latency and allocations per call, plus the harness share of wall time. */
+	LYRAGAME_API FString BuildSummary();
+
+	LYRAGAME_API void Reset();
+
+	/** Process wide malloc + realloc calls so far; always 0 in shipping builds. */
+	LYRAGAME_API uint64 GetAllocationCount();
+}
@@ -1,9 +1,12 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "Testing/LyraTestSupportAimTickComponent.h"
+#include "Testing/LyraTestEventPublisher.h"
+#include "Testing/LyraTestStats.h"
 #include "Testing/LyraTestSupportSubsystem.h"
 #include "Engine/World.h"
 #include "Engine/GameInstance.h"
+#include "GameFramework/PlayerController.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraTestSupportAimTickComponent)
 
@@ -16,11 +19,106 @@ ULyraTestSupportAimTickComponent::ULyraTestSupportAimTickComponent(const FObject
 	PrimaryComponentTick.bStartWithTickEnabled = true;
 }
 
+void ULyraTestSupportAimTickComponent::StartTracking(int64 TargetId, const FVector* WorldPosition, bool bInFireWhenSettled, const FLyraTestAimControllerSettings& InSettings)
+{
+	bTracking = true;
+	bTrackWorldPosition = WorldPosition != nullptr;
+	TrackWorldPosition = WorldPosition ? *WorldPosition : FVector::ZeroVector;
+	TrackTargetId = TargetId;
+	bFireWhenSettled = bInFireWhenSettled;
+	Settings = InSettings;
+	YawVelocity = 0.f;
+	PitchVelocity = 0.f;
+	bSettled = false;
+}
+
+void ULyraTestSupportAimTickComponent::StopTracking()
+{
+	bTracking = false;
+	bSettled = false;
+}
+
 void ULyraTestSupportAimTickComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
+	LYRA_TEST_SCOPE(AimTick);
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
-	if (ULyraTestSupportSubsystem* Sub = TestSupportSubsystem.Get())
+	if (bTracking)
+	{
+		TickTracking(DeltaTime);
+	}
+	else if (bContinuousAimFire)
+	{
+		if (ULyraTestSupportSubsystem* Sub = TestSupportSubsystem.Get())
+		{
+			Sub->TickContinuousAimFire(PlayerIndex);
+		}
+	}
+}
+
+// Critically damped step toward Target (closed form, stable for any DeltaTime), with the angular speed clamped.
+static float StepAimAxis(float Current, float Target, float& Velocity, float DeltaTime, const FLyraTestAimControllerSettings& Settings)
+{
+	const float SmoothTime = FMath::Max(Settings.SmoothTimeSeconds, UE_KINDA_SMALL_NUMBER);
+	const float MaxStep = Settings.MaxAngularSpeedDegrees * DeltaTime;
+	const float Omega = 2.f / SmoothTime;
+	const float X = Omega * DeltaTime;
+	const float Decay = 1.f / (1.f + X + 0.48f * X * X + 0.235f * X * X * X);
+
+	const float Error = FRotator::NormalizeAxis(Current - Target);
+	const float Temp = (Velocity + Omega * Error) * DeltaTime;
+	Velocity = (Velocity - Omega * Temp) * Decay;
+	const float Step = FMath::Clamp((Error + Temp) * Decay - Error, -MaxStep, MaxStep);
+	if (DeltaTime > 0.f && FMath::Abs(Step) >= MaxStep)
+	{
+		Velocity = Step / DeltaTime;
+	}
+	return FRotator::NormalizeAxis(Current + Step);
+}
+
+void ULyraTestSupportAimTickComponent::TickTracking(float DeltaTime)
+{
+	ULyraTestSupportSubsystem* Sub = TestSupportSubsystem.Get();
+	APlayerController* PC = Cast<APlayerController>(GetOwner());
+	if (!Sub || !PC)
+	{
+		return;
+	}
+
+	FVector AimPoint = TrackWorldPosition;
+	FRotator Desired;
+	if ((!bTrackWorldPosition && !Sub->SolvePlayerAimPoint(PlayerIndex, TrackTargetId, AimPoint))
+		|| !Sub->ComputePlayerLookAtRotation(PlayerIndex, AimPoint, Desired))
+	{
+		SetSettled(false);
+		return;
+	}
+
+	const FRotator Current = PC->GetControlRotation();
+	const float NewPitch = StepAimAxis(Current.Pitch, Desired.Pitch, PitchVelocity, DeltaTime, Settings);
+	const float NewYaw = StepAimAxis(Current.Yaw, Desired.Yaw, YawVelocity, DeltaTime, Settings);
+	PC->SetControlRotation(FRotator(NewPitch, NewYaw, 0.f));
+
+	const float ErrorDegrees = FMath::Max(FMath::Abs(FRotator::NormalizeAxis(Desired.Pitch - NewPitch)), FMath::Abs(FRotator::NormalizeAxis(Desired.Yaw - NewYaw)));
+	SetSettled(ErrorDegrees <= Settings.SettleThresholdDegrees);
+	if (bSettled && bFireWhenSettled)
+	{
+		Sub->SimulatePrimaryFireForPlayer(PlayerIndex);
+	}
+}
+
+void ULyraTestSupportAimTickComponent::SetSettled(bool bInSettled)
+{
+	if (bSettled == bInSettled)
+	{
+		return;
+	}
+	bSettled = bInSettled;
+	if (bSettled)
 	{
-		Sub->TickContinuousAimFire();
+		OnAimSettled.Broadcast(PlayerIndex);
+		if (ULyraTestEventPublisher* Publisher = ULyraTestEventPublisher::Get(this))
+		{
+			Publisher->Publish(ELyraTestEventType::AimSettled, GetOwner(), nullptr, static_cast<float>(PlayerIndex));
+		}
 	}
 }
@@ -7,6 +7,25 @@
 
 class ULyraTestSupportSubsystem;
 
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FLyraTestAimSettledDelegate, int32, PlayerIndex);
+
+USTRUCT(BlueprintType)
+struct LYRAGAME_API FLyraTestAimControllerSettings
+{
+	GENERATED_BODY()
+
+	/** Approximate time for the critically damped aim to close most of the error. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	float SmoothTimeSeconds = 0.08f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	float MaxAngularSpeedDegrees = 720.f;
+
+	/** Yaw and pitch error below which the aim counts as settled. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	float SettleThresholdDegrees = 0.5f;
+};
+
 UCLASS(meta = (DisplayName = "Lyra Test Support Aim Tick"), Category = "Test|Automation", Transient)
 class LYRAGAME_API ULyraTestSupportAimTickComponent : public UActorComponent
 {
@@ -16,10 +35,39 @@ public:
 	ULyraTestSupportAimTickComponent(const FObjectInitializer& ObjectInitializer);
 
 	void SetSubsystem(ULyraTestSupportSubsystem* InSubsystem) { TestSupportSubsystem = InSubsystem; }
+	void SetPlayerIndex(int32 InPlayerIndex) { PlayerIndex = InPlayerIndex; }
+	void SetContinuousAimFire(bool bEnabled) { bContinuousAimFire = bEnabled; }
+
+	/** Rotates the owning controller toward TargetId (0 = selected target) or WorldPosition every frame at a bounded rate. */
+	void StartTracking(int64 TargetId, const FVector* WorldPosition, bool bInFireWhenSettled, const FLyraTestAimControllerSettings& InSettings);
+	void StopTracking();
+
+	bool IsTracking() const { return bTracking; }
+	bool IsSettled() const { return bSettled; }
+	bool IsIdle() const { return !bTracking && !bContinuousAimFire; }
+
+	UPROPERTY(BlueprintAssignable, Category = "Test|Automation")
+	FLyraTestAimSettledDelegate OnAimSettled;
 
 protected:
 	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
+	void TickTracking(float DeltaTime);
+	void SetSettled(bool bInSettled);
+
 	UPROPERTY()
 	TWeakObjectPtr<ULyraTestSupportSubsystem> TestSupportSubsystem;
+
+	int32 PlayerIndex = 0;
+	bool bContinuousAimFire = false;
+
+	bool bTracking = false;
+	bool bTrackWorldPosition = false;
+	bool bFireWhenSettled = false;
+	bool bSettled = false;
+	int64 TrackTargetId = 0;
+	FVector TrackWorldPosition = FVector::ZeroVector;
+	FLyraTestAimControllerSettings Settings;
+	float YawVelocity = 0.f;
+	float PitchVelocity = 0.f;
 };
@@ -2,18 +2,25 @@
 
 #include "Testing/LyraTestSupportSubsystem.h"
 #include "Testing/LyraTestEnemyQuery.h"
+#include "Testing/LyraTestEnemyRegistry.h"
+#include "Testing/LyraTestEventPublisher.h"
+#include "Testing/LyraTestNetComponent.h"
+#include "Testing/LyraTestStats.h"
 #include "Testing/LyraTestSupportAimTickComponent.h"
 #include "Engine/EngineTypes.h"
 #include "Engine/GameInstance.h"
+#include "Engine/LocalPlayer.h"
 #include "Engine/World.h"
 #include "GameFramework/PlayerController.h"
 #include "GameFramework/PlayerInput.h"
 #include "GameFramework/Pawn.h"
+#include "GameFramework/Character.h"
 #include "Camera/PlayerCameraManager.h"
 #include "Math/UnrealMathUtility.h"
 #include "InputCoreTypes.h"
 #include "Player/LyraPlayerController.h"
 #include "AbilitySystem/LyraAbilitySystemComponent.h"
+#include "Abilities/GameplayAbility.h"
 #include "Character/LyraPawnExtensionComponent.h"
 #include "Character/LyraPawnData.h"
 #include "Input/LyraInputConfig.h"
@@ -22,13 +29,24 @@
 #include "EnhancedInputSubsystems.h"
 #include "InputAction.h"
 #include "Equipment/LyraEquipmentManagerComponent.h"
+#include "Equipment/LyraQuickBarComponent.h"
 #include "Weapons/LyraRangedWeaponInstance.h"
+#include "Inventory/InventoryFragment_SetStats.h"
 #include "Inventory/LyraInventoryItemInstance.h"
+#include "AbilitySystem/Attributes/LyraHealthSet.h"
+#include "GameFramework/PlayerState.h"
+#include "GameplayEffect.h"
+#include "Misc/App.h"
+#include "Misc/Base64.h"
+#include "GameFramework/WorldSettings.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraTestSupportSubsystem)
 
 static const FName TagName_MagazineAmmo(TEXT("Lyra.ShooterGame.Weapon.MagazineAmmo"));
 static const FName TagName_SpareAmmo(TEXT("Lyra.ShooterGame.Weapon.SpareAmmo"));
+static const FName TagName_QuickBarActiveIndexChanged(TEXT("Lyra.QuickBar.Message.ActiveIndexChanged"));
+
+// Refill target for weapons without initial stats.
 static constexpr int32 InfiniteAmmoStackCount = 99999;
 
 static const FName WeaponFireInputTagNames[] = {
@@ -37,39 +55,125 @@ static const FName WeaponFireInputTagNames[] = {
 	FName(TEXT("InputTag.Weapon.Primary"))
 };
 
+static constexpr int32 MaxPendingCommandBatches = 64;
+
+// Matches the previous 0.05 s release timer at 60 Hz.
+static constexpr int32 FireTapHoldFrames = 3;
+
 static constexpr float ViewPitchMinDeg = -89.f;
 static constexpr float ViewPitchMaxDeg = 89.f;
 
+APlayerController* ULyraTestSupportSubsystem::FindLocalPlayerController(const UGameInstance* GI, int32 PlayerIndex)
+{
+	const ULocalPlayer* LP = GI ? GI->GetLocalPlayerByIndex(PlayerIndex) : nullptr;
+	return LP ? LP->GetPlayerController(GI->GetWorld()) : nullptr;
+}
+
+int64 ULyraTestSupportSubsystem::GetPlayerTargetId(int32 PlayerIndex) const
+{
+	return PlayerSlots.IsValidIndex(PlayerIndex) ? PlayerSlots[PlayerIndex].LastTargetId : 0;
+}
+
+APlayerController* ULyraTestSupportSubsystem::GetLocalPlayerController(int32 PlayerIndex) const
+{
+	return FindLocalPlayerController(GetGameInstance(), PlayerIndex);
+}
+
+int32 ULyraTestSupportSubsystem::FindLocalPlayerIndex(const AController* Controller) const
+{
+	const APlayerController* PC = Cast<APlayerController>(Controller);
+	const UGameInstance* GI = GetGameInstance();
+	return PC && GI && PC->GetLocalPlayer() ? GI->GetLocalPlayers().IndexOfByKey(PC->GetLocalPlayer()) : INDEX_NONE;
+}
+
+int32 ULyraTestSupportSubsystem::GetLocalPlayerCount() const
+{
+	const UGameInstance* GI = GetGameInstance();
+	return GI ? GI->GetNumLocalPlayers() : 0;
+}
+
+bool ULyraTestSupportSubsystem::IsLocalPlayerIndex(int32 PlayerIndex) const
+{
+	return PlayerIndex >= 0 && PlayerIndex < GetLocalPlayerCount();
+}
+
+FLyraTestPlayerSlot& ULyraTestSupportSubsystem::GetPlayerSlot(int32 PlayerIndex)
+{
+	check(PlayerIndex >= 0);
+	if (!PlayerSlots.IsValidIndex(PlayerIndex))
+	{
+		PlayerSlots.SetNum(PlayerIndex + 1);
+	}
+	return PlayerSlots[PlayerIndex];
+}
+
+static void GetTestViewPoint(const APlayerController* PC, FVector& OutLocation, FRotator& OutRotation)
+{
+	if (PC->PlayerCameraManager)
+	{
+		PC->PlayerCameraManager->GetCameraViewPoint(OutLocation, OutRotation);
+	}
+	else
+	{
+		PC->GetPlayerViewPoint(/*out*/ OutLocation, /*out*/ OutRotation);
+	}
+}
+
+template <typename FuncType>
+static void ForEachPlayerInMask(int32 PlayerMask, FuncType&& Func)
+{
+	for (int32 PlayerIndex = 0; PlayerIndex < 32; ++PlayerIndex)
+	{
+		if (static_cast<uint32>(PlayerMask) & (1u << PlayerIndex))
+		{
+			Func(PlayerIndex);
+		}
+	}
+}
+
 void ULyraTestSupportSubsystem::SetLocalPlayerLookAtWorldPosition(float TargetX, float TargetY, float TargetZ)
 {
+	SetPlayerLookAtWorldPosition(0, TargetX, TargetY, TargetZ);
+}
+
+void ULyraTestSupportSubsystem::SetPlayerLookAtWorldPosition(int32 PlayerIndex, float TargetX, float TargetY, float TargetZ)
+{
+	LYRA_TEST_SCOPE(LookAt);
 	UGameInstance* GI = GetGameInstance();
 	if (!GI || !GI->GetWorld())
 	{
 		return;
 	}
 
-	APlayerController* PC = GI->GetFirstLocalPlayerController();
+	APlayerController* PC = GetLocalPlayerController(PlayerIndex);
 	if (!PC)
 	{
 		return;
 	}
 
-	FVector ViewLocation;
-	FRotator ViewRotation;
-	if (PC->PlayerCameraManager)
+	FRotator NewRotation;
+	if (ComputePlayerLookAtRotation(PlayerIndex, FVector(TargetX, TargetY, TargetZ), NewRotation))
 	{
-		PC->PlayerCameraManager->GetCameraViewPoint(ViewLocation, ViewRotation);
+		PC->SetControlRotation(NewRotation);
 	}
-	else
+}
+
+bool ULyraTestSupportSubsystem::ComputePlayerLookAtRotation(int32 PlayerIndex, const FVector& AimPoint, FRotator& OutRotation) const
+{
+	const APlayerController* PC = GetLocalPlayerController(PlayerIndex);
+	if (!PC)
 	{
-		PC->GetPlayerViewPoint(/*out*/ ViewLocation, /*out*/ ViewRotation);
+		return false;
 	}
 
-	const FVector Target(TargetX, TargetY, TargetZ);
-	FVector Dir = (Target - ViewLocation).GetSafeNormal();
+	FVector ViewLocation;
+	FRotator ViewRotation;
+	GetTestViewPoint(PC, ViewLocation, ViewRotation);
+
+	FVector Dir = (AimPoint - ViewLocation).GetSafeNormal();
 	if (Dir.IsNearlyZero())
 	{
-		return;
+		return false;
 	}
 
 	float YawRad = FMath::Atan2(Dir.Y, Dir.X);
@@ -78,18 +182,212 @@ void ULyraTestSupportSubsystem::SetLocalPlayerLookAtWorldPosition(float TargetX,
 	float YawDeg = FMath::RadiansToDegrees(YawRad);
 	PitchDeg = FMath::Clamp(PitchDeg, ViewPitchMinDeg, ViewPitchMaxDeg);
 
-	const FRotator NewRotation(PitchDeg, YawDeg, 0.f);
-	PC->SetControlRotation(NewRotation);
+	OutRotation = FRotator(PitchDeg, YawDeg, 0.f);
+	return true;
 }
 
 void ULyraTestSupportSubsystem::SimulatePrimaryFire()
 {
-	UGameInstance* GI = GetGameInstance();
-	if (!GI) return;
-	APlayerController* PC = GI->GetFirstLocalPlayerController();
+	SimulatePrimaryFireForPlayer(0);
+}
+
+void ULyraTestSupportSubsystem::SimulatePrimaryFireForPlayers(int32 PlayerMask)
+{
+	ForEachPlayerInMask(PlayerMask, [this](int32 PlayerIndex) { SimulatePrimaryFireForPlayer(PlayerIndex); });
+}
+
+void ULyraTestSupportSubsystem::SimulatePrimaryFireForPlayer(int32 PlayerIndex)
+{
+	LYRA_TEST_SCOPE(Fire);
+	if (PlayerIndex < 0 || !GetLocalPlayerController(PlayerIndex)) return;
+	InputScheduler.Tap(PlayerIndex, GFrameCounter, FireTapHoldFrames);
+	TickInputScheduler();
+}
+
+void ULyraTestSupportSubsystem::StartFirePattern(int32 PlayerIndex, int32 ShotCount, int32 HoldFrames, int32 IntervalFrames)
+{
+	LYRA_TEST_SCOPE(Fire);
+	if (PlayerIndex < 0 || !GetLocalPlayerController(PlayerIndex)) return;
+	InputScheduler.StartPattern(PlayerIndex, GFrameCounter, ShotCount, HoldFrames, IntervalFrames);
+	TickInputScheduler();
+}
+
+void ULyraTestSupportSubsystem::StopFirePattern(int32 PlayerIndex)
+{
+	LYRA_TEST_SCOPE(Fire);
+	if (!IsLocalPlayerIndex(PlayerIndex)) return;
+	InputScheduler.Stop(PlayerIndex, GFrameCounter);
+	TickInputScheduler();
+}
+
+void ULyraTestSupportSubsystem::TickInputScheduler()
+{
+	InputScheduler.Tick(GFrameCounter, [this](int32 PlayerIndex, ELyraTestInputEdge Edge) { ApplyFireInputEdge(PlayerIndex, Edge); });
+}
+
+void ULyraTestSupportSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	Collection.InitializeDependency<UGameplayMessageSubsystem>();
+	if (UGameInstance* GI = GetGameInstance())
+	{
+		GI->OnPawnControllerChangedDelegates.AddDynamic(this, &ThisClass::HandlePawnControllerChanged);
+		if (UGameplayMessageSubsystem* MessageSubsystem = GI->GetSubsystem<UGameplayMessageSubsystem>())
+		{
+			const FGameplayTag Channel = UGameplayTagsManager::Get().RequestGameplayTag(TagName_QuickBarActiveIndexChanged, false);
+			if (Channel.IsValid())
+			{
+				QuickBarListenerHandle = MessageSubsystem->RegisterListener(Channel, this, &ThisClass::HandleQuickBarActiveIndexChanged);
+			}
+		}
+	}
+}
+
+void ULyraTestSupportSubsystem::Deinitialize()
+{
+	if (UGameInstance* GI = GetGameInstance())
+	{
+		GI->OnPawnControllerChangedDelegates.RemoveDynamic(this, &ThisClass::HandlePawnControllerChanged);
+	}
+	QuickBarListenerHandle.Unregister();
+	// Hands the shared engine timing back when this world goes away while others keep running.
+	SetFastForwardEnabled(false);
+	Super::Deinitialize();
+}
+
+void ULyraTestSupportSubsystem::Tick(float DeltaTime)
+{
+	LYRA_TEST_SCOPE(SubsystemTick);
+	TickInputScheduler();
+	TickCommandBatches();
+	for (int32 PlayerIndex = 0; PlayerIndex < PlayerSlots.Num(); ++PlayerIndex)
+	{
+		if (PlayerSlots[PlayerIndex].bContinuousAimFire)
+		{
+			TickContinuousAimFire(PlayerIndex);
+		}
+	}
+	if (bFastForward)
+	{
+		TickFastForward(DeltaTime);
+	}
+	if (WorldReset.IsRunning() && WorldReset.Tick(GetTickableGameObjectWorld()))
+	{
+		FinishWorldReset();
+	}
+	if (PerfCapture.IsRunning())
+	{
+		PerfCapture.Tick();
+	}
+}
+
+bool ULyraTestSupportSubsystem::IsTickable() const
+{
+	if (HasAnyFlags(RF_ClassDefaultObject))
+	{
+		return false;
+	}
+	if (InputScheduler.HasWork() || bFastForward || WorldReset.IsRunning() || PerfCapture.IsRunning())
+	{
+		return true;
+	}
+	for (const FLyraTestPlayerSlot& Slot : PlayerSlots)
+	{
+		if (Slot.bContinuousAimFire) return true;
+	}
+	for (const TPair<int64, FLyraTestCommandBatch>& Pair : PendingCommandBatches)
+	{
+		if (!Pair.Value.IsComplete()) return true;
+	}
+	return false;
+}
+
+int32 ULyraTestSupportSubsystem::FastForwardUsers = 0;
+bool ULyraTestSupportSubsystem::FastForwardPrevUseFixedTimeStep = false;
+double ULyraTestSupportSubsystem::FastForwardPrevFixedDeltaTime = 0.0;
+
+void ULyraTestSupportSubsystem::SetFastForwardEnabled(bool bEnable, float FixedDeltaSeconds, float TimeDilation)
+{
+	if (bEnable)
+	{
+		if (!bFastForward)
+		{
+			if (FastForwardUsers++ == 0)
+			{
+				FastForwardPrevUseFixedTimeStep = FApp::UseFixedTimeStep();
+				FastForwardPrevFixedDeltaTime = FApp::GetFixedDeltaTime();
+			}
+			FastForwardSimulatedSeconds = 0.0;
+			FastForwardRealStartSeconds = FPlatformTime::Seconds();
+		}
+		bFastForward = true;
+		FastForwardTimeDilation = FMath::Max(TimeDilation, UE_KINDA_SMALL_NUMBER);
+		// The engine skips its max tick rate wait entirely in fixed time step mode, which is what uncaps the frame rate.
+		FApp::SetUseFixedTimeStep(true);
+		FApp::SetFixedDeltaTime(FMath::Max(FixedDeltaSeconds, UE_KINDA_SMALL_NUMBER));
+		TickFastForward(0.f);
+	}
+	else if (bFastForward)
+	{
+		bFastForward = false;
+		// Engine timing is process wide, so it is only restored once no world is fast-forwarding any more.
+		if (--FastForwardUsers == 0)
+		{
+			FApp::SetUseFixedTimeStep(FastForwardPrevUseFixedTimeStep);
+			FApp::SetFixedDeltaTime(FastForwardPrevFixedDeltaTime);
+		}
+		const UGameInstance* GI = GetGameInstance();
+		const UWorld* World = GI ? GI->GetWorld() : nullptr;
+		if (AWorldSettings* WorldSettings = World ? World->GetWorldSettings() : nullptr)
+		{
+			WorldSettings->SetTimeDilation(1.f);
+		}
+	}
+}
+
+void ULyraTestSupportSubsystem::TickFastForward(float DeltaTime)
+{
+	FastForwardSimulatedSeconds += DeltaTime;
+
+	// Map travel brings new world settings, so the dilation is re-applied whenever it has been reset.
+	const UGameInstance* GI = GetGameInstance();
+	const UWorld* World = GI ? GI->GetWorld() : nullptr;
+	AWorldSettings* WorldSettings = World ? World->GetWorldSettings() : nullptr;
+	if (WorldSettings)
+	{
+		const float TimeDilation = FMath::Clamp(FastForwardTimeDilation, WorldSettings->MinGlobalTimeDilation, WorldSettings->MaxGlobalTimeDilation);
+		if (WorldSettings->TimeDilation != TimeDilation)
+		{
+			WorldSettings->SetTimeDilation(TimeDilation);
+		}
+	}
+}
+
+double ULyraTestSupportSubsystem::GetSimulatedTimeRatio() const
+{
+	const double RealSeconds = FPlatformTime::Seconds() - FastForwardRealStartSeconds;
+	return bFastForward && RealSeconds > 0.0 ? FastForwardSimulatedSeconds / RealSeconds : 0.0;
+}
+
+TStatId ULyraTestSupportSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(ULyraTestSupportSubsystem, STATGROUP_Tickables);
+}
+
+UWorld* ULyraTestSupportSubsystem::GetTickableGameObjectWorld() const
+{
+	const UGameInstance* GI = GetGameInstance();
+	return GI ? GI->GetWorld() : nullptr;
+}
+
+void ULyraTestSupportSubsystem::ApplyFireInputEdge(int32 PlayerIndex, ELyraTestInputEdge Edge)
+{
+	LYRA_TEST_SCOPE(FireInput);
+	APlayerController* PC = GetLocalPlayerController(PlayerIndex);
 	if (!PC) return;
-	UWorld* World = GI->GetWorld();
+	UWorld* World = PC->GetWorld();
 	const float DeltaTime = World ? World->GetDeltaSeconds() : 0.016f;
+	const bool bPressed = Edge != ELyraTestInputEdge::Release;
 
 	APawn* Pawn = PC->GetPawn();
 	if (Pawn)
@@ -112,19 +410,8 @@ void ULyraTestSupportSubsystem::SimulatePrimaryFire()
 							{
 								if (const UInputAction* FireAction = InputConfig->FindAbilityInputActionForTag(FireTag, false))
 								{
-									Subsystem->InjectInputVectorForAction(FireAction, FVector(1.0, 0.0, 0.0), Modifiers, Triggers);
-									TWeakObjectPtr<UEnhancedInputLocalPlayerSubsystem> SubsystemWeak(Subsystem);
-									const UInputAction* ActionToRelease = FireAction;
-									FTimerHandle ReleaseHandle;
-									World->GetTimerManager().SetTimer(ReleaseHandle, [SubsystemWeak, ActionToRelease]()
-									{
-										if (SubsystemWeak.IsValid())
-										{
-											TArray<UInputModifier*> M;
-											TArray<UInputTrigger*> T;
-											SubsystemWeak->InjectInputVectorForAction(ActionToRelease, FVector(0.0, 0.0, 0.0), M, T);
-										}
-									}, 0.05f, false);
+									// Injected values only last one evaluation, so a held press is injected again every frame.
+									Subsystem->InjectInputVectorForAction(FireAction, bPressed ? FVector(1.0, 0.0, 0.0) : FVector::ZeroVector, Modifiers, Triggers);
 									return;
 								}
 							}
@@ -155,166 +442,812 @@ void ULyraTestSupportSubsystem::SimulatePrimaryFire()
 			FGameplayTag FireTag = TagManager.RequestGameplayTag(TagName, false);
 			if (FireTag.IsValid())
 			{
-				ASC->AbilityInputTagPressed(FireTag);
-				ASC->ProcessAbilityInput(DeltaTime, false);
-				TWeakObjectPtr<ULyraAbilitySystemComponent> ASCWeak(ASC);
-				FTimerHandle ReleaseHandle;
-				World->GetTimerManager().SetTimer(ReleaseHandle, [ASCWeak, FireTag]()
+				if (Edge == ELyraTestInputEdge::Press)
 				{
-					if (ULyraAbilitySystemComponent* Ptr = ASCWeak.Get())
-					{
-						Ptr->AbilityInputTagReleased(FireTag);
-						Ptr->ProcessAbilityInput(0.016f, false);
-					}
-				}, 0.05f, false);
+					ASC->AbilityInputTagPressed(FireTag);
+					ASC->ProcessAbilityInput(DeltaTime, false);
+				}
+				else if (Edge == ELyraTestInputEdge::Release)
+				{
+					ASC->AbilityInputTagReleased(FireTag);
+					ASC->ProcessAbilityInput(DeltaTime, false);
+				}
 				return;
 			}
 		}
 	}
 
-	PC->InputKey(FInputKeyParams(EKeys::LeftMouseButton, EInputEvent::IE_Pressed, FVector::ZeroVector, false, FInputDeviceId()));
-	PC->InputKey(FInputKeyParams(EKeys::LeftMouseButton, EInputEvent::IE_Released, FVector::ZeroVector, false, FInputDeviceId()));
+	if (Edge != ELyraTestInputEdge::Hold)
+	{
+		PC->InputKey(FInputKeyParams(EKeys::LeftMouseButton, bPressed ? EInputEvent::IE_Pressed : EInputEvent::IE_Released, FVector::ZeroVector, false, FInputDeviceId()));
+	}
 }
 
 void ULyraTestSupportSubsystem::SetContinuousAimFireEnabled(bool bEnabled)
 {
-	UGameInstance* GI = GetGameInstance();
-	if (!GI) return;
+	SetContinuousAimFireEnabledForPlayer(0, bEnabled);
+}
 
-	if (ULyraTestSupportAimTickComponent* Existing = ContinuousAimTickComponent.Get())
+void ULyraTestSupportSubsystem::SetContinuousAimFireEnabledForPlayers(int32 PlayerMask, bool bEnabled)
+{
+	ForEachPlayerInMask(PlayerMask, [this, bEnabled](int32 PlayerIndex) { SetContinuousAimFireEnabledForPlayer(PlayerIndex, bEnabled); });
+}
+
+void ULyraTestSupportSubsystem::SetContinuousAimFireEnabledForPlayer(int32 PlayerIndex, bool bEnabled)
+{
+	if (!IsLocalPlayerIndex(PlayerIndex)) return;
+	FLyraTestPlayerSlot& Slot = GetPlayerSlot(PlayerIndex);
+	Slot.bContinuousAimFire = false;
+
+	if (!bEnabled)
+	{
+		if (ULyraTestSupportAimTickComponent* Comp = Slot.AimTickComponent.Get())
+		{
+			Comp->SetContinuousAimFire(false);
+		}
+		ReleaseAimTickComponentIfIdle(PlayerIndex);
+		return;
+	}
+
+	if (ULyraTestSupportAimTickComponent* Comp = GetOrCreateAimTickComponent(PlayerIndex))
 	{
-		Existing->DestroyComponent();
-		ContinuousAimTickComponent.Reset();
+		Comp->SetContinuousAimFire(true);
 	}
-	if (ContinuousAimFireHandle.IsValid())
+	else
 	{
-		GI->GetTimerManager().ClearTimer(ContinuousAimFireHandle);
-		ContinuousAimFireHandle.Invalidate();
+		// No controller to host the component yet; the subsystem tick aims and fires on game time instead.
+		Slot.bContinuousAimFire = true;
 	}
+}
 
-	if (bEnabled)
+ULyraTestSupportAimTickComponent* ULyraTestSupportSubsystem::GetOrCreateAimTickComponent(int32 PlayerIndex)
+{
+	APlayerController* PC = GetLocalPlayerController(PlayerIndex);
+	FLyraTestPlayerSlot& Slot = GetPlayerSlot(PlayerIndex);
+	ULyraTestSupportAimTickComponent* Comp = Slot.AimTickComponent.Get();
+	if (Comp && Comp->GetOwner() == PC)
 	{
-		APlayerController* PC = GI->GetFirstLocalPlayerController();
-		if (PC)
-		{
-			ULyraTestSupportAimTickComponent* Comp = NewObject<ULyraTestSupportAimTickComponent>(PC, ULyraTestSupportAimTickComponent::StaticClass(), NAME_None, RF_Transient);
-			if (Comp)
-			{
-				Comp->SetSubsystem(this);
-				Comp->RegisterComponent();
-				ContinuousAimTickComponent = Comp;
-			}
-		}
-		if (!ContinuousAimTickComponent.IsValid())
-		{
-			GI->GetTimerManager().SetTimer(ContinuousAimFireHandle, this, &ULyraTestSupportSubsystem::TickContinuousAimFire, 0.f, true);
-		}
+		return Comp;
+	}
+	if (Comp)
+	{
+		Comp->DestroyComponent();
+		Slot.AimTickComponent.Reset();
+	}
+	if (!PC)
+	{
+		return nullptr;
+	}
+
+	Comp = NewObject<ULyraTestSupportAimTickComponent>(PC, ULyraTestSupportAimTickComponent::StaticClass(), NAME_None, RF_Transient);
+	if (Comp)
+	{
+		Comp->SetSubsystem(this);
+		Comp->SetPlayerIndex(PlayerIndex);
+		Comp->RegisterComponent();
+		Slot.AimTickComponent = Comp;
+	}
+	return Comp;
+}
+
+void ULyraTestSupportSubsystem::ReleaseAimTickComponentIfIdle(int32 PlayerIndex)
+{
+	FLyraTestPlayerSlot& Slot = GetPlayerSlot(PlayerIndex);
+	ULyraTestSupportAimTickComponent* Comp = Slot.AimTickComponent.Get();
+	if (Comp && Comp->IsIdle())
+	{
+		Comp->DestroyComponent();
+		Slot.AimTickComponent.Reset();
+	}
+}
+
+bool ULyraTestSupportSubsystem::StartAimTracking(int32 PlayerIndex, int64 TargetId, bool bFireWhenSettled)
+{
+	LYRA_TEST_SCOPE(AimTrack);
+	if (!IsLocalPlayerIndex(PlayerIndex)) return false;
+	ULyraTestSupportAimTickComponent* Comp = GetOrCreateAimTickComponent(PlayerIndex);
+	if (!Comp) return false;
+	Comp->StartTracking(TargetId, nullptr, bFireWhenSettled, AimControllerSettings);
+	return true;
+}
+
+bool ULyraTestSupportSubsystem::StartAimTrackingWorldPosition(int32 PlayerIndex, float TargetX, float TargetY, float TargetZ, bool bFireWhenSettled)
+{
+	LYRA_TEST_SCOPE(AimTrack);
+	if (!IsLocalPlayerIndex(PlayerIndex)) return false;
+	ULyraTestSupportAimTickComponent* Comp = GetOrCreateAimTickComponent(PlayerIndex);
+	if (!Comp) return false;
+	const FVector Target(TargetX, TargetY, TargetZ);
+	Comp->StartTracking(0, &Target, bFireWhenSettled, AimControllerSettings);
+	return true;
+}
+
+void ULyraTestSupportSubsystem::StopAimTracking(int32 PlayerIndex)
+{
+	LYRA_TEST_SCOPE(AimTrack);
+	if (!IsLocalPlayerIndex(PlayerIndex)) return;
+	if (ULyraTestSupportAimTickComponent* Comp = GetPlayerSlot(PlayerIndex).AimTickComponent.Get())
+	{
+		Comp->StopTracking();
 	}
+	ReleaseAimTickComponentIfIdle(PlayerIndex);
 }
 
-void ULyraTestSupportSubsystem::TickContinuousAimFire()
+bool ULyraTestSupportSubsystem::IsAimSettled(int32 PlayerIndex) const
+{
+	const ULyraTestSupportAimTickComponent* Comp = PlayerSlots.IsValidIndex(PlayerIndex) ? PlayerSlots[PlayerIndex].AimTickComponent.Get() : nullptr;
+	return Comp && Comp->IsSettled();
+}
+
+void ULyraTestSupportSubsystem::SetAimControllerSettings(float SmoothTimeSeconds, float MaxAngularSpeedDegrees, float SettleThresholdDegrees)
+{
+	AimControllerSettings.SmoothTimeSeconds = FMath::Max(SmoothTimeSeconds, 0.f);
+	AimControllerSettings.MaxAngularSpeedDegrees = FMath::Max(MaxAngularSpeedDegrees, 0.f);
+	AimControllerSettings.SettleThresholdDegrees = FMath::Max(SettleThresholdDegrees, 0.f);
+}
+
+void ULyraTestSupportSubsystem::TickContinuousAimFire(int32 PlayerIndex)
+{
+	LYRA_TEST_SCOPE(ContinuousAimFire);
+	if (AimPlayerAtEnemy(PlayerIndex, 0))
+	{
+		SimulatePrimaryFireForPlayer(PlayerIndex);
+	}
+}
+
+void ULyraTestSupportSubsystem::SetAimSettings(ELyraTestAimPoint AimPoint, float ProjectileSpeed, float ExtraLeadSeconds)
+{
+	AimSettings.AimPoint = AimPoint;
+	AimSettings.ProjectileSpeed = FMath::Max(ProjectileSpeed, 0.f);
+	AimSettings.ExtraLeadSeconds = ExtraLeadSeconds;
+}
+
+void ULyraTestSupportSubsystem::SetTargetSelectionSettings(float MaxDistance, float MaxAngleDegrees, float DistanceWeight, float AngleWeight, float HealthWeight, bool bRequireLineOfSight)
+{
+	TargetSelectionSettings.MaxDistance = MaxDistance;
+	TargetSelectionSettings.MaxAngleDegrees = MaxAngleDegrees;
+	TargetSelectionSettings.DistanceWeight = DistanceWeight;
+	TargetSelectionSettings.AngleWeight = AngleWeight;
+	TargetSelectionSettings.HealthWeight = HealthWeight;
+	TargetSelectionSettings.bRequireLineOfSight = bRequireLineOfSight;
+}
+
+bool ULyraTestSupportSubsystem::AimPlayerAtEnemy(int32 PlayerIndex, int64 TargetId)
+{
+	LYRA_TEST_SCOPE(AimAtEnemy);
+	FVector AimPoint;
+	if (!SolvePlayerAimPoint(PlayerIndex, TargetId, AimPoint)) return false;
+	SetPlayerLookAtWorldPosition(PlayerIndex, AimPoint.X, AimPoint.Y, AimPoint.Z);
+	return true;
+}
+
+int64 ULyraTestSupportSubsystem::SelectTargetForPlayer(int32 PlayerIndex)
+{
+	LYRA_TEST_SCOPE(Query);
+	FVector ViewLocation;
+	const FLyraTestSnapshotRecord* Record = FindPlayerTarget(PlayerIndex, 0, ViewLocation);
+	return Record ? Record->Id : 0;
+}
+
+const FLyraTestSnapshotRecord* ULyraTestSupportSubsystem::FindPlayerTarget(int32 PlayerIndex, int64 TargetId, FVector& OutViewLocation)
 {
 	UGameInstance* GI = GetGameInstance();
-	if (!GI) return;
-	UWorld* World = GI->GetWorld();
-	if (!World) return;
+	UWorld* World = GI ? GI->GetWorld() : nullptr;
+	if (!World || PlayerIndex < 0) return nullptr;
+	APlayerController* PC = GetLocalPlayerController(PlayerIndex);
+	if (!PC) return nullptr;
+
+	FLyraTestPlayerSlot& Slot = GetPlayerSlot(PlayerIndex);
+	FLyraTestSnapshot& AimSnapshot = Slot.AimSnapshot;
+	FRotator ViewRotation;
+	GetTestViewPoint(PC, OutViewLocation, ViewRotation);
+
+	if (TargetId != 0)
+	{
+		// Explicit targets resolve through the handle table instead of snapshotting every character.
+		if (!ULyraTestEnemyQuery::BuildHandleSnapshot(World, PlayerIndex, MakeArrayView(&TargetId, 1), AimSnapshot) || AimSnapshot.Records.Num() < 2) return nullptr;
+		const FLyraTestSnapshotRecord& Player = AimSnapshot.Records[0];
+		const FLyraTestSnapshotRecord& Target = AimSnapshot.Records.Last();
+		if (Target.Kind != ELyraTestSnapshotRecordKind::Enemy || !Target.bAlive || !Target.Actor.IsValid()) return nullptr;
+		if (!ULyraTestEnemyRegistry::AreDifferentTeams(Player.TeamId, Target.TeamId)) return nullptr;
+		SetPlayerTarget(Slot, PlayerIndex, Target);
+		return &Target;
+	}
 
-	const FString Data = ULyraTestEnemyQuery::GetEnemyOnlyTestPositionsAsString(World, 0);
-	if (Data.IsEmpty()) return;
+	// Only candidates the selector would not cull anyway, from the registry's spatial index.
+	FLyraTestSpatialQuery Query;
+	Query.Shape = ELyraTestSpatialQueryShape::Cone;
+	Query.Origin = OutViewLocation;
+	Query.Direction = ViewRotation.Vector();
+	Query.HalfAngleDegrees = TargetSelectionSettings.MaxAngleDegrees;
+	Query.Distance = FMath::Max(TargetSelectionSettings.MaxDistance, 1.f);
+	if (!ULyraTestEnemyQuery::BuildSpatialTestSnapshot(World, PlayerIndex, true, Query, AimSnapshot)) return nullptr;
 
-	FVector PlayerPos(0.f, 0.f, 0.f);
-	TArray<FVector> EnemyPositions;
-	TArray<FString> Parts;
-	Data.ParseIntoArray(Parts, TEXT("|"), true);
-	for (const FString& Part : Parts)
+	const AActor* Viewer = PC->GetPawn() ? static_cast<const AActor*>(PC->GetPawn()) : PC;
+	const FLyraTestSnapshotRecord* Selected = Slot.TargetSelector.SelectTarget(World, Viewer, OutViewLocation, ViewRotation, AimSnapshot, TargetSelectionSettings);
+	if (Selected)
 	{
-		FString Trimmed = Part.TrimStartAndEnd();
-		if (Trimmed.Len() < 5) continue;
-		TArray<FString> Tokens;
-		Trimmed.ParseIntoArray(Tokens, TEXT(","), true);
-		if (Tokens.Num() < 4) continue;
-		float X = 0.f, Y = 0.f, Z = 0.f;
-		if (!LexTryParseString(X, *Tokens[1]) || !LexTryParseString(Y, *Tokens[2]) || !LexTryParseString(Z, *Tokens[3])) continue;
-		if (Trimmed.StartsWith(TEXT("P,"), ESearchCase::IgnoreCase))
-			PlayerPos = FVector(X, Y, Z);
-		else if (Trimmed.StartsWith(TEXT("E,"), ESearchCase::IgnoreCase))
-			EnemyPositions.Add(FVector(X, Y, Z));
+		SetPlayerTarget(Slot, PlayerIndex, *Selected);
 	}
+	return Selected;
+}
 
-	if (EnemyPositions.Num() == 0) return;
+void ULyraTestSupportSubsystem::SetPlayerTarget(FLyraTestPlayerSlot& Slot, int32 PlayerIndex, const FLyraTestSnapshotRecord& Target)
+{
+	if (Slot.LastTargetId == Target.Id) return;
+	Slot.LastTargetId = Target.Id;
+	// Handles are per process, so a network client tells the server which actor it is after instead.
+	const APlayerController* PC = GetLocalPlayerController(PlayerIndex);
+	ULyraTestNetComponent* NetComponent = PC && !PC->HasAuthority() ? ULyraTestNetComponent::Find(PC) : nullptr;
+	if (NetComponent)
+	{
+		NetComponent->ServerSetTarget(Target.Actor.Get());
+	}
+}
 
-	float BestDistSq = FLT_MAX;
-	FVector Best(0.f, 0.f, 0.f);
-	for (const FVector& E : EnemyPositions)
+bool ULyraTestSupportSubsystem::SolvePlayerAimPoint(int32 PlayerIndex, int64 TargetId, FVector& OutAimPoint)
+{
+	FVector ViewLocation;
+	const FLyraTestSnapshotRecord* BestRecord = FindPlayerTarget(PlayerIndex, TargetId, ViewLocation);
+	if (!BestRecord) return false;
+	APlayerController* PC = GetLocalPlayerController(PlayerIndex);
+	UWorld* World = PC->GetWorld();
+
+	const ULyraRangedWeaponInstance* Weapon = nullptr;
+	if (APawn* Pawn = PC->GetPawn())
 	{
-		float D = (E - PlayerPos).SizeSquared();
-		if (D < BestDistSq) { BestDistSq = D; Best = E; }
+		if (ULyraEquipmentManagerComponent* EquipmentManager = Pawn->FindComponentByClass<ULyraEquipmentManagerComponent>())
+		{
+			Weapon = EquipmentManager->GetFirstInstanceOfType<ULyraRangedWeaponInstance>();
+		}
 	}
 
-	constexpr float AimZOffset = 40.f;
-	SetLocalPlayerLookAtWorldPosition(Best.X, Best.Y, Best.Z + AimZOffset);
-	SimulatePrimaryFire();
+	// Injected fire input is consumed on the next frame, so lead by one frame plus the configured extra.
+	OutAimPoint = LyraTestAimSolver::SolveAimPoint(ViewLocation, Cast<ACharacter>(BestRecord->Actor.Get()), BestRecord->Position, BestRecord->Velocity,
+		Weapon, AimSettings, World->GetDeltaSeconds());
+	return true;
 }
 
 void ULyraTestSupportSubsystem::SetLocalPlayerInvincible(bool bEnable)
 {
-	UGameInstance* GI = GetGameInstance();
-	if (!GI) return;
-	APlayerController* PC = GI->GetFirstLocalPlayerController();
-	if (!PC) return;
+	SetPlayerInvincible(0, bEnable);
+}
 
+void ULyraTestSupportSubsystem::SetTestCheatsForPlayers(int32 PlayerMask, bool bInvincible, bool bInfiniteAmmo)
+{
+	ForEachPlayerInMask(PlayerMask, [this, bInvincible, bInfiniteAmmo](int32 PlayerIndex)
+	{
+		SetPlayerInvincible(PlayerIndex, bInvincible);
+		SetPlayerInfiniteAmmo(PlayerIndex, bInfiniteAmmo);
+	});
+}
+
+static ULyraAbilitySystemComponent* GetPlayerAbilitySystem(const AController* Controller, const APawn* Pawn)
+{
 	ULyraAbilitySystemComponent* ASC = nullptr;
-	if (ALyraPlayerController* LyraPC = Cast<ALyraPlayerController>(PC))
+	if (const ALyraPlayerController* LyraPC = Cast<ALyraPlayerController>(Controller))
 	{
 		ASC = LyraPC->GetLyraAbilitySystemComponent();
 	}
-	if (!ASC && PC->GetPawn())
+	if (!ASC && Pawn)
 	{
-		if (ULyraPawnExtensionComponent* PawnExt = ULyraPawnExtensionComponent::FindPawnExtensionComponent(PC->GetPawn()))
+		if (const ULyraPawnExtensionComponent* PawnExt = ULyraPawnExtensionComponent::FindPawnExtensionComponent(Pawn))
 		{
 			ASC = PawnExt->GetLyraAbilitySystemComponent();
 		}
 	}
-	if (!ASC) return;
+	return ASC;
+}
 
+static void SetGodMode(ULyraAbilitySystemComponent* ASC, bool bEnable)
+{
 	const FGameplayTag Tag = LyraGameplayTags::Cheat_GodMode;
-	if (bEnable)
-		ASC->AddDynamicTagGameplayEffect(Tag);
-	else
+	// Each add stacks another effect, so only add when the tag is missing.
+	if (!bEnable)
 		ASC->RemoveDynamicTagGameplayEffect(Tag);
+	else if (!ASC->HasMatchingGameplayTag(Tag))
+		ASC->AddDynamicTagGameplayEffect(Tag);
+}
+
+// Raises the ammo stacks of every ranged weapon back to their initial stats; never lowers them.
+static void TopUpAmmo(APawn* Pawn)
+{
+	// Ammo stacks replicate from the server, so a client-side top-up would be overwritten.
+	if (!Pawn || Pawn->GetLocalRole() != ROLE_Authority) return;
+	ULyraEquipmentManagerComponent* EquipmentManager = Pawn->FindComponentByClass<ULyraEquipmentManagerComponent>();
+	if (!EquipmentManager) return;
+
+	const UGameplayTagsManager& TagManager = UGameplayTagsManager::Get();
+	const FGameplayTag AmmoTags[] = { TagManager.RequestGameplayTag(TagName_MagazineAmmo, false), TagManager.RequestGameplayTag(TagName_SpareAmmo, false) };
+	for (ULyraEquipmentInstance* EquipInstance : EquipmentManager->GetEquipmentInstancesOfType(ULyraRangedWeaponInstance::StaticClass()))
+	{
+		ULyraInventoryItemInstance* ItemInstance = Cast<ULyraInventoryItemInstance>(EquipInstance->GetInstigator());
+		if (!ItemInstance) continue;
+		const UInventoryFragment_SetStats* Stats = ItemInstance->FindFragmentByClass<UInventoryFragment_SetStats>();
+		for (const FGameplayTag& Tag : AmmoTags)
+		{
+			if (!Tag.IsValid()) continue;
+			const int32 Full = Stats ? Stats->GetItemStatByTag(Tag) : InfiniteAmmoStackCount;
+			const int32 Missing = Full - ItemInstance->GetStatTagStackCount(Tag);
+			if (Missing > 0)
+				ItemInstance->AddStatTagStack(Tag, Missing);
+		}
+	}
+}
+
+void ULyraTestSupportSubsystem::SetPlayerInvincible(int32 PlayerIndex, bool bEnable)
+{
+	LYRA_TEST_SCOPE(Cheats);
+	if (!IsLocalPlayerIndex(PlayerIndex)) return;
+	GetPlayerSlot(PlayerIndex).bInvincible = bEnable;
+	if (!bEnable && !RouteCheatsToServer(PlayerIndex))
+	{
+		const APlayerController* PC = GetLocalPlayerController(PlayerIndex);
+		if (ULyraAbilitySystemComponent* ASC = PC ? GetPlayerAbilitySystem(PC, PC->GetPawn()) : nullptr)
+		{
+			SetGodMode(ASC, false);
+		}
+		return;
+	}
+	ApplyPlayerCheats(PlayerIndex);
 }
 
 void ULyraTestSupportSubsystem::SetLocalPlayerInfiniteAmmo(bool bEnable)
 {
-	if (!bEnable) return;
-	UGameInstance* GI = GetGameInstance();
-	if (!GI) return;
-	APlayerController* PC = GI->GetFirstLocalPlayerController();
-	if (!PC) return;
-	APawn* Pawn = PC->GetPawn();
-	if (!Pawn) return;
+	SetPlayerInfiniteAmmo(0, bEnable);
+}
+
+void ULyraTestSupportSubsystem::SetPlayerInfiniteAmmo(int32 PlayerIndex, bool bEnable)
+{
+	LYRA_TEST_SCOPE(Cheats);
+	if (!IsLocalPlayerIndex(PlayerIndex)) return;
+	GetPlayerSlot(PlayerIndex).bInfiniteAmmo = bEnable;
+	ApplyPlayerCheats(PlayerIndex);
+}
+
+int32 ULyraTestSupportSubsystem::GetPlayerCheatState(int32 PlayerIndex) const
+{
+	if (!PlayerSlots.IsValidIndex(PlayerIndex)) return 0;
+	const FLyraTestPlayerSlot& Slot = PlayerSlots[PlayerIndex];
+	const APlayerController* PC = GetLocalPlayerController(PlayerIndex);
+	const ULyraAbilitySystemComponent* ASC = PC ? GetPlayerAbilitySystem(PC, PC->GetPawn()) : nullptr;
+	const bool bGodMode = ASC && ASC->HasMatchingGameplayTag(LyraGameplayTags::Cheat_GodMode);
+	return (Slot.bInvincible ? 1 : 0) | (Slot.bInfiniteAmmo ? 2 : 0) | (bGodMode ? 4 : 0);
+}
+
+void ULyraTestSupportSubsystem::ApplyPlayerCheats(int32 PlayerIndex)
+{
+	if (RouteCheatsToServer(PlayerIndex)) return;
+	const APlayerController* PC = GetLocalPlayerController(PlayerIndex);
+	if (APawn* Pawn = PC ? PC->GetPawn() : nullptr)
+	{
+		// Applies now if the ability system is up, otherwise once it initializes.
+		TrackCombatPawn(Pawn);
+	}
+}
 
-	if (Pawn->GetLocalRole() != ROLE_Authority)
+bool ULyraTestSupportSubsystem::RouteCheatsToServer(int32 PlayerIndex)
+{
+	// God mode and ammo only stick on the server, so a network client sends its desired state there instead.
+	const APlayerController* PC = GetLocalPlayerController(PlayerIndex);
+	if (!PC || PC->HasAuthority()) return false;
+	ULyraTestNetComponent* NetComponent = ULyraTestNetComponent::Find(PC);
+	if (NetComponent && PlayerSlots.IsValidIndex(PlayerIndex))
 	{
+		NetComponent->ServerSetCheats(PlayerSlots[PlayerIndex].bInvincible, PlayerSlots[PlayerIndex].bInfiniteAmmo);
+	}
+	return true;
+}
+
+void ULyraTestSupportSubsystem::ApplyControllerCheats(const AController* Controller)
+{
+	const int32 PlayerIndex = FindLocalPlayerIndex(Controller);
+	if (PlayerIndex != INDEX_NONE)
+	{
+		ApplyPlayerCheats(PlayerIndex);
 		return;
 	}
+	// Remote player on the server; a later pawn is picked up on possession.
+	APawn* Pawn = Controller ? Controller->GetPawn() : nullptr;
+	bool bInvincible = false;
+	bool bInfiniteAmmo = false;
+	if (!Pawn || !GetDesiredCheats(Controller, bInvincible, bInfiniteAmmo)) return;
+	if (!bInvincible)
+	{
+		if (ULyraAbilitySystemComponent* ASC = GetPlayerAbilitySystem(Controller, Pawn))
+		{
+			SetGodMode(ASC, false);
+		}
+	}
+	TrackCombatPawn(Pawn);
+}
 
-	ULyraEquipmentManagerComponent* EquipmentManager = Pawn->FindComponentByClass<ULyraEquipmentManagerComponent>();
-	if (!EquipmentManager) return;
+bool ULyraTestSupportSubsystem::GetDesiredCheats(const AController* Controller, bool& bOutInvincible, bool& bOutInfiniteAmmo) const
+{
+	const int32 PlayerIndex = FindLocalPlayerIndex(Controller);
+	if (PlayerSlots.IsValidIndex(PlayerIndex))
+	{
+		bOutInvincible = PlayerSlots[PlayerIndex].bInvincible;
+		bOutInfiniteAmmo = PlayerSlots[PlayerIndex].bInfiniteAmmo;
+		return true;
+	}
+	if (const ULyraTestNetComponent* NetComponent = PlayerIndex == INDEX_NONE ? ULyraTestNetComponent::Find(Controller) : nullptr)
+	{
+		bOutInvincible = NetComponent->IsInvincible();
+		bOutInfiniteAmmo = NetComponent->IsInfiniteAmmo();
+		return true;
+	}
+	return false;
+}
 
-	const UGameplayTagsManager& TagManager = UGameplayTagsManager::Get();
-	const FGameplayTag MagazineTag = TagManager.RequestGameplayTag(TagName_MagazineAmmo, false);
-	const FGameplayTag SpareTag = TagManager.RequestGameplayTag(TagName_SpareAmmo, false);
-	if (!MagazineTag.IsValid() && !SpareTag.IsValid()) return;
+void ULyraTestSupportSubsystem::ApplyCheatsToPawn(APawn* Pawn)
+{
+	bool bInvincible = false;
+	bool bInfiniteAmmo = false;
+	if (!Pawn || !GetDesiredCheats(Pawn->GetController(), bInvincible, bInfiniteAmmo)) return;
+	if (!bInvincible && !bInfiniteAmmo) return;
 
-	const TArray<ULyraEquipmentInstance*> RangedWeapons = EquipmentManager->GetEquipmentInstancesOfType(ULyraRangedWeaponInstance::StaticClass());
-	for (ULyraEquipmentInstance* EquipInstance : RangedWeapons)
+	LYRA_TEST_SCOPE(Cheats);
+	ULyraAbilitySystemComponent* ASC = GetPlayerAbilitySystem(Pawn->GetController(), Pawn);
+	if (!ASC) return;
+	if (bInvincible)
 	{
-		ULyraInventoryItemInstance* ItemInstance = Cast<ULyraInventoryItemInstance>(EquipInstance->GetInstigator());
-		if (!ItemInstance) continue;
-		if (MagazineTag.IsValid())
-			ItemInstance->AddStatTagStack(MagazineTag, InfiniteAmmoStackCount);
-		if (SpareTag.IsValid())
-			ItemInstance->AddStatTagStack(SpareTag, InfiniteAmmoStackCount);
+		SetGodMode(ASC, true);
+	}
+	if (bInfiniteAmmo)
+	{
+		TopUpAmmo(Pawn);
+	}
+	// Ammo is spent when an ability commits its cost; the ability system outlives the pawn for players.
+	if (!CheatBoundAbilitySystems.Contains(ASC))
+	{
+		CheatBoundAbilitySystems.Add(ASC);
+		ASC->AbilityCommittedCallbacks.AddUObject(this, &ThisClass::HandleAbilityCommitted);
+	}
+}
+
+void ULyraTestSupportSubsystem::HandlePawnControllerChanged(APawn* Pawn, AController* Controller)
+{
+	if (Pawn && (FindLocalPlayerIndex(Controller) != INDEX_NONE || ULyraTestNetComponent::Find(Controller)))
+	{
+		TrackCombatPawn(Pawn);
+	}
+}
+
+void ULyraTestSupportSubsystem::HandleAbilityCommitted(UGameplayAbility* Ability)
+{
+	APawn* Pawn = Ability ? Cast<APawn>(Ability->GetAvatarActorFromActorInfo()) : nullptr;
+	bool bInvincible = false;
+	bool bInfiniteAmmo = false;
+	if (Pawn && GetDesiredCheats(Pawn->GetController(), bInvincible, bInfiniteAmmo) && bInfiniteAmmo)
+	{
+		LYRA_TEST_SCOPE(Cheats);
+		TopUpAmmo(Pawn);
+	}
+}
+
+void ULyraTestSupportSubsystem::HandleQuickBarActiveIndexChanged(FGameplayTag Channel, const FLyraQuickBarActiveIndexChangedMessage& Message)
+{
+	// The quick bar lives on the controller and has equipped the new weapon by the time this is broadcast.
+	const AController* Controller = Cast<AController>(Message.Owner);
+	ApplyCheatsToPawn(Controller ? Controller->GetPawn() : Cast<APawn>(Message.Owner));
+}
+
+int64 ULyraTestSupportSubsystem::GetLatestCombatSequence() const
+{
+	return CombatLog.GetLatestSequence();
+}
+
+TArray<FLyraTestCombatRecord> ULyraTestSupportSubsystem::GetCombatLogSince(int64 SinceSequence, int32 MaxRecords) const
+{
+	LYRA_TEST_SCOPE(CombatQuery);
+	TArray<FLyraTestCombatRecord> Result;
+	CombatLog.ReadSince(SinceSequence, MaxRecords, Result);
+	return Result;
+}
+
+FString ULyraTestSupportSubsystem::GetCombatLogSinceBase64(int64 SinceSequence, int32 MaxRecords) const
+{
+	LYRA_TEST_SCOPE(CombatQuery);
+	TArray<FLyraTestCombatRecord> Result;
+	int64 Lost = 0;
+	CombatLog.ReadSince(SinceSequence, MaxRecords, Result, &Lost);
+	TArray<uint8> Bytes;
+	LyraTestCombatLog::SerializeToBytes(Result, Bytes, Lost);
+	return FBase64::Encode(Bytes);
+}
+
+int64 ULyraTestSupportSubsystem::FindKillSince(int64 SinceSequence, int64 VictimId, int64 InstigatorId) const
+{
+	LYRA_TEST_SCOPE(CombatQuery);
+	const TArray<FLyraTestCombatRecord> Records = GetCombatLogSince(SinceSequence, 0);
+	for (const FLyraTestCombatRecord& Record : Records)
+	{
+		if (Record.Kind != ELyraTestCombatRecordKind::Kill) continue;
+		if (VictimId != 0 && Record.VictimId != VictimId) continue;
+		if (InstigatorId != 0 && Record.InstigatorId != InstigatorId) continue;
+		return Record.Sequence;
+	}
+	return 0;
+}
+
+int64 ULyraTestSupportSubsystem::ResetWorld(const FLyraTestWorldResetSettings& Settings)
+{
+	LYRA_TEST_SCOPE(WorldReset);
+	if (!IsLocalPlayerIndex(Settings.PlayerIndex)) return 0;
+	for (int32 PlayerIndex = 0; PlayerIndex < PlayerSlots.Num(); ++PlayerIndex)
+	{
+		StopFirePattern(PlayerIndex);
+		SetContinuousAimFireEnabledForPlayer(PlayerIndex, false);
+		StopAimTracking(PlayerIndex);
+	}
+	PendingCommandBatches.Reset();
+
+	const int64 ResetId = ++LastWorldResetId;
+	WorldReset.Begin(GetTickableGameObjectWorld(), ResetId, Settings, GetLocalPlayerController(Settings.PlayerIndex));
+	if (!WorldReset.IsRunning())
+	{
+		FinishWorldReset();
+	}
+	return ResetId;
+}
+
+void ULyraTestSupportSubsystem::FinishWorldReset()
+{
+	const FLyraTestWorldResetResult& Result = WorldReset.GetResult();
+	if (Result.bSucceeded)
+	{
+		CombatLog.Clear();
+		// Respawned pawns pick their cheats up on ability system init; this covers reused ones.
+		for (int32 PlayerIndex = 0; PlayerIndex < PlayerSlots.Num(); ++PlayerIndex)
+		{
+			ApplyPlayerCheats(PlayerIndex);
+		}
+	}
+	// Published on failure too so waiters wake up; GetWorldResetResult tells them apart.
+	if (ULyraTestEventPublisher* Publisher = GetGameInstance()->GetSubsystem<ULyraTestEventPublisher>())
+	{
+		const APlayerController* PC = WorldReset.GetPlayerController();
+		Publisher->Publish(ELyraTestEventType::WorldReset, PC ? PC->GetPawn() : nullptr, PC, static_cast<float>(Result.ResetId));
+	}
+}
+
+void ULyraTestSupportSubsystem::BeginPerfCapture(const FString& Name, float HitchThresholdMs)
+{
+	PerfCapture.Begin(Name, HitchThresholdMs);
+}
+
+FLyraTestPerfCaptureResult ULyraTestSupportSubsystem::EndPerfCapture()
+{
+	return PerfCapture.End();
+}
+
+FLyraTestPerfComparison ULyraTestSupportSubsystem::ComparePerfCaptureToBaseline(const FLyraTestPerfCaptureResult& Result, const FString& BaselineDirectory, const FLyraTestPerfGateSettings& Gate) const
+{
+	return LyraTestPerfCapture::CompareToBaseline(Result, BaselineDirectory, Gate);
+}
+
+void ULyraTestSupportSubsystem::TrackCombatPawn(APawn* Pawn)
+{
+	if (ULyraPawnExtensionComponent* PawnExt = ULyraPawnExtensionComponent::FindPawnExtensionComponent(Pawn))
+	{
+		// Registers once per pawn and runs immediately when the ability system is already initialized.
+		PawnExt->OnAbilitySystemInitialized_RegisterAndCall(FSimpleMulticastDelegate::FDelegate::CreateUObject(this, &ThisClass::HandlePawnAbilitySystemInitialized, TWeakObjectPtr<APawn>(Pawn)));
+	}
+}
+
+void ULyraTestSupportSubsystem::HandlePawnAbilitySystemInitialized(TWeakObjectPtr<APawn> WeakPawn)
+{
+	ApplyCheatsToPawn(WeakPawn.Get());
+
+	ULyraPawnExtensionComponent* PawnExt = ULyraPawnExtensionComponent::FindPawnExtensionComponent(WeakPawn.Get());
+	ULyraAbilitySystemComponent* ASC = PawnExt ? PawnExt->GetLyraAbilitySystemComponent() : nullptr;
+	const ULyraHealthSet* HealthSet = ASC ? ASC->GetSet<ULyraHealthSet>() : nullptr;
+	if (!HealthSet || CombatBoundHealthSets.Contains(HealthSet))
+	{
+		return;
+	}
+	CombatBoundHealthSets.Add(HealthSet);
+	HealthSet->OnHealthChanged.AddUObject(this, &ThisClass::HandleCombatHealthChanged, TWeakObjectPtr<const ULyraHealthSet>(HealthSet));
+}
+
+static const AActor* ResolveCombatInstigator(AActor* EffectInstigator, AActor* EffectCauser)
+{
+	if (const APawn* CauserPawn = Cast<APawn>(EffectCauser))
+	{
+		return CauserPawn;
+	}
+	if (const APlayerState* PS = Cast<APlayerState>(EffectInstigator))
+	{
+		if (APawn* Pawn = PS->GetPawn()) return Pawn;
+	}
+	if (const AController* Controller = Cast<AController>(EffectInstigator))
+	{
+		if (APawn* Pawn = Controller->GetPawn()) return Pawn;
+	}
+	return EffectInstigator;
+}
+
+void ULyraTestSupportSubsystem::HandleCombatHealthChanged(AActor* EffectInstigator, AActor* EffectCauser, const FGameplayEffectSpec* EffectSpec, float EffectMagnitude, float OldValue, float NewValue, TWeakObjectPtr<const ULyraHealthSet> WeakHealthSet)
+{
+	LYRA_TEST_SCOPE(CombatRecord);
+	if (NewValue >= OldValue) return;
+	const ULyraHealthSet* HealthSet = WeakHealthSet.Get();
+	const UAbilitySystemComponent* ASC = HealthSet ? HealthSet->GetOwningAbilitySystemComponent() : nullptr;
+	const AActor* Victim = ASC ? ASC->GetAvatarActor() : nullptr;
+	const UWorld* World = Victim ? Victim->GetWorld() : nullptr;
+
+	FLyraTestCombatRecord Record;
+	Record.FrameNumber = static_cast<int64>(GFrameCounter);
+	Record.WorldTimeSeconds = World ? World->GetTimeSeconds() : 0.0;
+	Record.Kind = ELyraTestCombatRecordKind::Damage;
+	Record.InstigatorId = ULyraTestEnemyQuery::GetTestObjectId(ResolveCombatInstigator(EffectInstigator, EffectCauser));
+	Record.VictimId = ULyraTestEnemyQuery::GetTestObjectId(Victim);
+	Record.Damage = OldValue - NewValue;
+	Record.VictimHealth = NewValue;
+	Record.HitLocation = Victim ? Victim->GetActorLocation() : FVector::ZeroVector;
+
+	const UObject* Weapon = EffectCauser;
+	if (EffectSpec)
+	{
+		const FGameplayEffectContextHandle& Context = EffectSpec->GetEffectContext();
+		if (const UObject* SourceObject = Context.GetSourceObject())
+		{
+			Weapon = SourceObject;
+		}
+		if (const FHitResult* Hit = Context.GetHitResult())
+		{
+			Record.HitLocation = Hit->ImpactPoint;
+		}
+	}
+	Record.WeaponId = ULyraTestEnemyQuery::GetTestObjectId(Weapon);
+
+	CombatLog.Push(Record);
+	if (OldValue > 0.f && NewValue <= 0.f)
+	{
+		Record.Kind = ELyraTestCombatRecordKind::Kill;
+		CombatLog.Push(Record);
+	}
+}
+
+FString ULyraTestSupportSubsystem::ExecuteCommandBatch(int32 PlayerIndex, const FString& Commands)
+{
+	LYRA_TEST_SCOPE(CommandBatch);
+	if (!IsLocalPlayerIndex(PlayerIndex)) return FString();
+	FLyraTestCommandBatch Batch;
+	Batch.BatchId = ++LastCommandBatchId;
+	Batch.PlayerIndex = PlayerIndex;
+
+	FString ParseError;
+	if (LyraTestCommandBatch::ParseCommands(Commands, Batch.Commands, ParseError))
+	{
+		RunCommandBatch(Batch);
+	}
+	else
+	{
+		Batch.Flags |= LyraTestCommandBatch::Flag_ParseError;
+	}
+
+	TArray<uint8> Bytes;
+	Batch.SerializeToBytes(Bytes);
+	if (!Batch.IsComplete())
+	{
+		if (PendingCommandBatches.Num() >= MaxPendingCommandBatches)
+		{
+			int64 OldestId = TNumericLimits<int64>::Max();
+			for (const TPair<int64, FLyraTestCommandBatch>& Pair : PendingCommandBatches)
+			{
+				OldestId = FMath::Min(OldestId, Pair.Key);
+			}
+			PendingCommandBatches.Remove(OldestId);
+		}
+		const int64 BatchId = Batch.BatchId;
+		PendingCommandBatches.Add(BatchId, MoveTemp(Batch));
+	}
+	return FBase64::Encode(Bytes);
+}
+
+FString ULyraTestSupportSubsystem::GetCommandBatchResults(int64 BatchId)
+{
+	LYRA_TEST_SCOPE(CommandBatch);
+	TArray<uint8> Bytes;
+	if (const FLyraTestCommandBatch* Batch = PendingCommandBatches.Find(BatchId))
+	{
+		Batch->SerializeToBytes(Bytes);
+		if (Batch->IsComplete())
+		{
+			PendingCommandBatches.Remove(BatchId);
+		}
+	}
+	else
+	{
+		FLyraTestCommandBatch Unknown;
+		Unknown.BatchId = BatchId;
+		Unknown.Flags = LyraTestCommandBatch::Flag_Unknown;
+		Unknown.SerializeToBytes(Bytes);
+	}
+	return FBase64::Encode(Bytes);
+}
+
+void ULyraTestSupportSubsystem::RunCommandBatch(FLyraTestCommandBatch& Batch)
+{
+	UGameInstance* GI = GetGameInstance();
+	UWorld* World = GI ? GI->GetWorld() : nullptr;
+	const int32 PlayerIndex = Batch.PlayerIndex;
+	Batch.LastRunFrame = GFrameCounter;
+
+	while (!Batch.IsComplete())
+	{
+		const FLyraTestCommand& Command = Batch.Commands[Batch.NextCommand++];
+		switch (Command.Op)
+		{
+		case ELyraTestCommandOp::LookAt:
+			SetPlayerLookAtWorldPosition(PlayerIndex, Command.Target.X, Command.Target.Y, Command.Target.Z);
+			Batch.AddResult(Command.Op, GetLocalPlayerController(PlayerIndex) != nullptr);
+			break;
+		case ELyraTestCommandOp::AimAtEnemy:
+			Batch.AddResult(Command.Op, AimPlayerAtEnemy(PlayerIndex, Command.Values[0]));
+			break;
+		case ELyraTestCommandOp::TrackEnemy:
+			Batch.AddResult(Command.Op, StartAimTracking(PlayerIndex, Command.Values[0], Command.bFlagA));
+			break;
+		case ELyraTestCommandOp::FirePattern:
+			StartFirePattern(PlayerIndex, static_cast<int32>(Command.Values[0]), static_cast<int32>(Command.Values[1]), static_cast<int32>(Command.Values[2]));
+			Batch.AddResult(Command.Op, GetLocalPlayerController(PlayerIndex) != nullptr);
+			break;
+		case ELyraTestCommandOp::Fire:
+			SimulatePrimaryFireForPlayer(PlayerIndex);
+			Batch.AddResult(Command.Op, GetLocalPlayerController(PlayerIndex) != nullptr);
+			break;
+		case ELyraTestCommandOp::SetCheats:
+			SetPlayerInvincible(PlayerIndex, Command.bFlagA);
+			SetPlayerInfiniteAmmo(PlayerIndex, Command.bFlagB);
+			Batch.AddResult(Command.Op, GetLocalPlayerController(PlayerIndex) != nullptr);
+			break;
+		case ELyraTestCommandOp::Snapshot:
+		{
+			FLyraTestSnapshot Snapshot;
+			TArray<uint8> SnapshotBytes;
+			const bool bOk = ULyraTestEnemyQuery::BuildTestSnapshot(World, PlayerIndex, Command.bFlagA, Snapshot);
+			if (bOk)
+			{
+				Snapshot.SerializeToBytes(SnapshotBytes);
+			}
+			Batch.AddResult(Command.Op, bOk, SnapshotBytes);
+			break;
+		}
+		case ELyraTestCommandOp::WaitFrames:
+			Batch.AddResult(Command.Op, true);
+			if (Command.Values[0] > 0)
+			{
+				Batch.FramesToWait = static_cast<int32>(FMath::Min<int64>(Command.Values[0], MAX_int32));
+				return;
+			}
+			break;
+		case ELyraTestCommandOp::FindKill:
+			Batch.AddResult(Command.Op, true, FindKillSince(Command.Values[0], Command.Values[1], Command.Values[2]));
+			break;
+		default:
+			Batch.AddResult(Command.Op, false);
+			break;
+		}
+	}
+}
+
+void ULyraTestSupportSubsystem::TickCommandBatches()
+{
+	for (TPair<int64, FLyraTestCommandBatch>& Pair : PendingCommandBatches)
+	{
+		FLyraTestCommandBatch& Batch = Pair.Value;
+		// A batch that started waiting earlier this frame counts its first frame on the next one.
+		if (Batch.IsComplete() || Batch.LastRunFrame == GFrameCounter)
+		{
+			continue;
+		}
+		Batch.LastRunFrame = GFrameCounter;
+		if (--Batch.FramesToWait <= 0)
+		{
+			RunCommandBatch(Batch);
+		}
 	}
 }
@@ -2,16 +2,67 @@
 
 #pragma once
 
+#include "GameFramework/GameplayMessageSubsystem.h"
 #include "Subsystems/GameInstanceSubsystem.h"
-#include "TimerManager.h"
+#include "Tickable.h"
+#include "Testing/LyraTestAimSolver.h"
+#include "Testing/LyraTestCommandBatch.h"
+#include "Testing/LyraTestEventStream.h"
+#include "Testing/LyraTestInputScheduler.h"
+#include "Testing/LyraTestPerfCapture.h"
+#include "Testing/LyraTestSnapshot.h"
+#include "Testing/LyraTestSupportAimTickComponent.h"
+#include "Testing/LyraTestTargetSelector.h"
+#include "Testing/LyraTestWorldReset.h"
+#include "UObject/ObjectKey.h"
 #include "LyraTestSupportSubsystem.generated.h"
 
+class AController;
+class APawn;
+class APlayerController;
+class UAbilitySystemComponent;
+class UGameInstance;
+class UGameplayAbility;
+class ULyraHealthSet;
+struct FGameplayEffectSpec;
+struct FLyraQuickBarActiveIndexChangedMessage;
+
+/** Per local player test state, indexed by local player index. */
+USTRUCT()
+struct FLyraTestPlayerSlot
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TWeakObjectPtr<ULyraTestSupportAimTickComponent> AimTickComponent;
+
+	FLyraTestSnapshot AimSnapshot;
+	FLyraTestTargetSelector TargetSelector;
+
+	/** Desired cheats, re-applied whenever the player's pawn, ability system or equipped weapon changes. */
+	bool bInvincible = false;
+	bool bInfiniteAmmo = false;
+	bool bContinuousAimFire = false;
+
+	/** Enemy most recently aimed at or selected for this player; may be stale. */
+	int64 LastTargetId = 0;
+};
+
 UCLASS(meta = (DisplayName = "Lyra Test Support"))
-class LYRAGAME_API ULyraTestSupportSubsystem : public UGameInstanceSubsystem
+class LYRAGAME_API ULyraTestSupportSubsystem : public UGameInstanceSubsystem, public FTickableGameObject
 {
 	GENERATED_BODY()
 
 public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual ETickableTickType GetTickableTickType() const override { return ETickableTickType::Conditional; }
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+
 	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
 	void SetLocalPlayerLookAtWorldPosition(float TargetX, float TargetY, float TargetZ);
 
@@ -27,9 +78,242 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
 	void SetLocalPlayerInfiniteAmmo(bool bEnable);
 
-	void TickContinuousAimFire();
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
+	void SetPlayerLookAtWorldPosition(int32 PlayerIndex, float TargetX, float TargetY, float TargetZ);
+
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
+	void SimulatePrimaryFireForPlayer(int32 PlayerIndex);
+
+	/** Frame-scheduled fire: ShotCount presses (0 = auto-fire until stopped), each held HoldFrames, one every IntervalFrames. */
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
+	void StartFirePattern(int32 PlayerIndex, int32 ShotCount = 0, int32 HoldFrames = 3, int32 IntervalFrames = 6);
+
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
+	void StopFirePattern(int32 PlayerIndex);
+
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
+	void SetContinuousAimFireEnabledForPlayer(int32 PlayerIndex, bool bEnabled);
+
+	/**
+	 * Cheats are kept as the player's desired state rather than applied once: they can be set before the pawn
+	 * exists and follow it through respawns, ability system re-init and weapon swaps. Infinite ammo refills
+	 * the weapons to their initial stats after each committed ability instead of stacking a large count.
+	 * On a network client both are sent to the server, which must run the load harness (ULyraTestNetComponent).
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
+	void SetPlayerInvincible(int32 PlayerIndex, bool bEnable);
+
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
+	void SetPlayerInfiniteAmmo(int32 PlayerIndex, bool bEnable);
+
+	/** Bit 0 invincible and bit 1 infinite ammo requested, bit 2 god mode currently active on the player's ability system. */
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
+	int32 GetPlayerCheatState(int32 PlayerIndex) const;
+
+	/** Aims the player at an alive enemy (TargetId from snapshots, 0 = best visible by the target selection settings) with lead and hit-box selection; false if none. */
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
+	bool AimPlayerAtEnemy(int32 PlayerIndex, int64 TargetId = 0);
+
+	/** Id of the enemy AimPlayerAtEnemy(PlayerIndex, 0) would aim at, or 0; line of sight resolves over a few frames. */
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
+	int64 SelectTargetForPlayer(int32 PlayerIndex);
+
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
+	void SetTargetSelectionSettings(float MaxDistance = 10000.f, float MaxAngleDegrees = 180.f, float DistanceWeight = 1.f, float AngleWeight = 1.f, float HealthWeight = 0.f, bool bRequireLineOfSight = true);
+
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
+	void SetAimSettings(ELyraTestAimPoint AimPoint, float ProjectileSpeed = 0.f, float ExtraLeadSeconds = 0.f);
+
+	/** Smoothly tracks an enemy (0 = selected target) every frame on the aim tick component; optionally fires while settled. */
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
+	bool StartAimTracking(int32 PlayerIndex, int64 TargetId = 0, bool bFireWhenSettled = false);
+
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
+	bool StartAimTrackingWorldPosition(int32 PlayerIndex, float TargetX, float TargetY, float TargetZ, bool bFireWhenSettled = false);
+
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
+	void StopAimTracking(int32 PlayerIndex);
+
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
+	bool IsAimSettled(int32 PlayerIndex) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
+	void SetAimControllerSettings(float SmoothTimeSeconds = 0.08f, float MaxAngularSpeedDegrees = 720.f, float SettleThresholdDegrees = 0.5f);
+
+	/**
+	 * Fast-forward: fixed FixedDeltaSeconds steps with no frame rate cap, and game time dilated by TimeDilation
+	 * (clamped by the world settings), so the game simulates as fast as the CPU allows. Aim, fire and batch
+	 * waits run off game time and frames, so they behave the same; disabling restores the previous engine timing.
+	 * The fixed step is shared by every world in the process; the dilation is per world.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
+	void SetFastForwardEnabled(bool bEnable, float FixedDeltaSeconds = 0.0166667f, float TimeDilation = 1.f);
+
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
+	bool IsFastForwardEnabled() const { return bFastForward; }
+
+	/** Game seconds simulated since fast-forward was enabled. */
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
+	double GetFastForwardSimulatedSeconds() const { return FastForwardSimulatedSeconds; }
+
+	/** Simulated game seconds per real second since fast-forward was enabled; 0 when disabled. */
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
+	double GetSimulatedTimeRatio() const;
+
+	/** Batched variants: bit N of PlayerMask selects local player index N. */
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
+	void SimulatePrimaryFireForPlayers(int32 PlayerMask);
+
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
+	void SetContinuousAimFireEnabledForPlayers(int32 PlayerMask, bool bEnabled);
+
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
+	void SetTestCheatsForPlayers(int32 PlayerMask, bool bInvincible, bool bInfiniteAmmo);
+
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
+	int32 GetLocalPlayerCount() const;
+
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
+	int64 GetLatestCombatSequence() const;
+
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
+	TArray<FLyraTestCombatRecord> GetCombatLogSince(int64 SinceSequence, int32 MaxRecords = 0) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
+	FString GetCombatLogSinceBase64(int64 SinceSequence, int32 MaxRecords = 0) const;
+
+	/** Sequence of the first kill after SinceSequence matching VictimId / InstigatorId (0 = any), or 0 if none. */
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
+	int64 FindKillSince(int64 SinceSequence, int64 VictimId = 0, int64 InstigatorId = 0) const;
+
+	/** Runs a command list (see LyraTestCommandBatch) for one local player and returns the packed results as base64, or empty for a bad player index. */
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
+	FString ExecuteCommandBatch(int32 PlayerIndex, const FString& Commands);
+
+	/** Results of a batch that was still waiting frames when ExecuteCommandBatch returned; forgotten once returned complete. */
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
+	FString GetCommandBatchResults(int64 BatchId);
+
+	/**
+	 * Puts the loaded map back into a known state without reloading it (see FLyraTestWorldReset). Also stops
+	 * every aim, fire and command batch of this subsystem, and on success clears the combat log and re-applies
+	 * player cheats. Completion publishes a WorldReset event with Value = the returned id. Supersedes a reset in progress.
+	 * Returns 0 without resetting when Settings.PlayerIndex is not a local player.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
+	int64 ResetWorld(const FLyraTestWorldResetSettings& Settings);
+
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
+	bool IsWorldResetRunning() const { return WorldReset.IsRunning(); }
+
+	/** Result of the latest reset; bComplete is false while it runs. */
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
+	FLyraTestWorldResetResult GetWorldResetResult() const { return WorldReset.GetResult(); }
+
+	/**
+	 * Starts recording frame, thread and GPU times, GC pauses, hitches over HitchThresholdMs and the memory
+	 * high-water mark every frame until EndPerfCapture (see FLyraTestPerfCapture). Supersedes a capture in progress.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
+	void BeginPerfCapture(const FString& Name, float HitchThresholdMs = 50.f);
+
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
+	FLyraTestPerfCaptureResult EndPerfCapture();
+
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
+	bool IsPerfCaptureRunning() const { return PerfCapture.IsRunning(); }
+
+	/** Gates Result on <BaselineDirectory>/<Name>.perfbaseline.json (empty directory: Build/PerfBaselines); a missing baseline passes. */
+	UFUNCTION(BlueprintCallable, Category = "Test|Automation")
+	FLyraTestPerfComparison ComparePerfCaptureToBaseline(const FLyraTestPerfCaptureResult& Result, const FString& BaselineDirectory, const FLyraTestPerfGateSettings& Gate) const;
+
+	void TickContinuousAimFire(int32 PlayerIndex);
+
+	/** Lead-aimed point on TargetId (0 = selected target) for the player; false when there is no target. */
+	bool SolvePlayerAimPoint(int32 PlayerIndex, int64 TargetId, FVector& OutAimPoint);
+
+	/** Control rotation that puts the player's camera on AimPoint, pitch-clamped. */
+	bool ComputePlayerLookAtRotation(int32 PlayerIndex, const FVector& AimPoint, FRotator& OutRotation) const;
+
+	/**
+	 * Re-applies the cheats wanted for Controller: a local player's slot (sent to the server from a network
+	 * client) or, on the server, what a remote client requested through its ULyraTestNetComponent.
+	 */
+	void ApplyControllerCheats(const AController* Controller);
+
+	/** Hooks the pawn's ability system for the combat log and the player's cheats. */
+	void TrackCombatPawn(APawn* Pawn);
+
+	APlayerController* GetLocalPlayerController(int32 PlayerIndex) const;
+
+	/** Handle of the enemy the player last aimed at or selected, 0 if none yet. */
+	int64 GetPlayerTargetId(int32 PlayerIndex) const;
+
+	static APlayerController* FindLocalPlayerController(const UGameInstance* GI, int32 PlayerIndex);
 
 private:
-	FTimerHandle ContinuousAimFireHandle;
-	TWeakObjectPtr<class ULyraTestSupportAimTickComponent> ContinuousAimTickComponent;
+	UFUNCTION()
+	void HandlePawnControllerChanged(APawn* Pawn, AController* Controller);
+
+	void HandlePawnAbilitySystemInitialized(TWeakObjectPtr<APawn> WeakPawn);
+	void HandleAbilityCommitted(UGameplayAbility* Ability);
+	void HandleQuickBarActiveIndexChanged(FGameplayTag Channel, const FLyraQuickBarActiveIndexChangedMessage& Message);
+	void HandleCombatHealthChanged(AActor* EffectInstigator, AActor* EffectCauser, const FGameplayEffectSpec* EffectSpec, float EffectMagnitude, float OldValue, float NewValue, TWeakObjectPtr<const ULyraHealthSet> WeakHealthSet);
+
+	/** Public entry points take player indices from the driver; slots and input channels are only grown for these. */
+	bool IsLocalPlayerIndex(int32 PlayerIndex) const;
+	FLyraTestPlayerSlot& GetPlayerSlot(int32 PlayerIndex);
+	int32 FindLocalPlayerIndex(const AController* Controller) const;
+	void ApplyPlayerCheats(int32 PlayerIndex);
+	bool RouteCheatsToServer(int32 PlayerIndex);
+	bool GetDesiredCheats(const AController* Controller, bool& bOutInvincible, bool& bOutInfiniteAmmo) const;
+	void ApplyCheatsToPawn(APawn* Pawn);
+	const FLyraTestSnapshotRecord* FindPlayerTarget(int32 PlayerIndex, int64 TargetId, FVector& OutViewLocation);
+	void SetPlayerTarget(FLyraTestPlayerSlot& Slot, int32 PlayerIndex, const FLyraTestSnapshotRecord& Target);
+	void TickInputScheduler();
+	void ApplyFireInputEdge(int32 PlayerIndex, ELyraTestInputEdge Edge);
+
+	ULyraTestSupportAimTickComponent* GetOrCreateAimTickComponent(int32 PlayerIndex);
+	void ReleaseAimTickComponentIfIdle(int32 PlayerIndex);
+
+	void RunCommandBatch(FLyraTestCommandBatch& Batch);
+	void TickCommandBatches();
+	void TickFastForward(float DeltaTime);
+	void FinishWorldReset();
+
+	UPROPERTY(Transient)
+	TArray<FLyraTestPlayerSlot> PlayerSlots;
+
+	UPROPERTY(Transient)
+	FLyraTestAimSettings AimSettings;
+
+	UPROPERTY(Transient)
+	FLyraTestTargetSelectionSettings TargetSelectionSettings;
+
+	UPROPERTY(Transient)
+	FLyraTestAimControllerSettings AimControllerSettings;
+
+	TLyraTestSequencedRing<FLyraTestCombatRecord> CombatLog{2048};
+	TSet<TObjectKey<ULyraHealthSet>> CombatBoundHealthSets;
+	TSet<TObjectKey<UAbilitySystemComponent>> CheatBoundAbilitySystems;
+	FGameplayMessageListenerHandle QuickBarListenerHandle;
+
+	FLyraTestInputScheduler InputScheduler;
+
+	bool bFastForward = false;
+	// Subsystems of all worlds in the process that have fast-forward on, and the engine timing from before the first.
+	static int32 FastForwardUsers;
+	static bool FastForwardPrevUseFixedTimeStep;
+	static double FastForwardPrevFixedDeltaTime;
+	float FastForwardTimeDilation = 1.f;
+	double FastForwardSimulatedSeconds = 0.0;
+	double FastForwardRealStartSeconds = 0.0;
+
+	TMap<int64, FLyraTestCommandBatch> PendingCommandBatches;
+	int64 LastCommandBatchId = 0;
+
+	FLyraTestWorldReset WorldReset;
+	int64 LastWorldResetId = 0;
+
+	FLyraTestPerfCapture PerfCapture;
 };
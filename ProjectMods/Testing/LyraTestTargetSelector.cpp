@@ -0,0 +1,130 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Testing/LyraTestTargetSelector.h"
+#include "Testing/LyraTestSnapshot.h"
+#include "Testing/LyraTestStats.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Physics/LyraCollisionChannels.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(LyraTestTargetSelector)
+
+// Entries for targets not seen in a snapshot for this many frames are dropped (dead, despawned or culled).
+static constexpr uint64 StaleVisibilityFrames = 120;
+
+const FLyraTestSnapshotRecord* FLyraTestTargetSelector::SelectTarget(UWorld* World, const AActor* Viewer, const FVector& ViewLocation, const FRotator& ViewRotation,
+	const FLyraTestSnapshot& Snapshot, const FLyraTestTargetSelectionSettings& Settings)
+{
+	LYRA_TEST_SCOPE(SelectTarget);
+	if (!World)
+	{
+		return nullptr;
+	}
+	CollectTraceResults(World);
+
+	const uint64 Frame = GFrameCounter;
+	const FVector ViewDirection = ViewRotation.Vector();
+	const double MaxDistance = FMath::Max(Settings.MaxDistance, 1.f);
+	const double CosMaxAngle = Settings.MaxAngleDegrees >= 180.f ? -1.0 : FMath::Cos(FMath::DegreesToRadians(Settings.MaxAngleDegrees));
+	const double RetraceDistanceSq = FMath::Square(Settings.RetraceDistance);
+
+	const FLyraTestSnapshotRecord* BestVisible = nullptr;
+	const FLyraTestSnapshotRecord* BestUnknown = nullptr;
+	double BestVisibleScore = TNumericLimits<double>::Max();
+	double BestUnknownScore = TNumericLimits<double>::Max();
+
+	for (const FLyraTestSnapshotRecord& Record : Snapshot.Records)
+	{
+		if (Record.Kind != ELyraTestSnapshotRecordKind::Enemy || !Record.bAlive)
+		{
+			continue;
+		}
+
+		// Cheap culls before anything touches the physics scene.
+		const FVector ToTarget = Record.Position - ViewLocation;
+		const double Distance = ToTarget.Size();
+		if (Distance > MaxDistance)
+		{
+			continue;
+		}
+		const double CosAngle = Distance > UE_KINDA_SMALL_NUMBER ? FVector::DotProduct(ToTarget / Distance, ViewDirection) : 1.0;
+		if (CosAngle < CosMaxAngle)
+		{
+			continue;
+		}
+
+		FVisibilityEntry& Entry = Visibility.FindOrAdd(Record.Id);
+		Entry.LastSeenFrame = Frame;
+		if (Settings.bRequireLineOfSight && !Entry.PendingTrace.IsValid())
+		{
+			const bool bStale = Entry.State == EVisibility::Unknown
+				|| Frame - Entry.TracedFrame >= static_cast<uint64>(FMath::Max(Settings.MaxCacheFrames, 1))
+				|| FVector::DistSquared(Entry.TracedFrom, ViewLocation) > RetraceDistanceSq
+				|| FVector::DistSquared(Entry.TracedTo, Record.Position) > RetraceDistanceSq;
+			if (bStale)
+			{
+				RequestTrace(World, Viewer, Record, ViewLocation, Entry);
+			}
+		}
+
+		const double HealthFraction = Record.MaxHealth > 0.f ? Record.Health / Record.MaxHealth : 1.0;
+		const double Score = Settings.DistanceWeight * (Distance / MaxDistance)
+			+ Settings.AngleWeight * (FMath::Acos(FMath::Clamp(CosAngle, -1.0, 1.0)) / UE_DOUBLE_PI)
+			+ Settings.HealthWeight * HealthFraction;
+
+		if (!Settings.bRequireLineOfSight || Entry.State == EVisibility::Visible)
+		{
+			if (Score < BestVisibleScore)
+			{
+				BestVisibleScore = Score;
+				BestVisible = &Record;
+			}
+		}
+		else if (Entry.State == EVisibility::Unknown && Score < BestUnknownScore)
+		{
+			BestUnknownScore = Score;
+			BestUnknown = &Record;
+		}
+	}
+	return BestVisible ? BestVisible : BestUnknown;
+}
+
+void FLyraTestTargetSelector::CollectTraceResults(UWorld* World)
+{
+	const uint64 Frame = GFrameCounter;
+	for (auto It = Visibility.CreateIterator(); It; ++It)
+	{
+		FVisibilityEntry& Entry = It.Value();
+		if (Entry.PendingTrace.IsValid())
+		{
+			FTraceDatum Datum;
+			if (World->QueryTraceData(Entry.PendingTrace, Datum))
+			{
+				const bool bBlocked = Datum.OutHits.ContainsByPredicate([](const FHitResult& Hit) { return Hit.bBlockingHit; });
+				Entry.State = bBlocked ? EVisibility::Blocked : EVisibility::Visible;
+				Entry.PendingTrace.Invalidate();
+			}
+			else if (!World->IsTraceHandleValid(Entry.PendingTrace, false))
+			{
+				// Result expired before we asked for it; the next selection traces again.
+				Entry.PendingTrace.Invalidate();
+			}
+		}
+		if (Frame - Entry.LastSeenFrame > StaleVisibilityFrames)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void FLyraTestTargetSelector::RequestTrace(UWorld* World, const AActor* Viewer, const FLyraTestSnapshotRecord& Record, const FVector& ViewLocation, FVisibilityEntry& Entry)
+{
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(LyraTestTargetVisibility), false);
+	Params.AddIgnoredActor(Viewer);
+	Params.AddIgnoredActor(Record.Actor.Get());
+
+	Entry.PendingTrace = World->AsyncLineTraceByChannel(EAsyncTraceType::Single, ViewLocation, Record.Position, Lyra_TraceChannel_Weapon, Params);
+	Entry.TracedFrom = ViewLocation;
+	Entry.TracedTo = Record.Position;
+	Entry.TracedFrame = GFrameCounter;
+}
@@ -0,0 +1,83 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Engine/EngineTypes.h"
+#include "WorldCollision.h"
+#include "LyraTestTargetSelector.generated.h"
+
+class AActor;
+class UWorld;
+struct FLyraTestSnapshot;
+struct FLyraTestSnapshotRecord;
+
+USTRUCT(BlueprintType)
+struct LYRAGAME_API FLyraTestTargetSelectionSettings
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	float MaxDistance = 10000.f;
+
+	/** Half angle of the view cone targets must be inside; 180 disables the cull. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	float MaxAngleDegrees = 180.f;
+
+	/** Score = weighted sum of normalized distance, angle off crosshair and health fraction; lowest wins. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	float DistanceWeight = 1.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	float AngleWeight = 1.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	float HealthWeight = 0.f;
+
+	/** When set, targets whose last trace was blocked are skipped; untraced targets are only used if nothing is known visible. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	bool bRequireLineOfSight = true;
+
+	/** Viewer or target movement (cm) after which a cached visibility result is traced again. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	float RetraceDistance = 25.f;
+
+	/** Frames a cached visibility result stays valid even if nothing moved. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	int32 MaxCacheFrames = 10;
+};
+
+/**
+ * Picks the best enemy from a snapshot for one local player: distance and view-cone culling first, then
+ * line of sight from async weapon-channel traces whose results are cached per target across frames.
+ */
+class LYRAGAME_API FLyraTestTargetSelector
+{
+public:
+	const FLyraTestSnapshotRecord* SelectTarget(UWorld* World, const AActor* Viewer, const FVector& ViewLocation, const FRotator& ViewRotation,
+		const FLyraTestSnapshot& Snapshot, const FLyraTestTargetSelectionSettings& Settings);
+
+	void Reset() { Visibility.Reset(); }
+
+private:
+	enum class EVisibility : uint8
+	{
+		Unknown,
+		Visible,
+		Blocked
+	};
+
+	struct FVisibilityEntry
+	{
+		EVisibility State = EVisibility::Unknown;
+		FVector TracedFrom = FVector::ZeroVector;
+		FVector TracedTo = FVector::ZeroVector;
+		uint64 TracedFrame = 0;
+		uint64 LastSeenFrame = 0;
+		FTraceHandle PendingTrace;
+	};
+
+	void CollectTraceResults(UWorld* World);
+	void RequestTrace(UWorld* World, const AActor* Viewer, const FLyraTestSnapshotRecord& Record, const FVector& ViewLocation, FVisibilityEntry& Entry);
+
+	TMap<int64, FVisibilityEntry> Visibility;
+};
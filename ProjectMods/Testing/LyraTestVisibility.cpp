@@ -0,0 +1,154 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Testing/LyraTestVisibility.h"
+#include "Testing/LyraTestSnapshot.h"
+#include "Testing/LyraTestStats.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Engine/GameViewportClient.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Physics/LyraCollisionChannels.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(LyraTestVisibility)
+
+static_assert(PLATFORM_LITTLE_ENDIAN, "LyraTestVisibility wire format is written little endian.");
+
+template <typename T>
+static FORCEINLINE void WriteVisibilityValue(uint8* Dest, int32 Offset, T Value)
+{
+	FMemory::Memcpy(Dest + Offset, &Value, sizeof(T));
+}
+
+static FVector2D GetPlayerViewportSize(const APlayerController* PC)
+{
+	const ULocalPlayer* LP = PC->GetLocalPlayer();
+	if (!LP || !LP->ViewportClient)
+	{
+		return FVector2D::ZeroVector;
+	}
+	FVector2D FullSize;
+	LP->ViewportClient->GetViewportSize(FullSize);
+	return FullSize * LP->Size;
+}
+
+void FLyraTestVisibility::Evaluate(const APlayerController* PC, const FLyraTestSnapshot& Snapshot)
+{
+	LYRA_TEST_SCOPE(Visibility);
+	Records.Reset();
+	FrameNumber = Snapshot.FrameNumber;
+	ViewportSize = FVector2D::ZeroVector;
+	UWorld* World = PC ? PC->GetWorld() : nullptr;
+	if (!World)
+	{
+		return;
+	}
+
+	FVector ViewLocation;
+	FRotator ViewRotation;
+	if (PC->PlayerCameraManager)
+	{
+		PC->PlayerCameraManager->GetCameraViewPoint(ViewLocation, ViewRotation);
+	}
+	else
+	{
+		PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+	}
+	ViewportSize = GetPlayerViewportSize(PC);
+	const FVector2D Crosshair = ViewportSize * 0.5f;
+	const FBox2D Viewport(FVector2D::ZeroVector, ViewportSize);
+
+	// One query setup for the whole batch: a hit on anything other than the target itself counts as occlusion.
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(LyraTestVisibility), false);
+	Params.AddIgnoredActor(PC->GetPawn());
+
+	Records.Reserve(Snapshot.Records.Num());
+	for (const FLyraTestSnapshotRecord& SnapshotRecord : Snapshot.Records)
+	{
+		if (SnapshotRecord.Kind == ELyraTestSnapshotRecordKind::Player)
+		{
+			continue;
+		}
+		FLyraTestVisibilityRecord& Record = Records.AddDefaulted_GetRef();
+		Record.Id = SnapshotRecord.Id;
+		Record.bStale = SnapshotRecord.bStale;
+		const AActor* Actor = SnapshotRecord.Actor.Get();
+		if (!Actor)
+		{
+			continue;
+		}
+		Record.Position = SnapshotRecord.Position;
+		Record.Distance = FVector::Dist(ViewLocation, Record.Position);
+
+		const FRotator Offset = ((Record.Position - ViewLocation).Rotation() - ViewRotation).GetNormalized();
+		Record.CrosshairYawDegrees = Offset.Yaw;
+		Record.CrosshairPitchDegrees = Offset.Pitch;
+
+		// Player viewport relative, so split-screen players get coordinates inside their own view.
+		FVector2D Screen;
+		if (PC->ProjectWorldLocationToScreen(Record.Position, Screen, true))
+		{
+			Record.bProjected = true;
+			Record.ScreenPosition = Screen;
+			Record.bOnScreen = Viewport.bIsValid && Viewport.IsInside(Screen);
+			Record.CrosshairOffsetPixels = FVector2D::Distance(Screen, Crosshair);
+
+			FVector Origin;
+			FVector Extent;
+			Actor->GetActorBounds(true, Origin, Extent);
+			FVector Corners[8];
+			FBox(Origin - Extent, Origin + Extent).GetVertices(Corners);
+			for (const FVector& Corner : Corners)
+			{
+				if (PC->ProjectWorldLocationToScreen(Corner, Screen, true))
+				{
+					Record.ScreenBounds += Screen;
+				}
+			}
+		}
+
+		FHitResult Hit;
+		Record.bOccluded = World->LineTraceSingleByChannel(Hit, ViewLocation, Record.Position, Lyra_TraceChannel_Weapon, Params) && Hit.GetActor() != Actor;
+	}
+}
+
+void FLyraTestVisibility::SerializeToBytes(TArray<uint8>& OutBytes) const
+{
+	using namespace LyraTestVisibility;
+
+	OutBytes.Reset();
+	OutBytes.AddZeroed(HeaderSize + Records.Num() * RecordStride);
+	uint8* Data = OutBytes.GetData();
+
+	WriteVisibilityValue<uint32>(Data, 0, Magic);
+	WriteVisibilityValue<uint16>(Data, 4, Version);
+	WriteVisibilityValue<uint16>(Data, 6, static_cast<uint16>(RecordStride));
+	WriteVisibilityValue<uint32>(Data, 8, static_cast<uint32>(Records.Num()));
+	WriteVisibilityValue<float>(Data, 12, static_cast<float>(ViewportSize.X));
+	WriteVisibilityValue<float>(Data, 16, static_cast<float>(ViewportSize.Y));
+	WriteVisibilityValue<uint64>(Data, 24, static_cast<uint64>(FrameNumber));
+
+	uint8* RecordData = Data + HeaderSize;
+	for (const FLyraTestVisibilityRecord& Record : Records)
+	{
+		const uint8 Flags = (Record.bProjected ? RecordFlag_Projected : 0) | (Record.bOnScreen ? RecordFlag_OnScreen : 0)
+			| (Record.bOccluded ? RecordFlag_Occluded : 0) | (Record.bStale ? RecordFlag_Stale : 0);
+		const FBox2D Bounds = Record.ScreenBounds.bIsValid ? Record.ScreenBounds : FBox2D(Record.ScreenPosition, Record.ScreenPosition);
+		WriteVisibilityValue<int64>(RecordData, 0, Record.Id);
+		WriteVisibilityValue<uint8>(RecordData, 8, Flags);
+		WriteVisibilityValue<float>(RecordData, 12, Record.Distance);
+		WriteVisibilityValue<double>(RecordData, 16, Record.Position.X);
+		WriteVisibilityValue<double>(RecordData, 24, Record.Position.Y);
+		WriteVisibilityValue<double>(RecordData, 32, Record.Position.Z);
+		WriteVisibilityValue<float>(RecordData, 40, static_cast<float>(Record.ScreenPosition.X));
+		WriteVisibilityValue<float>(RecordData, 44, static_cast<float>(Record.ScreenPosition.Y));
+		WriteVisibilityValue<float>(RecordData, 48, static_cast<float>(Bounds.Min.X));
+		WriteVisibilityValue<float>(RecordData, 52, static_cast<float>(Bounds.Min.Y));
+		WriteVisibilityValue<float>(RecordData, 56, static_cast<float>(Bounds.Max.X));
+		WriteVisibilityValue<float>(RecordData, 60, static_cast<float>(Bounds.Max.Y));
+		WriteVisibilityValue<float>(RecordData, 64, Record.CrosshairOffsetPixels);
+		WriteVisibilityValue<float>(RecordData, 68, Record.CrosshairYawDegrees);
+		WriteVisibilityValue<float>(RecordData, 72, Record.CrosshairPitchDegrees);
+		RecordData += RecordStride;
+	}
+}
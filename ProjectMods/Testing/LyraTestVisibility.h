@@ -0,0 +1,105 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LyraTestVisibility.generated.h"
+
+class APlayerController;
+struct FLyraTestSnapshot;
+
+/** Where one snapshot record is on the local player's screen, all values from the same frame. */
+USTRUCT(BlueprintType)
+struct LYRAGAME_API FLyraTestVisibilityRecord
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	int64 Id = 0;
+
+	/** Projected in front of the camera; the screen values are only meaningful when set. */
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	bool bProjected = false;
+
+	/** Projected position is inside the viewport. */
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	bool bOnScreen = false;
+
+	/** Weapon trace from the camera to the target hit something else. */
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	bool bOccluded = false;
+
+	/** Requested by a handle whose object has been destroyed. */
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	bool bStale = false;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	FVector Position = FVector::ZeroVector;
+
+	/** From the camera. */
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	float Distance = 0.f;
+
+	/** Viewport pixels. */
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	FVector2D ScreenPosition = FVector2D::ZeroVector;
+
+	/** Viewport pixel bounds of the projected collision bounds corners that are in front of the camera. */
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	FBox2D ScreenBounds = FBox2D(ForceInit);
+
+	/** Pixels from the viewport center (the crosshair) to ScreenPosition. */
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	float CrosshairOffsetPixels = 0.f;
+
+	/** View-relative yaw / pitch to the target, in degrees; valid behind the camera too. */
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	float CrosshairYawDegrees = 0.f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	float CrosshairPitchDegrees = 0.f;
+
+	bool IsVisible() const { return bOnScreen && !bOccluded; }
+};
+
+// Packed wire layout (little endian), see LyraTestVisibility::HeaderSize / RecordStride:
+//   Header  [0]  uint32 Magic 'LTVS'  [4] uint16 Version  [6] uint16 RecordStride  [8] uint32 RecordCount
+//           [12] float ViewportSize[2]  [20] uint32 Reserved  [24] uint64 FrameNumber
+//   Record  [0]  int64 Id  [8] uint8 Flags (bit0 = projected, bit1 = on screen, bit2 = occluded, bit3 = stale)  [9] uint8 Reserved[3]
+//           [12] float Distance  [16] double Position[3]  [40] float ScreenPosition[2]  [48] float ScreenBounds Min[2] Max[2]
+//           [64] float CrosshairOffsetPixels  [68] float CrosshairYawDegrees  [72] float CrosshairPitchDegrees  [76] uint32 Reserved
+USTRUCT(BlueprintType)
+struct LYRAGAME_API FLyraTestVisibility
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	int64 FrameNumber = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	FVector2D ViewportSize = FVector2D::ZeroVector;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	TArray<FLyraTestVisibilityRecord> Records;
+
+	/**
+	 * Projects every non-player record of Snapshot through the controller's view and traces them on the weapon
+	 * channel, all in the calling frame. Records without an actor are kept (stale ones flagged) so results line
+	 * up with requested handles.
+	 */
+	void Evaluate(const APlayerController* PC, const FLyraTestSnapshot& Snapshot);
+
+	void SerializeToBytes(TArray<uint8>& OutBytes) const;
+};
+
+namespace LyraTestVisibility
+{
+	static constexpr uint32 Magic = 0x5356544C; // "LTVS"
+	static constexpr uint16 Version = 1;
+	static constexpr int32 HeaderSize = 32;
+	static constexpr int32 RecordStride = 80;
+	static constexpr uint8 RecordFlag_Projected = 1 << 0;
+	static constexpr uint8 RecordFlag_OnScreen = 1 << 1;
+	static constexpr uint8 RecordFlag_Occluded = 1 << 2;
+	static constexpr uint8 RecordFlag_Stale = 1 << 3;
+}
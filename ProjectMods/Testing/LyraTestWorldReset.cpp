@@ -0,0 +1,336 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Testing/LyraTestWorldReset.h"
+#include "AbilitySystem/Attributes/LyraHealthSet.h"
+#include "AbilitySystem/LyraAbilitySystemComponent.h"
+#include "Character/LyraHealthComponent.h"
+#include "Character/LyraPawnExtensionComponent.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "Equipment/LyraEquipmentManagerComponent.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerStart.h"
+#include "GameModes/LyraBotCreationComponent.h"
+#include "GameModes/LyraGameMode.h"
+#include "GameplayTagsManager.h"
+#include "Inventory/InventoryFragment_SetStats.h"
+#include "Inventory/LyraInventoryItemInstance.h"
+#include "Player/LyraPlayerState.h"
+#include "Teams/LyraTeamSubsystem.h"
+#include "Weapons/LyraRangedWeaponInstance.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(LyraTestWorldReset)
+
+static const FName AmmoTagNames[] = {
+	TEXT("Lyra.ShooterGame.Weapon.MagazineAmmo"),
+	TEXT("Lyra.ShooterGame.Weapon.SpareAmmo")
+};
+
+static int32 CountBots(const AGameStateBase* GameState)
+{
+	int32 NumBots = 0;
+	for (const APlayerState* PlayerState : GameState->PlayerArray)
+	{
+		if (IsValid(PlayerState) && PlayerState->IsABot())
+		{
+			++NumBots;
+		}
+	}
+	return NumBots;
+}
+
+void FLyraTestWorldReset::Begin(UWorld* World, int64 ResetId, const FLyraTestWorldResetSettings& InSettings, APlayerController* InPlayerController)
+{
+	Settings = InSettings;
+	Result = FLyraTestWorldResetResult();
+	Result.ResetId = ResetId;
+	PlayerController = InPlayerController;
+	PendingControllers.Reset();
+	BeginFrame = GFrameCounter;
+	bRunning = true;
+
+	AGameStateBase* GameState = World ? World->GetGameState() : nullptr;
+	if (!GameState || !World->GetAuthGameMode())
+	{
+		Finish(TEXT("World reset needs the authority world"));
+		return;
+	}
+
+	SetBotCount(World);
+	if (!bRunning)
+	{
+		return;
+	}
+	ApplyTeams(World);
+	ResetScores(World);
+
+	// Removed bots leave the player array while we walk it.
+	const TArray<TObjectPtr<APlayerState>> PlayerStates = GameState->PlayerArray;
+	for (APlayerState* PlayerState : PlayerStates)
+	{
+		if (AController* Controller = IsValid(PlayerState) ? PlayerState->GetOwningController() : nullptr)
+		{
+			ResetController(World, Controller);
+		}
+	}
+}
+
+bool FLyraTestWorldReset::Tick(UWorld* World)
+{
+	if (!bRunning)
+	{
+		return false;
+	}
+	if (!World)
+	{
+		Finish(TEXT("World went away during the reset"));
+		return true;
+	}
+
+	for (int32 Index = PendingControllers.Num() - 1; Index >= 0; --Index)
+	{
+		AController* Controller = PendingControllers[Index].Get();
+		if (!Controller)
+		{
+			PendingControllers.RemoveAtSwap(Index);
+			continue;
+		}
+		APawn* Pawn = Controller->GetPawn();
+		const ULyraPawnExtensionComponent* PawnExt = ULyraPawnExtensionComponent::FindPawnExtensionComponent(Pawn);
+		if (!Pawn || (PawnExt && !PawnExt->GetLyraAbilitySystemComponent()))
+		{
+			continue;
+		}
+		if (Controller == PlayerController.Get() && Settings.PlayerStartIndex >= 0)
+		{
+			PlaceAt(Pawn, Controller, FindStart(World, Controller));
+		}
+		PendingControllers.RemoveAtSwap(Index);
+	}
+
+	if (PendingControllers.IsEmpty())
+	{
+		Finish();
+		return true;
+	}
+	if (GFrameCounter - BeginFrame > static_cast<uint64>(FMath::Max(Settings.MaxFrames, 1)))
+	{
+		Finish(FString::Printf(TEXT("%d pawns not ready within %d frames"), PendingControllers.Num(), Settings.MaxFrames));
+		return true;
+	}
+	return false;
+}
+
+void FLyraTestWorldReset::SetBotCount(UWorld* World)
+{
+	if (Settings.BotCount < 0)
+	{
+		return;
+	}
+	AGameStateBase* GameState = World->GetGameState();
+	int32 NumBots = CountBots(GameState);
+	if (NumBots == Settings.BotCount)
+	{
+		return;
+	}
+#if WITH_SERVER_CODE
+	ULyraBotCreationComponent* BotComponent = GameState->FindComponentByClass<ULyraBotCreationComponent>();
+	if (!BotComponent)
+	{
+		Finish(TEXT("Experience has no bot creation component"));
+		return;
+	}
+	// Added bots spawn and possess immediately; removed ones are killed and their controllers destroyed.
+	for (; NumBots > Settings.BotCount; --NumBots)
+	{
+		BotComponent->Cheat_RemoveBot();
+		++Result.RemovedBots;
+	}
+	for (; NumBots < Settings.BotCount; ++NumBots)
+	{
+		BotComponent->Cheat_AddBot();
+		++Result.AddedBots;
+	}
+#else
+	Finish(TEXT("Changing the bot count needs server code"));
+#endif
+}
+
+void FLyraTestWorldReset::ApplyTeams(UWorld* World)
+{
+	ULyraTeamSubsystem* TeamSubsystem = World->GetSubsystem<ULyraTeamSubsystem>();
+	if (!TeamSubsystem)
+	{
+		return;
+	}
+	if (Settings.PlayerTeamId >= 0 && PlayerController.IsValid() && TeamSubsystem->FindTeamFromObject(PlayerController.Get()) != Settings.PlayerTeamId)
+	{
+		TeamSubsystem->ChangeTeamForActor(PlayerController.Get(), Settings.PlayerTeamId);
+	}
+	if (Settings.BotTeamIds.IsEmpty())
+	{
+		return;
+	}
+	int32 BotIndex = 0;
+	for (APlayerState* PlayerState : World->GetGameState()->PlayerArray)
+	{
+		if (!IsValid(PlayerState) || !PlayerState->IsABot())
+		{
+			continue;
+		}
+		const int32 TeamId = Settings.BotTeamIds[BotIndex++ % Settings.BotTeamIds.Num()];
+		if (TeamSubsystem->FindTeamFromObject(PlayerState) != TeamId)
+		{
+			TeamSubsystem->ChangeTeamForActor(PlayerState, TeamId);
+		}
+	}
+}
+
+void FLyraTestWorldReset::ResetScores(UWorld* World)
+{
+	ULyraTeamSubsystem* TeamSubsystem = World->GetSubsystem<ULyraTeamSubsystem>();
+	const TArray<int32> TeamIds = TeamSubsystem ? TeamSubsystem->GetTeamIDs() : TArray<int32>();
+	for (const FString& TagName : Settings.ScoreTags)
+	{
+		const FGameplayTag Tag = UGameplayTagsManager::Get().RequestGameplayTag(FName(*TagName), false);
+		if (!Tag.IsValid())
+		{
+			continue;
+		}
+		for (int32 TeamId : TeamIds)
+		{
+			if (const int32 Count = TeamSubsystem->GetTeamTagStackCount(TeamId, Tag))
+			{
+				TeamSubsystem->RemoveTeamTagStack(TeamId, Tag, Count);
+			}
+		}
+		for (APlayerState* PlayerState : World->GetGameState()->PlayerArray)
+		{
+			ALyraPlayerState* LyraPlayerState = Cast<ALyraPlayerState>(PlayerState);
+			if (const int32 Count = LyraPlayerState ? LyraPlayerState->GetStatTagStackCount(Tag) : 0)
+			{
+				LyraPlayerState->RemoveStatTagStack(Tag, Count);
+			}
+		}
+	}
+}
+
+void FLyraTestWorldReset::ResetController(UWorld* World, AController* Controller)
+{
+	APawn* Pawn = Controller->GetPawn();
+	if (IsValid(Pawn))
+	{
+		const ULyraHealthComponent* Health = ULyraHealthComponent::FindHealthComponent(Pawn);
+		if (!Health || !Health->IsDeadOrDying())
+		{
+			const ULyraPawnExtensionComponent* PawnExt = ULyraPawnExtensionComponent::FindPawnExtensionComponent(Pawn);
+			if (PawnExt && !PawnExt->GetLyraAbilitySystemComponent())
+			{
+				// Still initializing (e.g. a bot added above); the game mode already placed it at a start.
+				PendingControllers.Add(Controller);
+				return;
+			}
+			RestoreHealthAndAmmo(Pawn);
+			PlaceAt(Pawn, Controller, FindStart(World, Controller));
+			++Result.ReusedPawns;
+			return;
+		}
+		// Not worth waiting out the death ability; drop the pawn the way Lyra's own respawn does.
+		Controller->UnPossess();
+		Pawn->Destroy();
+	}
+
+	if (ALyraGameMode* GameMode = World->GetAuthGameMode<ALyraGameMode>())
+	{
+		GameMode->RequestPlayerRestartNextFrame(Controller, false);
+		PendingControllers.Add(Controller);
+		++Result.RespawnedPawns;
+	}
+}
+
+AActor* FLyraTestWorldReset::FindStart(UWorld* World, AController* Controller) const
+{
+	if (Controller == PlayerController.Get() && Settings.PlayerStartIndex >= 0)
+	{
+		TArray<APlayerStart*> Starts;
+		for (TActorIterator<APlayerStart> It(World); It; ++It)
+		{
+			Starts.Add(*It);
+		}
+		Starts.Sort([](const APlayerStart& A, const APlayerStart& B) { return A.GetName() < B.GetName(); });
+		return Starts.IsValidIndex(Settings.PlayerStartIndex) ? Starts[Settings.PlayerStartIndex] : nullptr;
+	}
+	AGameModeBase* GameMode = World->GetAuthGameMode();
+	return GameMode ? GameMode->FindPlayerStart(Controller) : nullptr;
+}
+
+void FLyraTestWorldReset::PlaceAt(APawn* Pawn, AController* Controller, const AActor* Start)
+{
+	if (!Start)
+	{
+		return;
+	}
+	const FRotator Rotation(0.f, Start->GetActorRotation().Yaw, 0.f);
+	Pawn->TeleportTo(Start->GetActorLocation(), Rotation);
+	if (ACharacter* Character = Cast<ACharacter>(Pawn))
+	{
+		Character->GetCharacterMovement()->StopMovementImmediately();
+	}
+	Controller->SetControlRotation(Rotation);
+}
+
+void FLyraTestWorldReset::RestoreHealthAndAmmo(APawn* Pawn)
+{
+	const ULyraPawnExtensionComponent* PawnExt = ULyraPawnExtensionComponent::FindPawnExtensionComponent(Pawn);
+	ULyraAbilitySystemComponent* ASC = PawnExt ? PawnExt->GetLyraAbilitySystemComponent() : nullptr;
+	if (ASC && ASC->GetSet<ULyraHealthSet>())
+	{
+		// Setting the base value bypasses the healing execution, so the reset does not show up as combat.
+		ASC->SetNumericAttributeBase(ULyraHealthSet::GetHealthAttribute(), ASC->GetNumericAttribute(ULyraHealthSet::GetMaxHealthAttribute()));
+	}
+
+	ULyraEquipmentManagerComponent* EquipmentManager = Pawn->FindComponentByClass<ULyraEquipmentManagerComponent>();
+	if (!EquipmentManager)
+	{
+		return;
+	}
+	for (ULyraEquipmentInstance* Equipment : EquipmentManager->GetEquipmentInstancesOfType(ULyraRangedWeaponInstance::StaticClass()))
+	{
+		ULyraInventoryItemInstance* Item = Cast<ULyraInventoryItemInstance>(Equipment->GetInstigator());
+		const UInventoryFragment_SetStats* Stats = Item ? Item->FindFragmentByClass<UInventoryFragment_SetStats>() : nullptr;
+		if (!Stats)
+		{
+			continue;
+		}
+		for (const FName& TagName : AmmoTagNames)
+		{
+			const FGameplayTag Tag = UGameplayTagsManager::Get().RequestGameplayTag(TagName, false);
+			if (!Tag.IsValid())
+			{
+				continue;
+			}
+			const int32 Delta = Stats->GetItemStatByTag(Tag) - Item->GetStatTagStackCount(Tag);
+			if (Delta > 0)
+			{
+				Item->AddStatTagStack(Tag, Delta);
+			}
+			else if (Delta < 0)
+			{
+				Item->RemoveStatTagStack(Tag, -Delta);
+			}
+		}
+	}
+}
+
+void FLyraTestWorldReset::Finish(const FString& Failure)
+{
+	Result.bComplete = true;
+	Result.bSucceeded = Failure.IsEmpty();
+	Result.Failure = Failure;
+	Result.Frames = static_cast<int32>(GFrameCounter - BeginFrame);
+	PendingControllers.Reset();
+	bRunning = false;
+}
@@ -0,0 +1,116 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LyraTestWorldReset.generated.h"
+
+class AActor;
+class AController;
+class APawn;
+class APlayerController;
+class UWorld;
+
+USTRUCT(BlueprintType)
+struct LYRAGAME_API FLyraTestWorldResetSettings
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	int32 PlayerIndex = 0;
+
+	/** Player start the local player is moved to, by index in name order; -1 lets the game mode choose. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	int32 PlayerStartIndex = -1;
+
+	/** Bots are added or removed to reach this count; -1 keeps the current bots. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	int32 BotCount = -1;
+
+	/** Team per bot in player array order, repeated when shorter; empty keeps the game's assignment. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	TArray<int32> BotTeamIds;
+
+	/** -1 keeps the local player's team. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	int32 PlayerTeamId = -1;
+
+	/** Team and player state stat tags cleared to zero. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	TArray<FString> ScoreTags = { TEXT("ShooterGame.Score.Eliminations"), TEXT("ShooterGame.Score.Deaths"), TEXT("ShooterGame.Score.Assists") };
+
+	/** Frames to wait for respawned pawns before the reset is marked failed. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Test|Automation")
+	int32 MaxFrames = 60;
+};
+
+USTRUCT(BlueprintType)
+struct LYRAGAME_API FLyraTestWorldResetResult
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	int64 ResetId = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	bool bComplete = false;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	bool bSucceeded = false;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	FString Failure;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	int32 Frames = 0;
+
+	/** Live pawns healed, re-armed and moved to a start instead of being respawned. */
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	int32 ReusedPawns = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	int32 RespawnedPawns = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	int32 AddedBots = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Test|Automation")
+	int32 RemovedBots = 0;
+};
+
+/**
+ * In-place reset of the loaded map, owned and ticked by the test support subsystem. Begin does everything
+ * that can happen immediately: bot count and teams, scores, and healing / re-arming / placing every live
+ * pawn. Dead or missing pawns are respawned through the game mode, and Tick completes the reset once they
+ * are possessed with an ability system, usually on the next frame.
+ */
+class LYRAGAME_API FLyraTestWorldReset
+{
+public:
+	void Begin(UWorld* World, int64 ResetId, const FLyraTestWorldResetSettings& InSettings, APlayerController* InPlayerController);
+
+	/** Returns true on the frame the reset completes or fails. */
+	bool Tick(UWorld* World);
+
+	bool IsRunning() const { return bRunning; }
+	const FLyraTestWorldResetResult& GetResult() const { return Result; }
+	APlayerController* GetPlayerController() const { return PlayerController.Get(); }
+
+private:
+	void SetBotCount(UWorld* World);
+	void ApplyTeams(UWorld* World);
+	void ResetScores(UWorld* World);
+	void ResetController(UWorld* World, AController* Controller);
+	AActor* FindStart(UWorld* World, AController* Controller) const;
+	void Finish(const FString& Failure = FString());
+
+	static void PlaceAt(APawn* Pawn, AController* Controller, const AActor* Start);
+	static void RestoreHealthAndAmmo(APawn* Pawn);
+
+	FLyraTestWorldResetSettings Settings;
+	FLyraTestWorldResetResult Result;
+	TWeakObjectPtr<APlayerController> PlayerController;
+	TArray<TWeakObjectPtr<AController>> PendingControllers;
+	uint64 BeginFrame = 0;
+	bool bRunning = false;
+};
@@ -0,0 +1,95 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Testing/LyraTestWorlds.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+
+static bool IsAutomationWorldContext(const FWorldContext& Context)
+{
+	return (Context.WorldType == EWorldType::Game || Context.WorldType == EWorldType::PIE) && Context.World() && Context.OwningGameInstance;
+}
+
+static int32 GetContextWorldId(const FWorldContext& Context)
+{
+	return FMath::Max(Context.PIEInstance, 0);
+}
+
+void LyraTestWorlds::GetWorlds(TArray<UWorld*>& OutWorlds)
+{
+	OutWorlds.Reset();
+	if (!GEngine)
+	{
+		return;
+	}
+	TArray<TPair<int32, UWorld*>, TInlineAllocator<8>> Worlds;
+	for (const FWorldContext& Context : GEngine->GetWorldContexts())
+	{
+		if (IsAutomationWorldContext(Context))
+		{
+			Worlds.Emplace(GetContextWorldId(Context), Context.World());
+		}
+	}
+	Worlds.StableSort([](const TPair<int32, UWorld*>& A, const TPair<int32, UWorld*>& B) { return A.Key < B.Key; });
+	for (const TPair<int32, UWorld*>& Pair : Worlds)
+	{
+		OutWorlds.Add(Pair.Value);
+	}
+}
+
+int32 LyraTestWorlds::GetWorldId(const UWorld* World)
+{
+	const FWorldContext* Context = GEngine && World ? GEngine->GetWorldContextFromWorld(World) : nullptr;
+	return Context && IsAutomationWorldContext(*Context) ? GetContextWorldId(*Context) : INDEX_NONE;
+}
+
+int32 LyraTestWorlds::GetWorldId(const UGameInstance* GameInstance)
+{
+	const FWorldContext* Context = GameInstance ? GameInstance->GetWorldContext() : nullptr;
+	return Context ? GetContextWorldId(*Context) : INDEX_NONE;
+}
+
+bool LyraTestWorlds::IsSharedProcess(const UGameInstance* GameInstance)
+{
+	const FWorldContext* Context = GameInstance ? GameInstance->GetWorldContext() : nullptr;
+	return Context && Context->WorldType == EWorldType::PIE;
+}
+
+UWorld* LyraTestWorlds::ResolveWorld(const UObject* WorldContextObject)
+{
+	if (!GEngine)
+	{
+		return nullptr;
+	}
+	if (UWorld* World = WorldContextObject ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr)
+	{
+		return World;
+	}
+	UWorld* Only = nullptr;
+	for (const FWorldContext& Context : GEngine->GetWorldContexts())
+	{
+		if (IsAutomationWorldContext(Context))
+		{
+			if (Only)
+			{
+				return nullptr;
+			}
+			Only = Context.World();
+		}
+	}
+	return Only;
+}
+
+FString LyraTestWorlds::ToJson()
+{
+	TArray<UWorld*> Worlds;
+	GetWorlds(Worlds);
+	TArray<FString> Entries;
+	for (const UWorld* World : Worlds)
+	{
+		const UGameInstance* GI = World->GetGameInstance();
+		Entries.Add(FString::Printf(TEXT("{\"worldId\":%d,\"map\":\"%s\",\"netMode\":%d,\"localPlayers\":%d}"),
+			GetWorldId(World), *World->GetMapName().ReplaceCharWithEscapedChar(), static_cast<int32>(World->GetNetMode()), GI ? GI->GetNumLocalPlayers() : 0));
+	}
+	return FString::Printf(TEXT("[%s]"), *FString::Join(Entries, TEXT(",")));
+}
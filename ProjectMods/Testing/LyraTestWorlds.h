@@ -0,0 +1,39 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UGameInstance;
+class UObject;
+class UWorld;
+
+/**
+ * Game worlds the harness can address when one process hosts several, as multi-client PIE does. Every harness
+ * subsystem is per game instance, so players, bots, cheats, aim ticks and event logs are already separate per
+ * world; these helpers pick the world a query or command runs against. A world's id is its PIE instance, 0 for
+ * a standalone game world, and stays the same across map travel.
+ */
+namespace LyraTestWorlds
+{
+	/** Game and PIE worlds with a game instance, ordered by id. */
+	LYRAGAME_API void GetWorlds(TArray<UWorld*>& OutWorlds);
+
+	/** INDEX_NONE for a world that is not a game or PIE world. */
+	LYRAGAME_API int32 GetWorldId(const UWorld* World);
+
+	/** Id of the game instance's world context; valid from the instance's Init, before its first world exists. */
+	LYRAGAME_API int32 GetWorldId(const UGameInstance* GameInstance);
+
+	/** True when the game instance is one of several in the process (a PIE instance). */
+	LYRAGAME_API bool IsSharedProcess(const UGameInstance* GameInstance);
+
+	/**
+	 * The world of WorldContextObject. Without a usable context object this is the only game world; null when
+	 * there are several, so a query never silently runs against another scenario's world.
+	 */
+	LYRAGAME_API UWorld* ResolveWorld(const UObject* WorldContextObject);
+
+	/** JSON array with id, map, net mode and local player count of each world. */
+	LYRAGAME_API FString ToJson();
+}
@@ -0,0 +1,114 @@
+namespace LyraTestCoordinator;
+
+/// <summary>Command line of the coordinator; see <see cref="Usage"/>.</summary>
+public sealed class CoordinatorOptions
+{
+    public const string Usage =
+        "LyraTestCoordinator --tests <LyraTests.dll> [--game <LyraGame executable>] [options]\n" +
+        "  --instances <K>          game instances to run side by side (default: cores / 8, at least 1)\n" +
+        "  --base-port <port>       AltTester port of instance 0 (default 13000)\n" +
+        "  --port-stride <n>        port step between instances; 0 shares one port, told apart by app name (default 1)\n" +
+        "  --app-name <prefix>      AltTester app name prefix, suffixed with the instance id (default Lyra)\n" +
+        "  --map <map> --experience <experience> --seed <n> --bots <n>\n" +
+        "                           per-instance defaults passed to the game's LyraTestInstanceConfig\n" +
+        "  --game-args <args>       extra game arguments; {instance}, {port} and {appName} are replaced per instance\n" +
+        "                           (default: -unattended -nosound -RenderOffscreen)\n" +
+        "  --filter <expr>          dotnet test filter applied to every shard\n" +
+        "  --out <dir>              results directory (default TestResults/Sharded)\n" +
+        "  --startup-seconds <s>    wait after launching the games before the first shard (default 20)\n" +
+        "  --no-launch              the instances are already running; only hand out shards";
+
+    public string TestAssembly { get; private set; } = string.Empty;
+    public string? GameExecutable { get; private set; }
+    public int Instances { get; private set; } = Math.Max(1, Environment.ProcessorCount / 8);
+    public int BasePort { get; private set; } = 13000;
+    public int PortStride { get; private set; } = 1;
+    public string AppNamePrefix { get; private set; } = "Lyra";
+    public string? Map { get; private set; }
+    public string? Experience { get; private set; }
+    public int? Seed { get; private set; }
+    public int? BotCount { get; private set; }
+    public string GameArgs { get; private set; } = "-unattended -nosound -RenderOffscreen";
+    public string? Filter { get; private set; }
+    public string OutputDirectory { get; private set; } = Path.Combine("TestResults", "Sharded");
+    public int StartupSeconds { get; private set; } = 20;
+    public bool Launch { get; private set; } = true;
+
+    public int PortFor(int instance) => BasePort + instance * PortStride;
+    public string AppNameFor(int instance) => $"{AppNamePrefix}{instance}";
+
+    public static bool TryParse(string[] args, out CoordinatorOptions options, out string error)
+    {
+        options = new CoordinatorOptions();
+        error = string.Empty;
+        for (int i = 0; i < args.Length; i++)
+        {
+            string arg = args[i];
+            if (arg == "--no-launch")
+            {
+                options.Launch = false;
+                continue;
+            }
+            if (i + 1 >= args.Length)
+            {
+                error = "Missing value for " + arg;
+                return false;
+            }
+            string value = args[++i];
+            switch (arg)
+            {
+                case "--tests": options.TestAssembly = value; break;
+                case "--game": options.GameExecutable = value; break;
+                case "--instances": if (!TryParsePositive(value, out var k)) return Fail(arg, out error); options.Instances = k; break;
+                case "--base-port": if (!TryParsePositive(value, out var p)) return Fail(arg, out error); options.BasePort = p; break;
+                case "--port-stride": if (!int.TryParse(value, out var s) || s < 0) return Fail(arg, out error); options.PortStride = s; break;
+                case "--app-name": options.AppNamePrefix = value; break;
+                case "--map": options.Map = value; break;
+                case "--experience": options.Experience = value; break;
+                case "--seed": if (!int.TryParse(value, out var seed)) return Fail(arg, out error); options.Seed = seed; break;
+                case "--bots": if (!int.TryParse(value, out var bots) || bots < 0) return Fail(arg, out error); options.BotCount = bots; break;
+                case "--game-args": options.GameArgs = value; break;
+                case "--filter": options.Filter = value; break;
+                case "--out": options.OutputDirectory = value; break;
+                case "--startup-seconds": if (!int.TryParse(value, out var t) || t < 0) return Fail(arg, out error); options.StartupSeconds = t; break;
+                default:
+                    error = "Unknown option " + arg;
+                    return false;
+            }
+        }
+        if (string.IsNullOrEmpty(options.TestAssembly))
+        {
+            error = "--tests is required";
+            return false;
+        }
+        if (options.Launch && string.IsNullOrEmpty(options.GameExecutable))
+        {
+            error = "--game is required unless --no-launch is given";
+            return false;
+        }
+        return true;
+    }
+
+    /// <summary>Arguments for one game instance: the extra arguments plus its LyraTestInstanceConfig.</summary>
+    public string GameArgumentsFor(int instance, string logPath)
+    {
+        var args = GameArgs
+            .Replace("{instance}", instance.ToString())
+            .Replace("{port}", PortFor(instance).ToString())
+            .Replace("{appName}", AppNameFor(instance));
+        args += $" -LyraTestInstance={instance} -LyraTestAgentPort={PortFor(instance)} -LyraTestAppName={AppNameFor(instance)}";
+        if (!string.IsNullOrEmpty(Map)) args += $" -LyraTestInstanceMap={Map}";
+        if (!string.IsNullOrEmpty(Experience)) args += $" -LyraTestInstanceExperience={Experience}";
+        if (Seed is int seed) args += $" -LyraTestSeed={seed}";
+        if (BotCount is int bots) args += $" -LyraTestBots={bots}";
+        return args + $" -abslog=\"{logPath}\"";
+    }
+
+    static bool TryParsePositive(string value, out int result) => int.TryParse(value, out result) && result > 0;
+
+    static bool Fail(string arg, out string error)
+    {
+        error = "Invalid value for " + arg;
+        return false;
+    }
+}
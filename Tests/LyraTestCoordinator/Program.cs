@@ -0,0 +1,151 @@
+using System.Collections.Concurrent;
+using System.Diagnostics;
+using System.Reflection;
+
+namespace LyraTestCoordinator;
+
+/// <summary>
+/// Runs the LyraTests suite across K game instances on one agent. Each instance gets its own AltTester port / app
+/// name and LyraTestInstanceConfig; test classes are handed out one at a time to whichever instance is free, each
+/// as its own dotnet test run, and the per-shard TRX files are merged into one JUnit report.
+/// </summary>
+public static class Program
+{
+    static readonly string[] TestAttributeNames = { "TestAttribute", "TestCaseAttribute", "TestCaseSourceAttribute" };
+
+    public static int Main(string[] args)
+    {
+        if (!CoordinatorOptions.TryParse(args, out var options, out var error))
+        {
+            Console.Error.WriteLine(error);
+            Console.Error.WriteLine(CoordinatorOptions.Usage);
+            return 2;
+        }
+        string testAssembly = Path.GetFullPath(options.TestAssembly);
+        string outputDirectory = Path.GetFullPath(options.OutputDirectory);
+        Directory.CreateDirectory(outputDirectory);
+
+        var shards = DiscoverTestClasses(testAssembly);
+        if (shards.Count == 0)
+        {
+            Console.Error.WriteLine("No test classes found in " + testAssembly);
+            return 2;
+        }
+        Console.WriteLine($"{shards.Count} test classes over {options.Instances} instances");
+
+        var games = new Process?[options.Instances];
+        var stopwatch = Stopwatch.StartNew();
+        var results = new ShardResults();
+        try
+        {
+            if (options.Launch)
+            {
+                for (int i = 0; i < options.Instances; i++)
+                    games[i] = StartGame(options, i, outputDirectory);
+                Thread.Sleep(TimeSpan.FromSeconds(options.StartupSeconds));
+            }
+
+            var queue = new ConcurrentQueue<string>(shards);
+            var workers = Enumerable.Range(0, options.Instances)
+                .Select(i => Task.Run(() => RunShards(options, i, games[i], queue, testAssembly, outputDirectory, results)))
+                .ToArray();
+            Task.WaitAll(workers);
+            // Left over only when every instance died.
+            while (queue.TryDequeue(out var shard))
+                results.AddError($"{shard}: not run, no game instance left");
+        }
+        finally
+        {
+            foreach (var game in games)
+            {
+                try
+                {
+                    if (game is { HasExited: false }) game.Kill(entireProcessTree: true);
+                }
+                catch (InvalidOperationException) { }
+            }
+        }
+
+        string junitPath = Path.Combine(outputDirectory, "results.junit.xml");
+        results.WriteJUnit(junitPath, stopwatch.Elapsed.TotalSeconds);
+        int failed = results.Results.Count(r => r.Failed);
+        Console.WriteLine($"{results.Results.Count} tests, {failed} failed, {results.ShardErrors.Count} shard errors in {stopwatch.Elapsed.TotalSeconds:F0} s -> {junitPath}");
+        foreach (var r in results.Results.Where(r => r.Failed))
+            Console.WriteLine($"  FAILED {r.ClassName}.{r.Name} (instance {r.Instance}): {r.Message}");
+        foreach (var e in results.ShardErrors)
+            Console.WriteLine("  ERROR " + e);
+        return results.AllPassed ? 0 : 1;
+    }
+
+    /// <summary>Test classes are the shard unit: their fixtures share one map load and must stay on one instance.</summary>
+    static List<string> DiscoverTestClasses(string assemblyPath)
+    {
+        var assembly = Assembly.LoadFrom(assemblyPath);
+        Type[] types;
+        try
+        {
+            types = assembly.GetTypes();
+        }
+        catch (ReflectionTypeLoadException e)
+        {
+            types = e.Types.Where(t => t != null).ToArray()!;
+        }
+        return types
+            .Where(t => t.IsClass && !t.IsAbstract && t.FullName != null)
+            .Where(t => t.GetMethods(BindingFlags.Public | BindingFlags.Instance)
+                .Any(m => m.GetCustomAttributesData().Any(a => TestAttributeNames.Contains(a.AttributeType.Name))))
+            .Select(t => t.FullName!)
+            .OrderBy(n => n, StringComparer.Ordinal)
+            .ToList();
+    }
+
+    static Process StartGame(CoordinatorOptions options, int instance, string outputDirectory)
+    {
+        var info = new ProcessStartInfo(options.GameExecutable!, options.GameArgumentsFor(instance, Path.Combine(outputDirectory, $"instance{instance}.log")))
+        {
+            UseShellExecute = false
+        };
+        var process = Process.Start(info) ?? throw new InvalidOperationException("Could not start " + options.GameExecutable);
+        Console.WriteLine($"instance {instance}: pid {process.Id}, port {options.PortFor(instance)}, app {options.AppNameFor(instance)}");
+        return process;
+    }
+
+    static void RunShards(CoordinatorOptions options, int instance, Process? game, ConcurrentQueue<string> queue, string testAssembly, string outputDirectory, ShardResults results)
+    {
+        while (queue.TryDequeue(out var shard))
+        {
+            if (game is { HasExited: true })
+            {
+                // Hand the shard back to the instances that are still up.
+                queue.Enqueue(shard);
+                results.AddError($"instance {instance} exited with code {game.ExitCode}");
+                return;
+            }
+            string shardName = $"{instance}-{shard}";
+            string trxPath = Path.Combine(outputDirectory, shardName + ".trx");
+            string filter = $"FullyQualifiedName~{shard}.";
+            if (!string.IsNullOrEmpty(options.Filter))
+                filter = $"({filter})&({options.Filter})";
+
+            var info = new ProcessStartInfo("dotnet")
+            {
+                UseShellExecute = false,
+                RedirectStandardOutput = true,
+                RedirectStandardError = true
+            };
+            foreach (var arg in new[] { "test", testAssembly, "--filter", filter, "--logger", $"trx;LogFileName={shardName}.trx", "--results-directory", outputDirectory })
+                info.ArgumentList.Add(arg);
+            info.Environment["ALTTESTER_PORT"] = options.PortFor(instance).ToString();
+            info.Environment["ALTTESTER_APP_NAME"] = options.AppNameFor(instance);
+            info.Environment["ALTTESTER_INSTANCE_ID"] = instance.ToString();
+
+            Console.WriteLine($"instance {instance}: {shard}");
+            using var process = Process.Start(info)!;
+            var stdout = process.StandardOutput.ReadToEndAsync();
+            var stderr = process.StandardError.ReadToEndAsync();
+            process.WaitForExit();
+            File.WriteAllText(Path.Combine(outputDirectory, shardName + ".log"), stdout.Result + stderr.Result);
+            results.Add(shard, instance, trxPath, process.ExitCode);
+        }
+    }
+}
@@ -0,0 +1,110 @@
+using System.Globalization;
+using System.Xml.Linq;
+
+namespace LyraTestCoordinator;
+
+public readonly record struct TestResult(string ClassName, string Name, string Outcome, double Seconds, string Message, int Instance)
+{
+    public bool Failed => Outcome is "Failed" or "Error" or "Aborted" or "Timeout";
+}
+
+/// <summary>Collects the TRX files written by each shard's dotnet test run and merges them into one JUnit report.</summary>
+public sealed class ShardResults
+{
+    static readonly XNamespace Trx = "http://microsoft.com/schemas/VisualStudio/TeamTest/2010";
+
+    readonly object _lock = new();
+    readonly List<TestResult> _results = new();
+    readonly List<string> _shardErrors = new();
+
+    public IReadOnlyList<TestResult> Results => _results;
+    public IReadOnlyList<string> ShardErrors => _shardErrors;
+
+    /// <summary>Adds the results of one shard; a shard whose run produced no results counts as an error.</summary>
+    public void Add(string shard, int instance, string trxPath, int exitCode)
+    {
+        var results = File.Exists(trxPath) ? ReadTrx(trxPath, instance) : new List<TestResult>();
+        lock (_lock)
+        {
+            _results.AddRange(results);
+            if (results.Count == 0)
+                _shardErrors.Add($"{shard} on instance {instance}: no results (dotnet test exit code {exitCode})");
+        }
+    }
+
+    public void AddError(string error)
+    {
+        lock (_lock) _shardErrors.Add(error);
+    }
+
+    public bool AllPassed
+    {
+        get { lock (_lock) return _shardErrors.Count == 0 && !_results.Any(r => r.Failed); }
+    }
+
+    static List<TestResult> ReadTrx(string path, int instance)
+    {
+        var doc = XDocument.Load(path);
+        var classNames = doc.Descendants(Trx + "UnitTest").ToDictionary(
+            t => (string?)t.Attribute("id") ?? string.Empty,
+            t => (string?)t.Element(Trx + "TestMethod")?.Attribute("className") ?? string.Empty);
+        var results = new List<TestResult>();
+        foreach (var r in doc.Descendants(Trx + "UnitTestResult"))
+        {
+            string testId = (string?)r.Attribute("testId") ?? string.Empty;
+            double seconds = TimeSpan.TryParse((string?)r.Attribute("duration"), CultureInfo.InvariantCulture, out var duration) ? duration.TotalSeconds : 0;
+            string message = (string?)r.Element(Trx + "Output")?.Element(Trx + "ErrorInfo")?.Element(Trx + "Message") ?? string.Empty;
+            results.Add(new TestResult(
+                classNames.TryGetValue(testId, out var className) ? className : string.Empty,
+                (string?)r.Attribute("testName") ?? string.Empty,
+                (string?)r.Attribute("outcome") ?? string.Empty,
+                seconds, message, instance));
+        }
+        return results;
+    }
+
+    /// <summary>One testsuite per test class, with the instance each test ran on as a property.</summary>
+    public void WriteJUnit(string path, double totalSeconds)
+    {
+        lock (_lock)
+        {
+            var suites = new XElement("testsuites",
+                new XAttribute("tests", _results.Count),
+                new XAttribute("failures", _results.Count(r => r.Failed)),
+                new XAttribute("errors", _shardErrors.Count),
+                new XAttribute("time", totalSeconds.ToString("F3", CultureInfo.InvariantCulture)));
+            foreach (var group in _results.GroupBy(r => r.ClassName).OrderBy(g => g.Key, StringComparer.Ordinal))
+            {
+                var suite = new XElement("testsuite",
+                    new XAttribute("name", group.Key),
+                    new XAttribute("tests", group.Count()),
+                    new XAttribute("failures", group.Count(r => r.Failed)),
+                    new XAttribute("skipped", group.Count(r => r.Outcome == "NotExecuted")),
+                    new XAttribute("time", group.Sum(r => r.Seconds).ToString("F3", CultureInfo.InvariantCulture)));
+                foreach (var r in group)
+                {
+                    var testCase = new XElement("testcase",
+                        new XAttribute("classname", r.ClassName),
+                        new XAttribute("name", r.Name),
+                        new XAttribute("time", r.Seconds.ToString("F3", CultureInfo.InvariantCulture)),
+                        new XElement("properties", new XElement("property", new XAttribute("name", "instance"), new XAttribute("value", r.Instance))));
+                    if (r.Failed)
+                        testCase.Add(new XElement("failure", new XAttribute("message", r.Message), new XAttribute("type", r.Outcome)));
+                    else if (r.Outcome == "NotExecuted")
+                        testCase.Add(new XElement("skipped"));
+                    suite.Add(testCase);
+                }
+                suites.Add(suite);
+            }
+            if (_shardErrors.Count > 0)
+            {
+                var suite = new XElement("testsuite", new XAttribute("name", "Coordinator"), new XAttribute("tests", _shardErrors.Count), new XAttribute("errors", _shardErrors.Count));
+                for (int i = 0; i < _shardErrors.Count; i++)
+                    suite.Add(new XElement("testcase", new XAttribute("classname", "Coordinator"), new XAttribute("name", $"Shard{i}"),
+                        new XElement("error", new XAttribute("message", _shardErrors[i]))));
+                suites.Add(suite);
+            }
+            new XDocument(new XDeclaration("1.0", "UTF-8", null), suites).Save(path);
+        }
+    }
+}
@@ -15,12 +15,22 @@ public static class AltDriverConfig
     public static string Host => Env("ALTTESTER_HOST", "127.0.0.1");
     public static int Port => int.TryParse(Environment.GetEnvironmentVariable("ALTTESTER_PORT"), out var p) ? p : 13000;
     public static string AppName => Env("ALTTESTER_APP_NAME", "__default__");
+    /// <summary>Game instance this test process was assigned by the coordinator; -1 when not sharded.</summary>
+    public static int InstanceId => int.TryParse(Environment.GetEnvironmentVariable("ALTTESTER_INSTANCE_ID"), out var id) && id >= 0 ? id : -1;
+    /// <summary>LyraTestWorlds id of the game world to drive when one process hosts several (multi-client PIE); -1 for the only one.</summary>
+    public static int WorldId => int.TryParse(Environment.GetEnvironmentVariable("ALTTESTER_WORLD_ID"), out var w) && w >= 0 ? w : -1;
     public static int ConnectTimeout => int.TryParse(Environment.GetEnvironmentVariable("ALTTESTER_CONNECT_TIMEOUT"), out var t) ? t : 60;
 
     public static string? AimTestMap => string.IsNullOrWhiteSpace(Environment.GetEnvironmentVariable("ALTTESTER_AIM_TEST_MAP")) ? null : Environment.GetEnvironmentVariable("ALTTESTER_AIM_TEST_MAP")!.Trim();
     public static string? AimTestMapOptions => string.IsNullOrWhiteSpace(Environment.GetEnvironmentVariable("ALTTESTER_AIM_TEST_MAP_OPTIONS")) ? null : Environment.GetEnvironmentVariable("ALTTESTER_AIM_TEST_MAP_OPTIONS")!.Trim();
+    public static string? AimTestExperience => string.IsNullOrWhiteSpace(Environment.GetEnvironmentVariable("ALTTESTER_AIM_TEST_EXPERIENCE")) ? null : Environment.GetEnvironmentVariable("ALTTESTER_AIM_TEST_EXPERIENCE")!.Trim();
     public static bool AimTestTwoPlayers => string.Equals(Environment.GetEnvironmentVariable("ALTTESTER_AIM_TEST_TWO_PLAYERS"), "1", StringComparison.OrdinalIgnoreCase);
 
+    public static string? PerfBaselineDirectory => string.IsNullOrWhiteSpace(Environment.GetEnvironmentVariable("ALTTESTER_PERF_BASELINE_DIR")) ? null : Environment.GetEnvironmentVariable("ALTTESTER_PERF_BASELINE_DIR")!.Trim();
+    public static bool PerfUpdateBaseline => string.Equals(Environment.GetEnvironmentVariable("ALTTESTER_PERF_UPDATE_BASELINE"), "1", StringComparison.OrdinalIgnoreCase);
+    public static bool PerfGate => string.Equals(Environment.GetEnvironmentVariable("ALTTESTER_PERF_GATE"), "1", StringComparison.OrdinalIgnoreCase);
+    public static float PerfHitchThresholdMs => float.TryParse(Environment.GetEnvironmentVariable("ALTTESTER_PERF_HITCH_MS"), out var h) && h > 0 ? h : 50f;
+
     public static string ExperienceButton => Env("ALTTESTER_EXPERIENCE_BUTTON", "Control");
     public static int ExperienceTileIndex => int.TryParse(Environment.GetEnvironmentVariable("ALTTESTER_EXPERIENCE_TILE_INDEX"), out var i) && i >= 0 ? i : 1;
     public static string[] ExperienceTileNameSubstrings => EnvList("ALTTESTER_EXPERIENCE_TILE_NAMES", "Control,Convolution");
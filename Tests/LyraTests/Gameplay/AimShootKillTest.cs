@@ -1,4 +1,5 @@
 using AltTester.AltTesterSDK.Driver;
+using LyraTests.Config;
 using LyraTests.Helpers;
 using LyraTests.Smoke;
 using NUnit.Framework;
@@ -136,6 +137,11 @@ public class AimShootKillTest : SmokeTestBase
         var lastAimDiagUtc = DateTime.UtcNow;
         var lastNullEnemyLogUtc = DateTime.MinValue;
         var lastMissingTargetCheckUtc = DateTime.MinValue;
+        long combatLogSince = 0;
+        bool combatLogAvailable = useSubsystemEnemyPositions && CombatLog.TryGetLatestSequence(Driver, cachedWorldId, out combatLogSince);
+        long localPawnIdForKills = combatLogAvailable ? CombatLog.TryGetLocalPlayerPawnId(Driver, cachedWorldId) : 0;
+        bool commandBatchAvailable = useSubsystemEnemyPositions && cachedWorldId != 0;
+        bool perfCaptureStarted = AimingHelper.TryBeginPerfCapture(Driver, cachedWorldId, "AimShootKillTest", AltDriverConfig.PerfHitchThresholdMs);
 
         while (DateTime.UtcNow < shootDeadline)
         {
@@ -165,6 +171,12 @@ public class AimShootKillTest : SmokeTestBase
             }
             if (useSubsystemEnemyPositions)
             {
+                if (combatLogAvailable && (continuousAimFireOn || !commandBatchAvailable) && CombatLog.TryFindKillSince(Driver, cachedWorldId, combatLogSince, out long killSeq, instigatorId: localPawnIdForKills))
+                {
+                    Console.WriteLine($"[AimShootKillTest] Kill confirmed from combat log (seq={killSeq}).");
+                    killConfirmed = true;
+                    break;
+                }
                 if (continuousAimFireOn)
                 {
                     var posList = new List<(float x, float y, float z)>();
@@ -188,7 +200,27 @@ public class AimShootKillTest : SmokeTestBase
                     (float x, float y, float z)? playerPos = null;
                     float aimZ = lastWz + AimingHelper.TargetHeightOffsetZFromEngine;
                     bool wantFireThisFrame = (lastWx * lastWx + lastWy * lastWy + lastWz * lastWz) > 1f;
-                    usedCombinedApi = cachedWorldId != 0 && AimingHelper.TryGetEnemyOnlyPositionsAndAimAt(Driver, cachedWorldId, lastWx, lastWy, aimZ, wantFireThisFrame, out playerPos, out posList);
+                    if (commandBatchAvailable)
+                    {
+                        var batch = new TestCommandBatch().AimAtEnemy();
+                        if (wantFireThisFrame) batch.Fire();
+                        batch.Snapshot(enemiesOnly: true);
+                        if (combatLogAvailable) batch.FindKill(combatLogSince, instigatorId: localPawnIdForKills);
+                        if (batch.TryExecute(Driver, cachedWorldId, out var batchResult) && batchResult!.LastSnapshot != null)
+                        {
+                            if (batchResult.KillSequence != 0)
+                            {
+                                Console.WriteLine($"[AimShootKillTest] Kill confirmed from combat log (seq={batchResult.KillSequence}).");
+                                killConfirmed = true;
+                                break;
+                            }
+                            usedCombinedApi = AimingHelper.PositionsFromSnapshot(batchResult.LastSnapshot, out playerPos, out posList);
+                        }
+                        else
+                            commandBatchAvailable = false;
+                    }
+                    if (!usedCombinedApi && !commandBatchAvailable)
+                        usedCombinedApi = cachedWorldId != 0 && AimingHelper.TryGetEnemyOnlyPositionsAndAimAt(Driver, cachedWorldId, lastWx, lastWy, aimZ, wantFireThisFrame, out playerPos, out posList);
                     bool gotPositions = usedCombinedApi;
                     if (!gotPositions && cachedWorldId != 0)
                     {
@@ -305,7 +337,7 @@ public class AimShootKillTest : SmokeTestBase
             else if ((now - lastFireUtc).TotalSeconds >= fireIntervalSeconds)
             {
                 var targetForVisibility = currentEnemy;
-                bool isVisible = targetForVisibility != null && AimingHelper.IsTargetVisible(Driver, targetForVisibility);
+                bool isVisible = targetForVisibility != null && AimingHelper.IsTargetVisible(Driver, targetForVisibility, cachedWorldId);
                 bool forceFire = !isVisible && currentEnemy != null && (now - lastForceFireUtc).TotalSeconds >= forceFireIntervalSeconds;
                 shouldFire = isVisible || forceFire;
                 if (forceFire) lastForceFireUtc = now;
@@ -358,10 +390,22 @@ public class AimShootKillTest : SmokeTestBase
                 lastLogUtc = now;
             }
         }
+        if (AimingHelper.TryGetTestStatsSummary(Driver, reset: false, out var statsSummary))
+            Console.WriteLine($"[AimShootKillTest] harness stats:\n{statsSummary}");
+        TestPerfCapture? perf = null;
+        if (perfCaptureStarted && AimingHelper.TryEndPerfCapture(Driver, cachedWorldId, AltDriverConfig.PerfBaselineDirectory, AltDriverConfig.PerfUpdateBaseline, out perf))
+        {
+            Console.WriteLine($"[AimShootKillTest] perf: {perf}");
+            Console.WriteLine(perf!.BaselineFound
+                ? $"[AimShootKillTest] perf vs {perf.BaselinePath}: {(perf.Passed ? "ok" : string.Join("; ", perf.Regressions))}"
+                : $"[AimShootKillTest] perf: no baseline at {perf.BaselinePath}{(perf.BaselineWritten ? ", recorded this run" : string.Empty)}");
+        }
         string killMsg = useSubsystemEnemyPositions
             ? $"Kill not confirmed within {shootTimeoutSeconds}s: enemy count from engine never dropped below {initialSubsystemEnemyCount}. Aim may be off (check TargetHeightOffsetZFromEngine) or match has respawns."
             : $"Kill not confirmed within {shootTimeoutSeconds}s (last enemy id={targetEnemyId}). If no other players after kill, ensure match has other players; see [AimShootKillTest] Find next enemy logs.";
         Assert.That(killConfirmed, Is.True, killMsg);
+        if (AltDriverConfig.PerfGate && perf != null)
+            Assert.That(perf.Passed, Is.True, $"Perf regression against {perf.BaselinePath}: {string.Join("; ", perf.Regressions)}");
     }
 
     [TearDown]
@@ -1,4 +1,5 @@
 using AltTester.AltTesterSDK.Driver;
+using LyraTests.Config;
 using NUnit.Framework;
 
 namespace LyraTests.Helpers;
@@ -10,8 +11,18 @@ public static class AimingHelper
         driver.PressKey(AltKeyCode.Mouse0, holdSeconds);
     }
 
-    public static bool IsTargetVisible(AltDriver driver, AltObject target)
+    public static bool IsTargetVisible(AltDriver driver, AltObject target) => IsTargetVisible(driver, target, TryGetWorldContextId(driver));
+
+    /// <summary>
+    /// On screen and not occluded, from one engine-side visibility query matched to the target by position;
+    /// falls back to probing the object at the target's screen position when the query is unavailable or the
+    /// target is not an enemy.
+    /// </summary>
+    public static bool IsTargetVisible(AltDriver driver, AltObject target, int worldId)
     {
+        if (TryGetTestVisibility(driver, worldId, null, out var visibility)
+            && visibility!.FindNear(target.worldX, target.worldY, GetWorldZ(target)) is TestVisibilityRecord record)
+            return record.Visible;
         try
         {
             var pos = target.GetScreenPosition();
@@ -210,22 +221,13 @@ public static class AimingHelper
         }
     }
 
-    static int TryGetWorldContextId(AltDriver driver)
+    internal static int TryGetWorldContextId(AltDriver driver)
     {
         var controller = FindPlayerController(driver);
         if (controller != null)
         {
-            foreach (var comp in new[] { "PlayerController", "Controller", controller.type })
-            {
-                if (string.IsNullOrEmpty(comp)) continue;
-                try
-                {
-                    var worldId = controller.CallComponentMethod<int>(comp, "GetWorld", "Engine", Array.Empty<object>(), Array.Empty<string>());
-                    if (worldId != 0) return worldId;
-                }
-                catch { }
-            }
-            return controller.id;
+            int worldId = GetControllerWorldObjectId(controller);
+            return worldId != 0 ? worldId : controller.id;
         }
         try
         {
@@ -283,6 +285,8 @@ public static class AimingHelper
         playerPosition = null;
         enemyPositions = new List<(float, float, float)>();
         if (worldId == 0) return false;
+        if (TryGetTestSnapshot(driver, worldId, enemiesOnly: false, out var snapshot))
+            return PositionsFromSnapshot(snapshot!, out playerPosition, out enemyPositions, verboseLogging);
         try
         {
             var s = driver.CallStaticMethod<string>("LyraTestEnemyQuery", "GetTestPositionsAsString", "LyraGame",
@@ -307,6 +311,8 @@ public static class AimingHelper
         playerPosition = null;
         enemyPositions = new List<(float, float, float)>();
         if (worldId == 0) return false;
+        if (TryGetTestSnapshot(driver, worldId, enemiesOnly: true, out var snapshot))
+            return PositionsFromSnapshot(snapshot!, out playerPosition, out enemyPositions, verboseLogging);
         try
         {
             var s = driver.CallStaticMethod<string>("LyraTestEnemyQuery", "GetEnemyOnlyTestPositionsAsString", "LyraGame",
@@ -341,6 +347,286 @@ public static class AimingHelper
         catch { return false; }
     }
 
+    /// <summary>Harness cost summary from LyraTestEnemyQuery.GetTestStatsSummary (one "Scope calls=... avg_us=..." line per entry point).</summary>
+    public static bool TryGetTestStatsSummary(AltDriver driver, bool reset, out string summary)
+    {
+        summary = string.Empty;
+        if (!TryGetControllerAndWorldId(driver, out _, out int worldId) || worldId == 0) return false;
+        try
+        {
+            summary = driver.CallStaticMethod<string>("LyraTestEnemyQuery", "GetTestStatsSummary", "LyraGame",
+                new object[] { worldId, reset }, new string[] { "System.Int32", "System.Boolean" }) ?? string.Empty;
+            return summary.Length > 0;
+        }
+        catch { return false; }
+    }
+
+    /// <summary>Starts recording frame / GC / memory stats in the engine until <see cref="TryEndPerfCapture"/>.</summary>
+    public static bool TryBeginPerfCapture(AltDriver driver, int worldId, string name, float hitchThresholdMs = 50f)
+    {
+        if (worldId == 0) return false;
+        try
+        {
+            return driver.CallStaticMethod<bool>("LyraTestEnemyQuery", "BeginTestPerfCapture", "LyraGame",
+                new object[] { worldId, name, hitchThresholdMs }, new string[] { "System.Int32", "System.String", "System.Single" });
+        }
+        catch { return false; }
+    }
+
+    /// <summary>Ends the capture and gates it on its baseline (empty directory: the engine default); a missing baseline is seeded and passes.</summary>
+    public static bool TryEndPerfCapture(AltDriver driver, int worldId, string? baselineDirectory, bool updateBaseline, out TestPerfCapture? capture)
+    {
+        capture = null;
+        if (worldId == 0) return false;
+        try
+        {
+            var s = driver.CallStaticMethod<string>("LyraTestEnemyQuery", "EndTestPerfCapture", "LyraGame",
+                new object[] { worldId, baselineDirectory ?? string.Empty, updateBaseline }, new string[] { "System.Int32", "System.String", "System.Boolean" });
+            return TestPerfCapture.TryParse(s, out capture);
+        }
+        catch { return false; }
+    }
+
+    /// <summary>Starts a LyraTestSessionBootstrap session (empty map: current map); token is 0 when the bootstrap is unavailable.</summary>
+    public static bool TryStartTestSession(AltDriver driver, string map, string? experience, bool skipWarmup, double timeoutSeconds, out long token)
+    {
+        token = 0;
+        int worldId = TryGetWorldContextId(driver);
+        if (worldId == 0) return false;
+        try
+        {
+            token = driver.CallStaticMethod<long>("LyraTestEnemyQuery", "StartTestSession", "LyraGame",
+                new object[] { worldId, map, experience ?? string.Empty, 0, skipWarmup, (float)timeoutSeconds },
+                new string[] { "System.Int32", "System.String", "System.String", "System.Int32", "System.Boolean", "System.Single" });
+            return token != 0;
+        }
+        catch { return false; }
+    }
+
+    /// <summary>ELyraTestSessionState of a session: 0 None, 1 Traveling, 2 WaitForExperience, 3 WaitForPawn, 4 WaitForWarmup, 5 Ready, 6 Failed.</summary>
+    public static bool TryGetTestSessionState(AltDriver driver, long token, out int state)
+    {
+        state = 0;
+        int worldId = TryGetWorldContextId(driver);
+        if (worldId == 0) return false;
+        try
+        {
+            state = driver.CallStaticMethod<int>("LyraTestEnemyQuery", "GetTestSessionState", "LyraGame",
+                new object[] { worldId, token }, new string[] { "System.Int32", "System.Int64" });
+            return true;
+        }
+        catch { return false; }
+    }
+
+    /// <summary>The game's instance configuration (instance id, agent port, default map / experience, seed, bots); false when unavailable.</summary>
+    public static bool TryGetTestInstanceConfig(AltDriver driver, out TestInstanceConfig? config)
+    {
+        config = null;
+        int worldId = TryGetWorldContextId(driver);
+        if (worldId == 0) return false;
+        try
+        {
+            var s = driver.CallStaticMethod<string>("LyraTestEnemyQuery", "GetTestInstanceConfig", "LyraGame",
+                new object[] { worldId }, new string[] { "System.Int32" });
+            return TestInstanceConfig.TryParse(s, out config);
+        }
+        catch { return false; }
+    }
+
+    /// <summary>Turns the game's bot AI LOD (LyraTestBotLod) on or off with the given tier distances; freezeDistance 0 never freezes.</summary>
+    public static bool TrySetBotLodEnabled(AltDriver driver, bool enable, float fullDistance = 3000f, float reducedDistance = 6000f, float freezeDistance = 10000f)
+    {
+        int worldId = TryGetWorldContextId(driver);
+        if (worldId == 0) return false;
+        try
+        {
+            return driver.CallStaticMethod<bool>("LyraTestEnemyQuery", "SetTestBotLodEnabled", "LyraGame",
+                new object[] { worldId, enable, fullDistance, reducedDistance, freezeDistance },
+                new string[] { "System.Int32", "System.Boolean", "System.Single", "System.Single", "System.Single" });
+        }
+        catch { return false; }
+    }
+
+    public static bool TryGetBotLodCounts(AltDriver driver, out BotLodCounts? counts)
+    {
+        counts = null;
+        int worldId = TryGetWorldContextId(driver);
+        if (worldId == 0) return false;
+        try
+        {
+            var s = driver.CallStaticMethod<string>("LyraTestEnemyQuery", "GetTestBotLodCounts", "LyraGame",
+                new object[] { worldId }, new string[] { "System.Int32" });
+            return BotLodCounts.TryParse(s, out counts);
+        }
+        catch { return false; }
+    }
+
+    /// <summary>Starts an in-place world reset (LyraTestSupportSubsystem.ResetWorld); botCount / playerTeamId -1 keep the current ones, botTeamIds is comma separated.</summary>
+    public static bool TryResetTestWorld(AltDriver driver, int playerStartIndex, int botCount, string? botTeamIds, int playerTeamId, out long resetId)
+    {
+        resetId = 0;
+        int worldId = TryGetWorldContextId(driver);
+        if (worldId == 0) return false;
+        try
+        {
+            resetId = driver.CallStaticMethod<long>("LyraTestEnemyQuery", "ResetTestWorld", "LyraGame",
+                new object[] { worldId, 0, playerStartIndex, botCount, botTeamIds ?? string.Empty, playerTeamId },
+                new string[] { "System.Int32", "System.Int32", "System.Int32", "System.Int32", "System.String", "System.Int32" });
+            return resetId != 0;
+        }
+        catch { return false; }
+    }
+
+    /// <summary>0 unknown or superseded id, 1 running, 2 succeeded, 3 failed.</summary>
+    public static bool TryGetTestWorldResetState(AltDriver driver, long resetId, out int state)
+    {
+        state = 0;
+        int worldId = TryGetWorldContextId(driver);
+        if (worldId == 0) return false;
+        try
+        {
+            state = driver.CallStaticMethod<int>("LyraTestEnemyQuery", "GetTestWorldResetState", "LyraGame",
+                new object[] { worldId, resetId }, new string[] { "System.Int32", "System.Int64" });
+            return true;
+        }
+        catch { return false; }
+    }
+
+    public static bool TryGetTestSnapshot(AltDriver driver, int worldId, bool enemiesOnly, out TestSnapshot? snapshot)
+    {
+        snapshot = null;
+        if (worldId == 0) return false;
+        try
+        {
+            var s = driver.CallStaticMethod<string>("LyraTestEnemyQuery", "GetTestSnapshotBase64", "LyraGame",
+                new object[] { worldId, 0, enemiesOnly }, new string[] { "System.Int32", "System.Int32", "System.Boolean" });
+            return TestSnapshot.TryDecodeBase64(s, out snapshot);
+        }
+        catch { return false; }
+    }
+
+    /// <summary>
+    /// Screen position, bounds, crosshair offset and occlusion of every alive enemy (<paramref name="ids"/> null or
+    /// empty) or of each handle in order, all from the same game frame.
+    /// </summary>
+    public static bool TryGetTestVisibility(AltDriver driver, int worldId, IEnumerable<long>? ids, out TestVisibility? visibility)
+    {
+        visibility = null;
+        if (worldId == 0) return false;
+        try
+        {
+            var s = driver.CallStaticMethod<string>("LyraTestEnemyQuery", "GetTestVisibilityBase64", "LyraGame",
+                new object[] { worldId, 0, ids == null ? string.Empty : string.Join(",", ids) },
+                new string[] { "System.Int32", "System.Int32", "System.String" });
+            return TestVisibility.TryDecodeBase64(s, out visibility);
+        }
+        catch { return false; }
+    }
+
+    /// <summary>Player record followed by one record per handle, in order; stale handles come back with <c>Stale</c> set.</summary>
+    public static bool TryResolveTestHandles(AltDriver driver, int worldId, IEnumerable<long> ids, out TestSnapshot? snapshot)
+    {
+        snapshot = null;
+        if (worldId == 0) return false;
+        try
+        {
+            var s = driver.CallStaticMethod<string>("LyraTestEnemyQuery", "ResolveTestHandlesBase64", "LyraGame",
+                new object[] { worldId, 0, string.Join(",", ids) }, new string[] { "System.Int32", "System.Int32", "System.String" });
+            return TestSnapshot.TryDecodeBase64(s, out snapshot);
+        }
+        catch { return false; }
+    }
+
+    /// <summary>Engine object name for a handle, for an exact <c>By.NAME</c> lookup instead of a substring scan.</summary>
+    public static bool TryGetTestObjectName(AltDriver driver, int worldId, long id, out string name)
+    {
+        name = string.Empty;
+        if (worldId == 0 || id == 0) return false;
+        try
+        {
+            name = driver.CallStaticMethod<string>("LyraTestEnemyQuery", "GetTestObjectName", "LyraGame",
+                new object[] { worldId, id }, new string[] { "System.Int32", "System.Int64" }) ?? string.Empty;
+            return name.Length > 0;
+        }
+        catch { return false; }
+    }
+
+    /// <summary>Resolves a handle to its AltTester object by exact name; null when the handle is stale.</summary>
+    public static AltObject? TryFindObjectByHandle(AltDriver driver, int worldId, long id)
+    {
+        if (!TryGetTestObjectName(driver, worldId, id, out var name)) return null;
+        foreach (var enabled in new[] { true, false })
+        {
+            try
+            {
+                var obj = driver.FindObject(By.NAME, name, enabled: enabled);
+                if (obj != null) return obj;
+            }
+            catch { }
+        }
+        return null;
+    }
+
+    /// <summary>Player plus the <paramref name="count"/> enemies nearest to the point (maxDistance 0 = any), nearest first.</summary>
+    public static bool TryGetNearestEnemies(AltDriver driver, int worldId, float x, float y, float z, int count, float maxDistance, out TestSnapshot? snapshot)
+    {
+        snapshot = null;
+        if (worldId == 0) return false;
+        try
+        {
+            var s = driver.CallStaticMethod<string>("LyraTestEnemyQuery", "GetNearestEnemiesBase64", "LyraGame",
+                new object[] { worldId, 0, x, y, z, count, maxDistance, true },
+                new string[] { "System.Int32", "System.Int32", "System.Single", "System.Single", "System.Single", "System.Int32", "System.Single", "System.Boolean" });
+            return TestSnapshot.TryDecodeBase64(s, out snapshot);
+        }
+        catch { return false; }
+    }
+
+    public static bool TryGetEnemiesInRadius(AltDriver driver, int worldId, float x, float y, float z, float radius, out TestSnapshot? snapshot)
+    {
+        snapshot = null;
+        if (worldId == 0) return false;
+        try
+        {
+            var s = driver.CallStaticMethod<string>("LyraTestEnemyQuery", "GetEnemiesInRadiusBase64", "LyraGame",
+                new object[] { worldId, 0, x, y, z, radius, true },
+                new string[] { "System.Int32", "System.Int32", "System.Single", "System.Single", "System.Single", "System.Single", "System.Boolean" });
+            return TestSnapshot.TryDecodeBase64(s, out snapshot);
+        }
+        catch { return false; }
+    }
+
+    /// <summary>Enemies within halfAngleDegrees of the player's camera direction (maxDistance 0 = any), nearest first.</summary>
+    public static bool TryGetEnemiesInViewCone(AltDriver driver, int worldId, float halfAngleDegrees, float maxDistance, out TestSnapshot? snapshot)
+    {
+        snapshot = null;
+        if (worldId == 0) return false;
+        try
+        {
+            var s = driver.CallStaticMethod<string>("LyraTestEnemyQuery", "GetEnemiesInViewConeBase64", "LyraGame",
+                new object[] { worldId, 0, halfAngleDegrees, maxDistance, true },
+                new string[] { "System.Int32", "System.Int32", "System.Single", "System.Single", "System.Boolean" });
+            return TestSnapshot.TryDecodeBase64(s, out snapshot);
+        }
+        catch { return false; }
+    }
+
+    internal static bool PositionsFromSnapshot(TestSnapshot snapshot, out (float x, float y, float z)? playerPosition, out List<(float x, float y, float z)> enemyPositions, bool log = false)
+    {
+        playerPosition = null;
+        enemyPositions = new List<(float, float, float)>(snapshot.Records.Count);
+        foreach (var r in snapshot.Records)
+        {
+            var p = ((float)r.Position.x, (float)r.Position.y, (float)r.Position.z);
+            if (r.Kind == TestSnapshotRecordKind.Player)
+                playerPosition = p;
+            else if (r.Alive)
+                enemyPositions.Add(p);
+        }
+        if (log) Console.WriteLine($"[EnginePositions] Snapshot v{snapshot.Version} frame={snapshot.FrameNumber} player={playerPosition.HasValue} enemies={enemyPositions.Count}");
+        return enemyPositions.Count > 0 || playerPosition.HasValue;
+    }
+
     static bool ParseTestPositionsString(string s, out (float x, float y, float z)? playerPosition, out List<(float x, float y, float z)> enemyPositions, bool log = false)
     {
         playerPosition = null;
@@ -497,17 +783,74 @@ public static class AimingHelper
         return false;
     }
 
-    public static bool TrySetLocalPlayerInvincible(AltDriver driver, bool bEnable)
+    /// <summary>
+    /// One call replaces the UpdateLookAtFromTo step loop: the game's aim tick component rotates toward the
+    /// target every frame (critically damped, rate-limited) and publishes AimSettled when on target.
+    /// </summary>
+    public static bool TryStartAimTracking(AltDriver driver, long targetId = 0, bool fireWhenSettled = false, int playerIndex = 0)
+    {
+        return TryCallSubsystemMethod(driver, "StartAimTracking",
+            new object[] { playerIndex, targetId, fireWhenSettled }, new string[] { "System.Int32", "System.Int64", "System.Boolean" });
+    }
+
+    public static bool TryTrackWorldPosition(AltDriver driver, float targetX, float targetY, float targetZ, bool fireWhenSettled = false, int playerIndex = 0)
+    {
+        return TryCallSubsystemMethod(driver, "StartAimTrackingWorldPosition",
+            new object[] { playerIndex, targetX, targetY, targetZ, fireWhenSettled }, new string[] { "System.Int32", "System.Single", "System.Single", "System.Single", "System.Boolean" });
+    }
+
+    public static bool TryStopAimTracking(AltDriver driver, int playerIndex = 0)
+    {
+        return TryCallSubsystemMethod(driver, "StopAimTracking", new object[] { playerIndex }, new string[] { "System.Int32" });
+    }
+
+    public static bool TryStartFirePattern(AltDriver driver, int shotCount, int holdFrames = 3, int intervalFrames = 6, int playerIndex = 0)
+    {
+        return TryCallSubsystemMethod(driver, "StartFirePattern", new object[] { playerIndex, shotCount, holdFrames, intervalFrames },
+            new string[] { "System.Int32", "System.Int32", "System.Int32", "System.Int32" });
+    }
+
+    public static bool TryStopFirePattern(AltDriver driver, int playerIndex = 0)
     {
-        if (TrySetInvincibleViaSubsystem(driver, bEnable)) return true;
-        if (TrySetInvincibleViaQuery(driver, bEnable)) return true;
+        return TryCallSubsystemMethod(driver, "StopFirePattern", new object[] { playerIndex }, new string[] { "System.Int32" });
+    }
+
+    public static bool TrySetFastForward(AltDriver driver, bool enable, float fixedDeltaSeconds = 1f / 60f, float timeDilation = 1f)
+    {
+        return TryCallSubsystemMethod(driver, "SetFastForwardEnabled", new object[] { enable, fixedDeltaSeconds, timeDilation },
+            new string[] { "System.Boolean", "System.Single", "System.Single" });
+    }
+
+    static bool TryCallSubsystemMethod(AltDriver driver, string methodName, object[] args, string[] typeNames)
+    {
+        var sub = FindTestSupportSubsystem(driver);
+        if (sub == null) return false;
+        foreach (var typeName in new[] { TestSupportSubsystemType, "ULyraTestSupportSubsystem", sub.type })
+        {
+            if (string.IsNullOrEmpty(typeName)) continue;
+            foreach (var asm in new[] { "LyraGame", "Core" })
+                try
+                {
+                    var result = sub.CallComponentMethod<string>(typeName, methodName, asm, args, typeNames);
+                    return !string.Equals(result, "false", StringComparison.OrdinalIgnoreCase);
+                }
+                catch { }
+        }
+        _cachedSubsystem = null;
+        return false;
+    }
+
+    public static bool TrySetLocalPlayerInvincible(AltDriver driver, bool bEnable, int playerIndex = 0)
+    {
+        if (playerIndex == 0 && TrySetInvincibleViaSubsystem(driver, bEnable)) return true;
+        if (TrySetInvincibleViaQuery(driver, bEnable, playerIndex)) return true;
         return false;
     }
 
-    public static bool TrySetLocalPlayerInfiniteAmmo(AltDriver driver, bool bEnable)
+    public static bool TrySetLocalPlayerInfiniteAmmo(AltDriver driver, bool bEnable, int playerIndex = 0)
     {
-        if (TrySetInfiniteAmmoViaSubsystem(driver, bEnable)) return true;
-        if (TrySetInfiniteAmmoViaQuery(driver, bEnable)) return true;
+        if (playerIndex == 0 && TrySetInfiniteAmmoViaSubsystem(driver, bEnable)) return true;
+        if (TrySetInfiniteAmmoViaQuery(driver, bEnable, playerIndex)) return true;
         return false;
     }
 
@@ -555,7 +898,7 @@ public static class AimingHelper
         return false;
     }
 
-    static bool TrySetInvincibleViaQuery(AltDriver driver, bool bEnable)
+    static bool TrySetInvincibleViaQuery(AltDriver driver, bool bEnable, int playerIndex)
     {
         if (!TryGetControllerAndWorldId(driver, out _, out int worldId) || worldId == 0) return false;
         foreach (var typeName in new[] { "LyraTestEnemyQuery", "ULyraTestEnemyQuery" })
@@ -564,7 +907,7 @@ public static class AimingHelper
             try
             {
                 driver.CallStaticMethod<object>(typeName, "SetLocalPlayerInvincible", asm,
-                    new object[] { worldId, bEnable }, new string[] { "System.Int32", "System.Boolean" });
+                    new object[] { worldId, bEnable, playerIndex }, new string[] { "System.Int32", "System.Boolean", "System.Int32" });
                 return true;
             }
             catch { }
@@ -572,7 +915,7 @@ public static class AimingHelper
         return false;
     }
 
-    static bool TrySetInfiniteAmmoViaQuery(AltDriver driver, bool bEnable)
+    static bool TrySetInfiniteAmmoViaQuery(AltDriver driver, bool bEnable, int playerIndex)
     {
         if (!TryGetControllerAndWorldId(driver, out _, out int worldId) || worldId == 0) return false;
         foreach (var typeName in new[] { "LyraTestEnemyQuery", "ULyraTestEnemyQuery" })
@@ -581,7 +924,7 @@ public static class AimingHelper
             try
             {
                 driver.CallStaticMethod<object>(typeName, "SetLocalPlayerInfiniteAmmo", asm,
-                    new object[] { worldId, bEnable }, new string[] { "System.Int32", "System.Boolean" });
+                    new object[] { worldId, bEnable, playerIndex }, new string[] { "System.Int32", "System.Boolean", "System.Int32" });
                 return true;
             }
             catch { }
@@ -589,8 +932,28 @@ public static class AimingHelper
         return false;
     }
 
+    /// <summary>Bit 0 invincible and bit 1 infinite ammo requested, bit 2 god mode active. False on builds without persistent cheats.</summary>
+    public static bool TryGetTestCheatState(AltDriver driver, out int state)
+    {
+        state = 0;
+        int worldId = TryGetWorldContextId(driver);
+        if (worldId == 0) return false;
+        try
+        {
+            state = driver.CallStaticMethod<int>("LyraTestEnemyQuery", "GetLocalPlayerCheatState", "LyraGame",
+                new object[] { worldId, 0 }, new string[] { "System.Int32", "System.Int32" });
+            return true;
+        }
+        catch { return false; }
+    }
+
+    /// <summary>The engine re-applies requested cheats on respawn and weapon changes, so they only need to be requested once.</summary>
+    public static bool AreTestCheatsPersistent(AltDriver driver) => TryGetTestCheatState(driver, out _);
+
     public static void EnsureTestCheatsApplied(AltDriver driver, bool bEnable, int maxAttempts = 3, int delayMs = 2000)
     {
+        if (TryGetTestCheatState(driver, out int state) && (state & 3) == (bEnable ? 3 : 0))
+            return;
         for (int attempt = 1; attempt <= maxAttempts; attempt++)
         {
             bool inv = TrySetLocalPlayerInvincible(driver, bEnable);
@@ -894,8 +1257,59 @@ public static class AimingHelper
         }
     }
 
+    static int GetControllerWorldObjectId(AltObject controller)
+    {
+        foreach (var comp in new[] { "PlayerController", "Controller", controller.type })
+        {
+            if (string.IsNullOrEmpty(comp)) continue;
+            try
+            {
+                var worldId = controller.CallComponentMethod<int>(comp, "GetWorld", "Engine", Array.Empty<object>(), Array.Empty<string>());
+                if (worldId != 0) return worldId;
+            }
+            catch { }
+        }
+        return 0;
+    }
+
+    static AltObject? _worldPlayerController;
+
+    /// <summary>
+    /// With several game worlds in one process (ALTTESTER_WORLD_ID set), the player controller of that world by its
+    /// LyraTestWorlds id; cached and re-checked on every call, since map travel replaces the controller.
+    /// </summary>
+    internal static AltObject? FindWorldPlayerController(AltDriver driver, int testWorldId)
+    {
+        if (_worldPlayerController != null && GetControllerTestWorldId(driver, _worldPlayerController) == testWorldId)
+            return _worldPlayerController;
+        _worldPlayerController = null;
+        List<AltObject>? controllers = null;
+        try { controllers = driver.FindObjectsWhichContain(By.NAME, "PlayerController", enabled: false); }
+        catch { }
+        foreach (var controller in controllers ?? new List<AltObject>())
+        {
+            if (GetControllerTestWorldId(driver, controller) == testWorldId)
+                return _worldPlayerController = controller;
+        }
+        return null;
+    }
+
+    static int GetControllerTestWorldId(AltDriver driver, AltObject controller)
+    {
+        int worldId = GetControllerWorldObjectId(controller);
+        if (worldId == 0) return -1;
+        try
+        {
+            return driver.CallStaticMethod<int>("LyraTestEnemyQuery", "GetTestWorldId", "LyraGame",
+                new object[] { worldId }, new string[] { "System.Int32" });
+        }
+        catch { return -1; }
+    }
+
     static AltObject? FindPlayerController(AltDriver driver)
     {
+        if (AltDriverConfig.WorldId >= 0)
+            return FindWorldPlayerController(driver, AltDriverConfig.WorldId);
         try
         {
             var byName = driver.FindObjectWhichContains(By.NAME, "LyraPlayerController", enabled: false);
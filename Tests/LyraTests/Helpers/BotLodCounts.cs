@@ -0,0 +1,42 @@
+using System.Text.Json;
+
+namespace LyraTests.Helpers;
+
+/// <summary>Result of <c>LyraTestEnemyQuery.GetTestBotLodCounts</c>: alive bots per AI LOD tier.</summary>
+public sealed class BotLodCounts
+{
+    public bool Enabled { get; init; }
+    public int Full { get; init; }
+    public int Reduced { get; init; }
+    public int NoPerception { get; init; }
+    public int Frozen { get; init; }
+
+    public int Total => Full + Reduced + NoPerception + Frozen;
+
+    public override string ToString() =>
+        $"bot LOD {(Enabled ? "on" : "off")}: {Full} full, {Reduced} reduced, {NoPerception} no perception, {Frozen} frozen";
+
+    public static bool TryParse(string? json, out BotLodCounts? counts)
+    {
+        counts = null;
+        if (string.IsNullOrWhiteSpace(json)) return false;
+        try
+        {
+            using var doc = JsonDocument.Parse(json);
+            var root = doc.RootElement;
+            counts = new BotLodCounts
+            {
+                Enabled = root.GetProperty("enabled").GetBoolean(),
+                Full = root.GetProperty("full").GetInt32(),
+                Reduced = root.GetProperty("reduced").GetInt32(),
+                NoPerception = root.GetProperty("noPerception").GetInt32(),
+                Frozen = root.GetProperty("frozen").GetInt32()
+            };
+            return true;
+        }
+        catch (Exception e) when (e is JsonException or KeyNotFoundException or InvalidOperationException or FormatException)
+        {
+            return false;
+        }
+    }
+}
@@ -0,0 +1,113 @@
+using System.Buffers.Binary;
+using AltTester.AltTesterSDK.Driver;
+
+namespace LyraTests.Helpers;
+
+public enum CombatRecordKind : byte
+{
+    Damage = 0,
+    Kill = 1
+}
+
+public readonly record struct CombatRecord(
+    long Sequence,
+    long FrameNumber,
+    double WorldTimeSeconds,
+    CombatRecordKind Kind,
+    float Damage,
+    long InstigatorId,
+    long VictimId,
+    long WeaponId,
+    (float x, float y, float z) HitLocation,
+    float VictimHealth);
+
+/// <summary>
+/// Reads the sequenced damage/kill log kept by LyraTestSupportSubsystem. Remember GetLatestSequence before
+/// shooting, then a single FindKillSince call confirms the kill.
+/// </summary>
+public static class CombatLog
+{
+    public const uint Magic = 0x4C43544C;
+    public const ushort SupportedVersion = 1;
+    public const int HeaderSize = 16;
+    public const int MinRecordStride = 72;
+
+    public static bool TryGetLatestSequence(AltDriver driver, int worldId, out long sequence)
+    {
+        sequence = 0;
+        if (worldId == 0) return false;
+        try
+        {
+            sequence = driver.CallStaticMethod<long>("LyraTestEnemyQuery", "GetLatestCombatSequence", "LyraGame",
+                new object[] { worldId }, new string[] { "System.Int32" });
+            return true;
+        }
+        catch { return false; }
+    }
+
+    public static long TryGetLocalPlayerPawnId(AltDriver driver, int worldId)
+    {
+        if (worldId == 0) return 0;
+        try
+        {
+            return driver.CallStaticMethod<long>("LyraTestEnemyQuery", "GetLocalPlayerPawnId", "LyraGame",
+                new object[] { worldId, 0 }, new string[] { "System.Int32", "System.Int32" });
+        }
+        catch { return 0; }
+    }
+
+    public static bool TryFindKillSince(AltDriver driver, int worldId, long sinceSequence, out long killSequence, long victimId = 0, long instigatorId = 0)
+    {
+        killSequence = 0;
+        if (worldId == 0) return false;
+        try
+        {
+            killSequence = driver.CallStaticMethod<long>("LyraTestEnemyQuery", "FindKillSince", "LyraGame",
+                new object[] { worldId, sinceSequence, victimId, instigatorId }, new string[] { "System.Int32", "System.Int64", "System.Int64", "System.Int64" });
+            return killSequence != 0;
+        }
+        catch { return false; }
+    }
+
+    public static bool TryReadSince(AltDriver driver, int worldId, long sinceSequence, out List<CombatRecord> records, int maxRecords = 0)
+    {
+        records = new List<CombatRecord>();
+        if (worldId == 0) return false;
+        try
+        {
+            var s = driver.CallStaticMethod<string>("LyraTestEnemyQuery", "GetCombatLogSinceBase64", "LyraGame",
+                new object[] { worldId, sinceSequence, maxRecords }, new string[] { "System.Int32", "System.Int64", "System.Int32" });
+            if (string.IsNullOrWhiteSpace(s)) return false;
+            return TryDecode(Convert.FromBase64String(s.Trim()), records);
+        }
+        catch { return false; }
+    }
+
+    public static bool TryDecode(ReadOnlySpan<byte> data, List<CombatRecord> records)
+    {
+        if (data.Length < HeaderSize) return false;
+        if (BinaryPrimitives.ReadUInt32LittleEndian(data) != Magic) return false;
+        ushort version = BinaryPrimitives.ReadUInt16LittleEndian(data.Slice(4));
+        ushort stride = BinaryPrimitives.ReadUInt16LittleEndian(data.Slice(6));
+        uint count = BinaryPrimitives.ReadUInt32LittleEndian(data.Slice(8));
+        if (version == 0 || version > SupportedVersion || stride < MinRecordStride) return false;
+        if ((long)HeaderSize + (long)count * stride > data.Length) return false;
+
+        for (int i = 0; i < count; i++)
+        {
+            var r = data.Slice(HeaderSize + i * stride, stride);
+            records.Add(new CombatRecord(
+                BinaryPrimitives.ReadInt64LittleEndian(r),
+                (long)BinaryPrimitives.ReadUInt64LittleEndian(r.Slice(8)),
+                BinaryPrimitives.ReadDoubleLittleEndian(r.Slice(16)),
+                (CombatRecordKind)r[24],
+                BinaryPrimitives.ReadSingleLittleEndian(r.Slice(28)),
+                BinaryPrimitives.ReadInt64LittleEndian(r.Slice(32)),
+                BinaryPrimitives.ReadInt64LittleEndian(r.Slice(40)),
+                BinaryPrimitives.ReadInt64LittleEndian(r.Slice(48)),
+                (BinaryPrimitives.ReadSingleLittleEndian(r.Slice(56)), BinaryPrimitives.ReadSingleLittleEndian(r.Slice(60)), BinaryPrimitives.ReadSingleLittleEndian(r.Slice(64))),
+                BinaryPrimitives.ReadSingleLittleEndian(r.Slice(68))));
+        }
+        return true;
+    }
+}
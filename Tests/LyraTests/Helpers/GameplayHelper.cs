@@ -22,8 +22,25 @@ public static class GameplayHelper
     public static void EnterGameplay(AltDriver driver, double gameplayTimeoutSeconds = 60, bool useMenuOnly = false)
     {
         string? aimTestMap = AltDriverConfig.AimTestMap;
+        string? aimTestExperience = AltDriverConfig.AimTestExperience;
+        // Sharded runs take the map the coordinator gave the game instance.
+        if (string.IsNullOrEmpty(aimTestMap) && AltDriverConfig.InstanceId >= 0
+            && AimingHelper.TryGetTestInstanceConfig(driver, out var instance) && !string.IsNullOrEmpty(instance!.Map))
+        {
+            aimTestMap = instance.Map;
+            aimTestExperience = string.IsNullOrEmpty(instance.Experience) ? null : instance.Experience;
+        }
         if (!string.IsNullOrEmpty(aimTestMap))
         {
+            // A previous test class already loaded the map: put it back into a known state instead of reloading.
+            if (driver.GetCurrentScene() == aimTestMap && TryResetWorld(driver))
+            {
+                _ = AimingHelper.TrySetLocalPlayerInvincible(driver, true);
+                _ = AimingHelper.TrySetLocalPlayerInfiniteAmmo(driver, true);
+                return;
+            }
+            if (TryEnterTestSession(driver, aimTestMap, aimTestExperience, gameplayTimeoutSeconds))
+                return;
             driver.LoadScene(aimTestMap);
             driver.WaitForCurrentSceneToBe(aimTestMap, timeout: gameplayTimeoutSeconds);
             var scene = driver.GetCurrentScene();
@@ -33,6 +50,7 @@ public static class GameplayHelper
             _ = AimingHelper.TrySetLocalPlayerInvincible(driver, true);
             _ = AimingHelper.TrySetLocalPlayerInfiniteAmmo(driver, true);
             AimingHelper.EnsureTestCheatsApplied(driver, bEnable: true, maxAttempts: 5, delayMs: 1000);
+            bool persistentCheats = AimingHelper.AreTestCheatsPersistent(driver);
             Thread.Sleep(1000);
             double pawnWaitSeconds = Math.Min(60, gameplayTimeoutSeconds);
             AltObject? pawn = PlayerFinder.TryWaitForPlayerPawn(driver, timeoutSeconds: pawnWaitSeconds);
@@ -40,14 +58,19 @@ public static class GameplayHelper
             var postDeadline = DateTime.UtcNow.AddSeconds(postLobbySeconds);
             while (DateTime.UtcNow < postDeadline)
             {
-                _ = AimingHelper.TrySetLocalPlayerInvincible(driver, true);
-                _ = AimingHelper.TrySetLocalPlayerInfiniteAmmo(driver, true);
+                if (!persistentCheats)
+                {
+                    _ = AimingHelper.TrySetLocalPlayerInvincible(driver, true);
+                    _ = AimingHelper.TrySetLocalPlayerInfiniteAmmo(driver, true);
+                }
                 if (pawn == null)
                     pawn = PlayerFinder.GetPlayerPawn(driver);
                 if (pawn != null)
                     break;
                 Thread.Sleep(2000);
             }
+            if (persistentCheats)
+                return;
             Thread.Sleep(2000);
             _ = AimingHelper.TrySetLocalPlayerInvincible(driver, true);
             _ = AimingHelper.TrySetLocalPlayerInfiniteAmmo(driver, true);
@@ -67,13 +90,70 @@ public static class GameplayHelper
         Thread.Sleep(1500);
     }
 
+    /// <summary>
+    /// Loads map + experience through LyraTestSessionBootstrap and waits for its SessionReady event (pawn possessed,
+    /// cheats applied, warm-up over). False when the bootstrap is not in the build or the session failed.
+    /// </summary>
+    public static bool TryEnterTestSession(AltDriver driver, string map, string? experience, double timeoutSeconds = 60)
+    {
+        var feed = TestEventFeed.TryOpen(driver);
+        if (!AimingHelper.TryStartTestSession(driver, map, experience, skipWarmup: true, timeoutSeconds, out long token))
+            return false;
+        const int ReadyState = 5, FailedState = 6;
+        var deadline = DateTime.UtcNow.AddSeconds(timeoutSeconds);
+        while (DateTime.UtcNow < deadline)
+        {
+            // The event is the fast path; the state poll covers a feed that could not be opened or missed the event.
+            if (feed != null && feed.WaitFor(e => e.Type == TestEventType.SessionReady && (long)e.Value == token, 1, out _))
+                return true;
+            if (feed == null)
+                Thread.Sleep(250);
+            if (AimingHelper.TryGetTestSessionState(driver, token, out int state))
+            {
+                if (state == ReadyState) return true;
+                if (state == FailedState || state == 0) return false;
+            }
+        }
+        return false;
+    }
+
+    /// <summary>
+    /// Resets the loaded map in place (player respawned or healed at a start, bots to botCount / botTeamIds,
+    /// combat log and scores cleared) and waits for its WorldReset event. False when unsupported or failed.
+    /// </summary>
+    public static bool TryResetWorld(AltDriver driver, int botCount = -1, string? botTeamIds = null, int playerStartIndex = -1, int playerTeamId = -1, double timeoutSeconds = 10)
+    {
+        var feed = TestEventFeed.TryOpen(driver);
+        if (!AimingHelper.TryResetTestWorld(driver, playerStartIndex, botCount, botTeamIds, playerTeamId, out long resetId))
+            return false;
+        const int SucceededState = 2;
+        if (feed != null)
+            feed.WaitFor(e => e.Type == TestEventType.WorldReset && (long)e.Value == resetId, timeoutSeconds, out _);
+        var deadline = DateTime.UtcNow.AddSeconds(feed != null ? 1 : timeoutSeconds);
+        while (true)
+        {
+            if (AimingHelper.TryGetTestWorldResetState(driver, resetId, out int state) && state != 1)
+                return state == SucceededState;
+            if (DateTime.UtcNow >= deadline) return false;
+            Thread.Sleep(100);
+        }
+    }
+
     public static bool SetupInGameTest(AltDriver driver, double waitSeconds = 30)
     {
+        // Opened at the latest event so possessions from earlier sessions or dead pawns still in the ring don't count.
+        var feed = waitSeconds > 0 ? TestEventFeed.TryOpen(driver) : null;
         _ = AimingHelper.TrySetLocalPlayerInvincible(driver, true);
         _ = AimingHelper.TrySetLocalPlayerInfiniteAmmo(driver, true);
         AimingHelper.EnsureTestCheatsApplied(driver, bEnable: true, maxAttempts: AltDriverConfig.SetupCheatMaxAttempts, delayMs: AltDriverConfig.SetupCheatDelayMs);
+        bool persistentCheats = AimingHelper.AreTestCheatsPersistent(driver);
         if (waitSeconds > 0)
-            Thread.Sleep((int)(waitSeconds * 1000));
+        {
+            if (feed == null)
+                Thread.Sleep((int)(waitSeconds * 1000));
+            else if (FindPlayerCharacter(driver) == null)
+                feed.WaitFor(TestEventType.PawnPossessed, waitSeconds, out _);
+        }
         int pollMs = AltDriverConfig.SetupPlayerWaitPollMs;
         int maxIter = AltDriverConfig.SetupPlayerWaitMaxIterations;
         for (int k = 0; k < maxIter; k++)
@@ -81,6 +161,8 @@ public static class GameplayHelper
             if (FindPlayerCharacter(driver) != null) break;
             Thread.Sleep(pollMs);
         }
+        if (persistentCheats)
+            return true;
         Thread.Sleep(AltDriverConfig.SetupAfterPlayerWaitSleepMs);
         _ = AimingHelper.TrySetLocalPlayerInvincible(driver, true);
         _ = AimingHelper.TrySetLocalPlayerInfiniteAmmo(driver, true);
@@ -227,6 +309,8 @@ public static class GameplayHelper
         {
             try
             {
+                var viaHandle = TryFindEnemyBotViaHandle(driver);
+                if (viaHandle != null && viaHandle.id != playerId) return viaHandle;
                 foreach (var name in PawnNamePatterns)
                 {
                     var pawns = driver.FindObjectsWhichContain(By.NAME, name, enabled: true);
@@ -246,6 +330,25 @@ public static class GameplayHelper
         return null;
     }
 
+    // Nearest alive enemy from the engine snapshot, looked up by its exact object name.
+    private static AltObject? TryFindEnemyBotViaHandle(AltDriver driver)
+    {
+        int worldId = AimingHelper.TryGetWorldContextId(driver);
+        if (!AimingHelper.TryGetTestSnapshot(driver, worldId, enemiesOnly: true, out var snapshot)) return null;
+        var player = snapshot!.Records.FirstOrDefault(r => r.Kind == TestSnapshotRecordKind.Player);
+        var enemy = snapshot.Enemies
+            .Where(r => r.Alive)
+            .OrderBy(r => DistanceSquared(r.Position, player.Position))
+            .FirstOrDefault();
+        return enemy.Id == 0 ? null : AimingHelper.TryFindObjectByHandle(driver, worldId, enemy.Id);
+    }
+
+    private static double DistanceSquared((double x, double y, double z) a, (double x, double y, double z) b)
+    {
+        double dx = a.x - b.x, dy = a.y - b.y, dz = a.z - b.z;
+        return dx * dx + dy * dy + dz * dz;
+    }
+
     private static AltObject? FirstEnemyFromList(List<AltObject>? list, int playerId, int? playerTeamId, AltDriver driver)
     {
         if (list == null || list.Count == 0) return null;
@@ -475,11 +578,29 @@ public static class GameplayHelper
     public static bool WaitUntilTargetVisible(AltDriver driver, AltObject target, double timeoutSeconds = 15, int pollMs = 150)
     {
         var deadline = DateTime.UtcNow.AddSeconds(timeoutSeconds);
+        int worldId = AimingHelper.TryGetWorldContextId(driver);
+        long handle = 0;
         while (DateTime.UtcNow < deadline)
         {
-            var current = FindObjectById(driver, target.id);
-            if (current != null && AimingHelper.IsTargetVisible(driver, current))
-                return true;
+            // Once the target's engine handle is known, each poll is a single visibility call.
+            if (handle != 0 && AimingHelper.TryGetTestVisibility(driver, worldId, new[] { handle }, out var tracked) && tracked!.Records.Count == 1)
+            {
+                var record = tracked.Records[0];
+                if (record.Visible) return true;
+                if (record.Stale) return false;
+            }
+            else
+            {
+                var current = FindObjectById(driver, target.id);
+                if (current != null && AimingHelper.TryGetTestVisibility(driver, worldId, null, out var all)
+                    && all!.FindNear(current.worldX, current.worldY, AimingHelper.GetWorldZ(current)) is TestVisibilityRecord found)
+                {
+                    handle = found.Id;
+                    if (found.Visible) return true;
+                }
+                else if (current != null && AimingHelper.IsTargetVisible(driver, current, 0))
+                    return true;
+            }
             Thread.Sleep(pollMs);
         }
         return false;
@@ -492,6 +613,12 @@ public static class GameplayHelper
         float lastDist = float.MaxValue;
         int stuckCount = 0;
         int iterations = 0;
+        bool trackingUsed = false;
+        bool Finish(bool reached)
+        {
+            if (trackingUsed) AimingHelper.TryStopAimTracking(driver);
+            return reached;
+        }
 
         while (DateTime.UtcNow < deadline)
         {
@@ -502,11 +629,11 @@ public static class GameplayHelper
             var player = FindObjectById(driver, playerId);
             var targetObj = FindObjectById(driver, target.id);
             if (player == null || targetObj == null)
-                return false;
+                return Finish(false);
 
             float dist = HorizontalDistance(player, targetObj);
             if (dist <= options.CloseEnoughDistance)
-                return true;
+                return Finish(true);
 
             if (dist >= lastDist - options.StuckDistanceThreshold)
                 stuckCount++;
@@ -529,8 +656,13 @@ public static class GameplayHelper
 
             const int frameMs = 16;
             int burstFrames = Math.Max(1, (int)(options.MoveBurstSeconds * 1000 / frameMs));
+            var (bx, by, bz) = AimingHelper.GetTargetAimPoint(targetObj);
+            bool tracking = AimingHelper.TryTrackWorldPosition(driver, bx, by, bz);
+            trackingUsed |= tracking;
             driver.KeyDown(AltKeyCode.W);
-            for (int f = 0; f < burstFrames; f++)
+            if (tracking)
+                Thread.Sleep(burstFrames * frameMs);
+            for (int f = 0; !tracking && f < burstFrames; f++)
             {
                 var p = FindObjectById(driver, playerId);
                 var t = FindObjectById(driver, target.id);
@@ -551,6 +683,6 @@ public static class GameplayHelper
             Thread.Sleep(options.PollMs);
         }
 
-        return false;
+        return Finish(false);
     }
 }
@@ -4,6 +4,7 @@ using System.Diagnostics;
 using System.Linq;
 using System.Threading;
 using AltTester.AltTesterSDK.Driver;
+using LyraTests.Config;
 using NUnit.Framework;
 
 namespace LyraTests.Helpers;
@@ -12,6 +13,12 @@ public static class PlayerFinder
 {
     public static AltObject? GetPlayerPawn(AltDriver driver)
     {
+        var viaHandle = TryGetPlayerPawnViaHandle(driver);
+        if (viaHandle != null)
+        {
+            LogPlayerFound(viaHandle, "GetLocalPlayerPawnId");
+            return viaHandle;
+        }
         var candidates = GetCharacterCandidates(driver);
         var knownController = FindPlayerController(driver);
         foreach (var c in candidates)
@@ -44,12 +51,6 @@ public static class PlayerFinder
             LogPlayerFound(viaStatics, "GameplayStatics");
             return viaStatics;
         }
-        var viaEngineId = TryGetPlayerPawnViaEngineId(driver);
-        if (viaEngineId != null)
-        {
-            LogPlayerFound(viaEngineId, "GetLocalPlayerPawnId");
-            return viaEngineId;
-        }
         return null;
     }
 
@@ -65,6 +66,12 @@ public static class PlayerFinder
 
         while (sw.Elapsed.TotalSeconds < timeoutSeconds)
         {
+            var pawnViaHandle = TryGetPlayerPawnViaHandle(driver);
+            if (pawnViaHandle != null)
+            {
+                LogPlayerFound(pawnViaHandle, "GetLocalPlayerPawnId(wait)");
+                return pawnViaHandle;
+            }
             var candidates = GetCharacterCandidates(driver);
             if (candidates.Count > 0)
             {
@@ -96,12 +103,6 @@ public static class PlayerFinder
                 LogPlayerFound(pawnViaStatics, "GameplayStatics(wait)");
                 return pawnViaStatics;
             }
-            var pawnViaEngineId = TryGetPlayerPawnViaEngineId(driver);
-            if (pawnViaEngineId != null)
-            {
-                LogPlayerFound(pawnViaEngineId, "GetLocalPlayerPawnId(wait)");
-                return pawnViaEngineId;
-            }
 
             Thread.Sleep(150);
         }
@@ -118,6 +119,8 @@ public static class PlayerFinder
         var sw = Stopwatch.StartNew();
         while (sw.Elapsed.TotalSeconds < timeoutSeconds)
         {
+            var pawnViaHandle = TryGetPlayerPawnViaHandle(driver);
+            if (pawnViaHandle != null) return pawnViaHandle;
             var candidates = GetCharacterCandidates(driver);
             if (candidates.Count > 0)
             {
@@ -136,8 +139,6 @@ public static class PlayerFinder
             if (pawnViaController != null) return pawnViaController;
             var pawnViaStatics = TryGetPlayerPawnViaGameplayStatics(driver);
             if (pawnViaStatics != null) return pawnViaStatics;
-            var pawnViaEngineId = TryGetPlayerPawnViaEngineId(driver);
-            if (pawnViaEngineId != null) return pawnViaEngineId;
             Thread.Sleep(200);
         }
         return null;
@@ -261,6 +262,8 @@ public static class PlayerFinder
 
     static AltObject? FindPlayerController(AltDriver driver)
     {
+        if (AltDriverConfig.WorldId >= 0)
+            return AimingHelper.FindWorldPlayerController(driver, AltDriverConfig.WorldId);
         foreach (var enabled in new[] { true, false })
         {
             var list = SafeFindObjectsWhichContain(driver, "PlayerController", enabled);
@@ -418,25 +421,15 @@ public static class PlayerFinder
         return false;
     }
 
-    static AltObject? TryGetPlayerPawnViaEngineId(AltDriver driver)
+    static AltObject? TryGetPlayerPawnViaHandle(AltDriver driver)
     {
-        AltObject? world = null;
-        try { world = driver.FindObjectWhichContains(By.NAME, "World", enabled: false); }
-        catch { }
-        if (world == null)
-        {
-            try { world = driver.FindObject(By.NAME, "PersistentLevel", enabled: false); }
-            catch { }
-        }
-        var anyContext = world ?? FindPlayerController(driver);
-        if (anyContext == null) return null;
+        int worldId = AimingHelper.TryGetWorldContextId(driver);
+        if (worldId == 0) return null;
         try
         {
             var pawnId = driver.CallStaticMethod<long>("LyraTestEnemyQuery", "GetLocalPlayerPawnId", "LyraGame",
-                new object[] { anyContext.id, 0 }, new string[] { "System.Int32", "System.Int32" });
-            if (pawnId == 0) return null;
-            var pawn = driver.FindObject(By.ID, pawnId.ToString(), enabled: false) ?? driver.FindObject(By.ID, pawnId.ToString(), enabled: true);
-            return pawn;
+                new object[] { worldId, 0 }, new string[] { "System.Int32", "System.Int32" });
+            return pawnId == 0 ? null : AimingHelper.TryFindObjectByHandle(driver, worldId, pawnId);
         }
         catch { return null; }
     }
@@ -0,0 +1,149 @@
+using System.Buffers.Binary;
+using System.Text;
+using AltTester.AltTesterSDK.Driver;
+
+namespace LyraTests.Helpers;
+
+public enum TestCommandOp : byte
+{
+    None = 0,
+    LookAt = 1,
+    Fire = 2,
+    SetCheats = 3,
+    Snapshot = 4,
+    WaitFrames = 5,
+    FindKill = 6,
+    AimAtEnemy = 7,
+    TrackEnemy = 8,
+    FirePattern = 9
+}
+
+public sealed record TestCommandResult(TestCommandOp Op, bool Ok, long FrameNumber, TestSnapshot? Snapshot, long Value);
+
+public sealed class TestCommandBatchResult
+{
+    public long BatchId { get; init; }
+    public long FrameNumber { get; init; }
+    public bool Pending { get; init; }
+    public bool ParseError { get; init; }
+    public bool Unknown { get; init; }
+    public List<TestCommandResult> Results { get; } = new();
+
+    public TestSnapshot? LastSnapshot => Results.LastOrDefault(r => r.Snapshot != null)?.Snapshot;
+
+    public long KillSequence => Results.LastOrDefault(r => r.Op == TestCommandOp.FindKill)?.Value ?? 0;
+}
+
+/// <summary>
+/// Builds a LyraTestEnemyQuery.ExecuteTestCommands command list so look-at, fire, cheats, snapshot and kill
+/// queries run in one game frame and one AltTester round-trip. Commands after a WaitFrames finish later;
+/// fetch them with TryGetResults while the result is Pending.
+/// </summary>
+public sealed class TestCommandBatch
+{
+    public const uint Magic = 0x4243544C;
+    public const ushort SupportedVersion = 1;
+    public const int HeaderSize = 32;
+    public const int EntryHeaderSize = 16;
+
+    readonly StringBuilder _commands = new();
+
+    public TestCommandBatch LookAt(float x, float y, float z) => Add(FormattableString.Invariant($"look {x} {y} {z}"));
+    /// <summary>Engine-side lead aim (target velocity, weapon spread, head/capsule choice) at an enemy; 0 = closest.</summary>
+    public TestCommandBatch AimAtEnemy(long targetId = 0) => Add(FormattableString.Invariant($"aim {targetId}"));
+    /// <summary>Starts smooth per-frame aim tracking in the game (critically damped, rate-limited); stays on until StopAimTracking.</summary>
+    public TestCommandBatch TrackEnemy(long targetId = 0, bool fireWhenSettled = false) => Add(FormattableString.Invariant($"track {targetId} {(fireWhenSettled ? 1 : 0)}"));
+    public TestCommandBatch Fire() => Add("fire");
+    public TestCommandBatch FirePattern(int shotCount, int holdFrames = 3, int intervalFrames = 6) => Add(FormattableString.Invariant($"burst {shotCount} {holdFrames} {intervalFrames}"));
+    public TestCommandBatch SetCheats(bool invincible, bool infiniteAmmo) => Add($"cheat {(invincible ? 1 : 0)} {(infiniteAmmo ? 1 : 0)}");
+    public TestCommandBatch Snapshot(bool enemiesOnly = true) => Add($"snap {(enemiesOnly ? 1 : 0)}");
+    public TestCommandBatch WaitFrames(int frames) => Add(FormattableString.Invariant($"wait {frames}"));
+    public TestCommandBatch FindKill(long sinceSequence, long victimId = 0, long instigatorId = 0) => Add(FormattableString.Invariant($"kill {sinceSequence} {victimId} {instigatorId}"));
+
+    public override string ToString() => _commands.ToString();
+
+    TestCommandBatch Add(string command)
+    {
+        if (_commands.Length > 0) _commands.Append(';');
+        _commands.Append(command);
+        return this;
+    }
+
+    public bool TryExecute(AltDriver driver, int worldId, out TestCommandBatchResult? result, int playerIndex = 0)
+    {
+        result = null;
+        if (worldId == 0) return false;
+        try
+        {
+            var s = driver.CallStaticMethod<string>("LyraTestEnemyQuery", "ExecuteTestCommands", "LyraGame",
+                new object[] { worldId, playerIndex, ToString() }, new string[] { "System.Int32", "System.Int32", "System.String" });
+            return TryDecodeBase64(s, out result) && !result!.ParseError;
+        }
+        catch { return false; }
+    }
+
+    public static bool TryGetResults(AltDriver driver, int worldId, long batchId, out TestCommandBatchResult? result)
+    {
+        result = null;
+        if (worldId == 0) return false;
+        try
+        {
+            var s = driver.CallStaticMethod<string>("LyraTestEnemyQuery", "GetTestCommandResults", "LyraGame",
+                new object[] { worldId, batchId }, new string[] { "System.Int32", "System.Int64" });
+            return TryDecodeBase64(s, out result) && !result!.Unknown;
+        }
+        catch { return false; }
+    }
+
+    public static bool TryDecodeBase64(string? base64, out TestCommandBatchResult? result)
+    {
+        result = null;
+        if (string.IsNullOrWhiteSpace(base64)) return false;
+        byte[] bytes;
+        try { bytes = Convert.FromBase64String(base64.Trim()); }
+        catch (FormatException) { return false; }
+        return TryDecode(bytes, out result);
+    }
+
+    public static bool TryDecode(ReadOnlySpan<byte> data, out TestCommandBatchResult? result)
+    {
+        result = null;
+        if (data.Length < HeaderSize) return false;
+        if (BinaryPrimitives.ReadUInt32LittleEndian(data) != Magic) return false;
+        ushort version = BinaryPrimitives.ReadUInt16LittleEndian(data.Slice(4));
+        ushort count = BinaryPrimitives.ReadUInt16LittleEndian(data.Slice(6));
+        if (version == 0 || version > SupportedVersion) return false;
+        uint flags = BinaryPrimitives.ReadUInt32LittleEndian(data.Slice(24));
+
+        var decoded = new TestCommandBatchResult
+        {
+            BatchId = BinaryPrimitives.ReadInt64LittleEndian(data.Slice(8)),
+            FrameNumber = (long)BinaryPrimitives.ReadUInt64LittleEndian(data.Slice(16)),
+            Pending = (flags & 1) != 0,
+            ParseError = (flags & 2) != 0,
+            Unknown = (flags & 4) != 0
+        };
+        int offset = HeaderSize;
+        for (int i = 0; i < count; i++)
+        {
+            if (offset + EntryHeaderSize > data.Length) return false;
+            var e = data.Slice(offset);
+            var op = (TestCommandOp)e[0];
+            uint payloadSize = BinaryPrimitives.ReadUInt32LittleEndian(e.Slice(4));
+            if (offset + EntryHeaderSize + (long)payloadSize > data.Length) return false;
+            var payload = e.Slice(EntryHeaderSize, (int)payloadSize);
+
+            TestSnapshot? snapshot = null;
+            long value = 0;
+            if (op == TestCommandOp.Snapshot && payload.Length > 0)
+                TestSnapshot.TryDecode(payload, out snapshot);
+            else if (op == TestCommandOp.FindKill && payload.Length >= 8)
+                value = BinaryPrimitives.ReadInt64LittleEndian(payload);
+
+            decoded.Results.Add(new TestCommandResult(op, e[1] != 0, (long)BinaryPrimitives.ReadUInt64LittleEndian(e.Slice(8)), snapshot, value));
+            offset += EntryHeaderSize + (int)payloadSize;
+        }
+        result = decoded;
+        return true;
+    }
+}
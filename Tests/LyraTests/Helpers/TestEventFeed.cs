@@ -0,0 +1,167 @@
+using System.Buffers.Binary;
+using AltTester.AltTesterSDK.Driver;
+
+namespace LyraTests.Helpers;
+
+public enum TestEventType : byte
+{
+    None = 0,
+    PawnPossessed = 1,
+    ExperienceLoaded = 2,
+    HudShown = 3,
+    EnemySpawned = 4,
+    EnemyDied = 5,
+    PlayerDied = 6,
+    DamageDealt = 7,
+    AimSettled = 8,
+    SessionReady = 9,
+    WorldReset = 10
+}
+
+public readonly record struct TestEvent(
+    long Sequence,
+    long FrameNumber,
+    double WorldTimeSeconds,
+    TestEventType Type,
+    float Value,
+    long SubjectId,
+    long OtherId,
+    (float x, float y, float z) Location);
+
+/// <summary>
+/// Follows the game-side LyraTestEventPublisher ring by sequence number. One Drain is one round-trip and
+/// returns every event since the last Drain, so waits only sleep while nothing new has happened.
+/// </summary>
+public sealed class TestEventFeed
+{
+    public const uint Magic = 0x5645544C;
+    public const ushort SupportedVersion = 1;
+    public const int HeaderSize = 16;
+    public const int MinRecordStride = 64;
+
+    readonly AltDriver _driver;
+    int _worldId;
+
+    public long Cursor { get; private set; }
+
+    /// <summary>Events the game-side ring overwrote before a Drain could read them.</summary>
+    public long LostEvents { get; private set; }
+
+    TestEventFeed(AltDriver driver, int worldId, long cursor)
+    {
+        _driver = driver;
+        _worldId = worldId;
+        Cursor = cursor;
+    }
+
+    /// <summary>Opens a feed positioned at the latest event (fromStart: false) or at the oldest retained event.</summary>
+    public static TestEventFeed? TryOpen(AltDriver driver, bool fromStart = false)
+    {
+        int worldId = AimingHelper.TryGetWorldContextId(driver);
+        if (worldId == 0) return null;
+        try
+        {
+            long latest = driver.CallStaticMethod<long>("LyraTestEnemyQuery", "GetLatestTestEventSequence", "LyraGame",
+                new object[] { worldId }, new string[] { "System.Int32" });
+            return new TestEventFeed(driver, worldId, fromStart ? 0 : latest);
+        }
+        catch
+        {
+            return null;
+        }
+    }
+
+    public List<TestEvent> Drain(int maxEvents = 0)
+    {
+        var events = new List<TestEvent>();
+        string? s = null;
+        for (int attempt = 0; attempt < 2 && s == null; attempt++)
+        {
+            try
+            {
+                s = _driver.CallStaticMethod<string>("LyraTestEnemyQuery", "GetTestEventsSinceBase64", "LyraGame",
+                    new object[] { _worldId, Cursor, maxEvents }, new string[] { "System.Int32", "System.Int64", "System.Int32" });
+            }
+            catch
+            {
+                int refreshed = AimingHelper.TryGetWorldContextId(_driver);
+                if (refreshed == 0 || refreshed == _worldId) break;
+                _worldId = refreshed;
+            }
+        }
+        if (TryDecodeBase64(s, events, out uint lost) && events.Count > 0)
+        {
+            Cursor = events[^1].Sequence;
+            LostEvents += lost;
+        }
+        return events;
+    }
+
+    public bool WaitFor(Func<TestEvent, bool> predicate, double timeoutSeconds, out TestEvent match, int idlePollMs = 50)
+    {
+        var deadline = DateTime.UtcNow.AddSeconds(timeoutSeconds);
+        while (true)
+        {
+            foreach (var e in Drain())
+            {
+                if (predicate(e))
+                {
+                    match = e;
+                    return true;
+                }
+            }
+            if (DateTime.UtcNow >= deadline) break;
+            Thread.Sleep(idlePollMs);
+        }
+        match = default;
+        return false;
+    }
+
+    public bool WaitFor(TestEventType type, double timeoutSeconds, out TestEvent match, int idlePollMs = 50) =>
+        WaitFor(e => e.Type == type, timeoutSeconds, out match, idlePollMs);
+
+    public static bool TryDecodeBase64(string? base64, List<TestEvent> events) =>
+        TryDecodeBase64(base64, events, out _);
+
+    public static bool TryDecodeBase64(string? base64, List<TestEvent> events, out uint lost)
+    {
+        lost = 0;
+        if (string.IsNullOrWhiteSpace(base64)) return false;
+        byte[] bytes;
+        try { bytes = Convert.FromBase64String(base64.Trim()); }
+        catch (FormatException) { return false; }
+        return TryDecode(bytes, events, out lost);
+    }
+
+    public static bool TryDecode(ReadOnlySpan<byte> data, List<TestEvent> events) =>
+        TryDecode(data, events, out _);
+
+    /// <summary>lost is the header's count of events the ring overwrote before they could be returned.</summary>
+    public static bool TryDecode(ReadOnlySpan<byte> data, List<TestEvent> events, out uint lost)
+    {
+        lost = 0;
+        if (data.Length < HeaderSize) return false;
+        if (BinaryPrimitives.ReadUInt32LittleEndian(data) != Magic) return false;
+        ushort version = BinaryPrimitives.ReadUInt16LittleEndian(data.Slice(4));
+        ushort stride = BinaryPrimitives.ReadUInt16LittleEndian(data.Slice(6));
+        uint count = BinaryPrimitives.ReadUInt32LittleEndian(data.Slice(8));
+        if (version == 0 || version > SupportedVersion || stride < MinRecordStride) return false;
+        if ((long)HeaderSize + (long)count * stride > data.Length) return false;
+        lost = BinaryPrimitives.ReadUInt32LittleEndian(data.Slice(12));
+
+        for (int i = 0; i < count; i++)
+        {
+            var r = data.Slice(HeaderSize + i * stride, stride);
+            events.Add(new TestEvent(
+                BinaryPrimitives.ReadInt64LittleEndian(r),
+                (long)BinaryPrimitives.ReadUInt64LittleEndian(r.Slice(8)),
+                BinaryPrimitives.ReadDoubleLittleEndian(r.Slice(16)),
+                (TestEventType)r[24],
+                BinaryPrimitives.ReadSingleLittleEndian(r.Slice(28)),
+                BinaryPrimitives.ReadInt64LittleEndian(r.Slice(32)),
+                BinaryPrimitives.ReadInt64LittleEndian(r.Slice(40)),
+                (BinaryPrimitives.ReadSingleLittleEndian(r.Slice(48)), BinaryPrimitives.ReadSingleLittleEndian(r.Slice(52)), BinaryPrimitives.ReadSingleLittleEndian(r.Slice(56)))));
+        }
+        return true;
+    }
+}
@@ -0,0 +1,46 @@
+using System.Text.Json;
+
+namespace LyraTests.Helpers;
+
+/// <summary>Result of <c>LyraTestEnemyQuery.GetTestInstanceConfig</c>: what the game instance was started with.</summary>
+public sealed class TestInstanceConfig
+{
+    /// <summary>-1 when the game was not started as one of several instances.</summary>
+    public int InstanceId { get; init; } = -1;
+    public int AgentPort { get; init; }
+    public string AppName { get; init; } = string.Empty;
+    public string Map { get; init; } = string.Empty;
+    public string Experience { get; init; } = string.Empty;
+    public int? Seed { get; init; }
+    public int BotCount { get; init; } = -1;
+
+    public override string ToString() =>
+        $"instance {InstanceId} (port {AgentPort}, app '{AppName}'), map '{Map}', experience '{Experience}', seed {(Seed?.ToString() ?? "none")}, bots {BotCount}";
+
+    public static bool TryParse(string? json, out TestInstanceConfig? config)
+    {
+        config = null;
+        if (string.IsNullOrWhiteSpace(json)) return false;
+        try
+        {
+            using var doc = JsonDocument.Parse(json);
+            var root = doc.RootElement;
+            var seed = root.GetProperty("seed");
+            config = new TestInstanceConfig
+            {
+                InstanceId = root.GetProperty("instanceId").GetInt32(),
+                AgentPort = root.GetProperty("agentPort").GetInt32(),
+                AppName = root.GetProperty("appName").GetString() ?? string.Empty,
+                Map = root.GetProperty("map").GetString() ?? string.Empty,
+                Experience = root.GetProperty("experience").GetString() ?? string.Empty,
+                Seed = seed.ValueKind == JsonValueKind.Null ? null : seed.GetInt32(),
+                BotCount = root.GetProperty("botCount").GetInt32()
+            };
+            return true;
+        }
+        catch (Exception e) when (e is JsonException or KeyNotFoundException or InvalidOperationException or FormatException)
+        {
+            return false;
+        }
+    }
+}
@@ -0,0 +1,74 @@
+using System.Text.Json;
+
+namespace LyraTests.Helpers;
+
+public readonly record struct TestPerfStat(double Mean, double P50, double P95, double P99, double Max);
+
+/// <summary>Result of <c>LyraTestEnemyQuery.EndTestPerfCapture</c>: the capture plus its baseline comparison.</summary>
+public sealed class TestPerfCapture
+{
+    public string Name { get; init; } = string.Empty;
+    public int Frames { get; init; }
+    public double DurationSeconds { get; init; }
+    public TestPerfStat FrameMs { get; init; }
+    public TestPerfStat GameThreadMs { get; init; }
+    public TestPerfStat RenderThreadMs { get; init; }
+    public TestPerfStat GpuMs { get; init; }
+    public int GcCount { get; init; }
+    public double GcPauseMaxMs { get; init; }
+    public int Hitches { get; init; }
+    public double PeakUsedPhysicalMB { get; init; }
+
+    public string BaselinePath { get; init; } = string.Empty;
+    public bool BaselineFound { get; init; }
+    public bool Passed { get; init; }
+    public bool BaselineWritten { get; init; }
+    public List<string> Regressions { get; } = new();
+
+    public override string ToString() =>
+        $"{Name}: {Frames} frames, frame p50/p95/p99 {FrameMs.P50:F1}/{FrameMs.P95:F1}/{FrameMs.P99:F1} ms (max {FrameMs.Max:F1}), " +
+        $"game p95 {GameThreadMs.P95:F1} ms, render p95 {RenderThreadMs.P95:F1} ms, gpu p95 {GpuMs.P95:F1} ms, " +
+        $"{Hitches} hitches, {GcCount} GCs (max {GcPauseMaxMs:F1} ms), peak {PeakUsedPhysicalMB:F0} MB";
+
+    public static bool TryParse(string? json, out TestPerfCapture? capture)
+    {
+        capture = null;
+        if (string.IsNullOrWhiteSpace(json)) return false;
+        try
+        {
+            using var doc = JsonDocument.Parse(json);
+            var c = doc.RootElement.GetProperty("capture");
+            var cmp = doc.RootElement.GetProperty("comparison");
+            var result = new TestPerfCapture
+            {
+                Name = c.GetProperty("name").GetString() ?? string.Empty,
+                Frames = c.GetProperty("frames").GetInt32(),
+                DurationSeconds = c.GetProperty("durationSeconds").GetDouble(),
+                FrameMs = ReadStat(c.GetProperty("frameMs")),
+                GameThreadMs = ReadStat(c.GetProperty("gameThreadMs")),
+                RenderThreadMs = ReadStat(c.GetProperty("renderThreadMs")),
+                GpuMs = ReadStat(c.GetProperty("gpuMs")),
+                GcCount = c.GetProperty("gcCount").GetInt32(),
+                GcPauseMaxMs = c.GetProperty("gcPauseMaxMs").GetDouble(),
+                Hitches = c.GetProperty("hitches").GetInt32(),
+                PeakUsedPhysicalMB = c.GetProperty("peakUsedPhysicalMB").GetDouble(),
+                BaselinePath = cmp.GetProperty("baselinePath").GetString() ?? string.Empty,
+                BaselineFound = cmp.GetProperty("baselineFound").GetBoolean(),
+                Passed = cmp.GetProperty("passed").GetBoolean(),
+                BaselineWritten = cmp.GetProperty("baselineWritten").GetBoolean()
+            };
+            foreach (var r in cmp.GetProperty("regressions").EnumerateArray())
+                result.Regressions.Add(r.GetString() ?? string.Empty);
+            capture = result;
+            return true;
+        }
+        catch (Exception e) when (e is JsonException or KeyNotFoundException or InvalidOperationException or FormatException)
+        {
+            return false;
+        }
+    }
+
+    static TestPerfStat ReadStat(JsonElement e) => new(
+        e.GetProperty("mean").GetDouble(), e.GetProperty("p50").GetDouble(), e.GetProperty("p95").GetDouble(),
+        e.GetProperty("p99").GetDouble(), e.GetProperty("max").GetDouble());
+}
@@ -0,0 +1,90 @@
+using System.Buffers.Binary;
+
+namespace LyraTests.Helpers;
+
+public enum TestSnapshotRecordKind : byte
+{
+    Player = 0,
+    Enemy = 1
+}
+
+public readonly record struct TestSnapshotRecord(
+    long Id,
+    int TeamId,
+    TestSnapshotRecordKind Kind,
+    bool Alive,
+    (double x, double y, double z) Position,
+    (float x, float y, float z) Velocity,
+    float Health,
+    float MaxHealth,
+    bool Stale = false);
+
+public sealed class TestSnapshot
+{
+    public const uint Magic = 0x4E53544C;
+    public const ushort SupportedVersion = 1;
+    public const int HeaderSize = 32;
+    public const int MinRecordStride = 64;
+
+    public int Version { get; init; }
+    public long FrameNumber { get; init; }
+    public double WorldTimeSeconds { get; init; }
+    public List<TestSnapshotRecord> Records { get; } = new();
+
+    public TestSnapshotRecord? Player
+    {
+        get
+        {
+            foreach (var r in Records)
+                if (r.Kind == TestSnapshotRecordKind.Player) return r;
+            return null;
+        }
+    }
+
+    public IEnumerable<TestSnapshotRecord> Enemies => Records.Where(r => r.Kind == TestSnapshotRecordKind.Enemy);
+
+    public static bool TryDecodeBase64(string? base64, out TestSnapshot? snapshot)
+    {
+        snapshot = null;
+        if (string.IsNullOrWhiteSpace(base64)) return false;
+        byte[] bytes;
+        try { bytes = Convert.FromBase64String(base64.Trim()); }
+        catch (FormatException) { return false; }
+        return TryDecode(bytes, out snapshot);
+    }
+
+    public static bool TryDecode(ReadOnlySpan<byte> data, out TestSnapshot? snapshot)
+    {
+        snapshot = null;
+        if (data.Length < HeaderSize) return false;
+        if (BinaryPrimitives.ReadUInt32LittleEndian(data) != Magic) return false;
+        ushort version = BinaryPrimitives.ReadUInt16LittleEndian(data.Slice(4));
+        ushort stride = BinaryPrimitives.ReadUInt16LittleEndian(data.Slice(6));
+        uint count = BinaryPrimitives.ReadUInt32LittleEndian(data.Slice(8));
+        if (version == 0 || version > SupportedVersion || stride < MinRecordStride) return false;
+        if ((long)HeaderSize + (long)count * stride > data.Length) return false;
+
+        var result = new TestSnapshot
+        {
+            Version = version,
+            FrameNumber = (long)BinaryPrimitives.ReadUInt64LittleEndian(data.Slice(16)),
+            WorldTimeSeconds = BinaryPrimitives.ReadDoubleLittleEndian(data.Slice(24))
+        };
+        for (int i = 0; i < count; i++)
+        {
+            var r = data.Slice(HeaderSize + i * stride, stride);
+            result.Records.Add(new TestSnapshotRecord(
+                BinaryPrimitives.ReadInt64LittleEndian(r),
+                BinaryPrimitives.ReadInt32LittleEndian(r.Slice(8)),
+                (TestSnapshotRecordKind)r[12],
+                (r[13] & 1) != 0,
+                (BinaryPrimitives.ReadDoubleLittleEndian(r.Slice(16)), BinaryPrimitives.ReadDoubleLittleEndian(r.Slice(24)), BinaryPrimitives.ReadDoubleLittleEndian(r.Slice(32))),
+                (BinaryPrimitives.ReadSingleLittleEndian(r.Slice(40)), BinaryPrimitives.ReadSingleLittleEndian(r.Slice(44)), BinaryPrimitives.ReadSingleLittleEndian(r.Slice(48))),
+                BinaryPrimitives.ReadSingleLittleEndian(r.Slice(52)),
+                BinaryPrimitives.ReadSingleLittleEndian(r.Slice(56)),
+                (r[13] & 2) != 0));
+        }
+        snapshot = result;
+        return true;
+    }
+}
@@ -0,0 +1,99 @@
+using System.Buffers.Binary;
+
+namespace LyraTests.Helpers;
+
+public readonly record struct TestVisibilityRecord(
+    long Id,
+    bool Projected,
+    bool OnScreen,
+    bool Occluded,
+    bool Stale,
+    float Distance,
+    (double x, double y, double z) Position,
+    (float x, float y) ScreenPosition,
+    (float minX, float minY, float maxX, float maxY) ScreenBounds,
+    float CrosshairOffsetPixels,
+    float CrosshairYawDegrees,
+    float CrosshairPitchDegrees)
+{
+    public bool Visible => OnScreen && !Occluded;
+
+    public float CrosshairOffsetDegrees => MathF.Sqrt(CrosshairYawDegrees * CrosshairYawDegrees + CrosshairPitchDegrees * CrosshairPitchDegrees);
+}
+
+public sealed class TestVisibility
+{
+    public const uint Magic = 0x5356544C;
+    public const ushort SupportedVersion = 1;
+    public const int HeaderSize = 32;
+    public const int MinRecordStride = 80;
+
+    public int Version { get; init; }
+    public long FrameNumber { get; init; }
+    public (float x, float y) ViewportSize { get; init; }
+    public List<TestVisibilityRecord> Records { get; } = new();
+
+    /// <summary>Record whose world position is within <paramref name="tolerance"/> of the point, nearest first.</summary>
+    public TestVisibilityRecord? FindNear(double x, double y, double z, double tolerance = 150)
+    {
+        TestVisibilityRecord? best = null;
+        double bestSq = tolerance * tolerance;
+        foreach (var r in Records)
+        {
+            double dx = r.Position.x - x, dy = r.Position.y - y, dz = r.Position.z - z;
+            double sq = dx * dx + dy * dy + dz * dz;
+            if (sq <= bestSq) { best = r; bestSq = sq; }
+        }
+        return best;
+    }
+
+    public static bool TryDecodeBase64(string? base64, out TestVisibility? visibility)
+    {
+        visibility = null;
+        if (string.IsNullOrWhiteSpace(base64)) return false;
+        byte[] bytes;
+        try { bytes = Convert.FromBase64String(base64.Trim()); }
+        catch (FormatException) { return false; }
+        return TryDecode(bytes, out visibility);
+    }
+
+    public static bool TryDecode(ReadOnlySpan<byte> data, out TestVisibility? visibility)
+    {
+        visibility = null;
+        if (data.Length < HeaderSize) return false;
+        if (BinaryPrimitives.ReadUInt32LittleEndian(data) != Magic) return false;
+        ushort version = BinaryPrimitives.ReadUInt16LittleEndian(data.Slice(4));
+        ushort stride = BinaryPrimitives.ReadUInt16LittleEndian(data.Slice(6));
+        uint count = BinaryPrimitives.ReadUInt32LittleEndian(data.Slice(8));
+        if (version == 0 || version > SupportedVersion || stride < MinRecordStride) return false;
+        if ((long)HeaderSize + (long)count * stride > data.Length) return false;
+
+        var result = new TestVisibility
+        {
+            Version = version,
+            ViewportSize = (BinaryPrimitives.ReadSingleLittleEndian(data.Slice(12)), BinaryPrimitives.ReadSingleLittleEndian(data.Slice(16))),
+            FrameNumber = (long)BinaryPrimitives.ReadUInt64LittleEndian(data.Slice(24))
+        };
+        for (int i = 0; i < count; i++)
+        {
+            var r = data.Slice(HeaderSize + i * stride, stride);
+            byte flags = r[8];
+            result.Records.Add(new TestVisibilityRecord(
+                BinaryPrimitives.ReadInt64LittleEndian(r),
+                (flags & 1) != 0,
+                (flags & 2) != 0,
+                (flags & 4) != 0,
+                (flags & 8) != 0,
+                BinaryPrimitives.ReadSingleLittleEndian(r.Slice(12)),
+                (BinaryPrimitives.ReadDoubleLittleEndian(r.Slice(16)), BinaryPrimitives.ReadDoubleLittleEndian(r.Slice(24)), BinaryPrimitives.ReadDoubleLittleEndian(r.Slice(32))),
+                (BinaryPrimitives.ReadSingleLittleEndian(r.Slice(40)), BinaryPrimitives.ReadSingleLittleEndian(r.Slice(44))),
+                (BinaryPrimitives.ReadSingleLittleEndian(r.Slice(48)), BinaryPrimitives.ReadSingleLittleEndian(r.Slice(52)),
+                    BinaryPrimitives.ReadSingleLittleEndian(r.Slice(56)), BinaryPrimitives.ReadSingleLittleEndian(r.Slice(60))),
+                BinaryPrimitives.ReadSingleLittleEndian(r.Slice(64)),
+                BinaryPrimitives.ReadSingleLittleEndian(r.Slice(68)),
+                BinaryPrimitives.ReadSingleLittleEndian(r.Slice(72))));
+        }
+        visibility = result;
+        return true;
+    }
+}
@@ -1,5 +1,6 @@
 using AltTester.AltTesterSDK.Driver;
 using LyraTests.Config;
+using LyraTests.Helpers;
 using NUnit.Framework;
 
 namespace LyraTests.Smoke;
@@ -18,6 +19,9 @@ public abstract class SmokeTestBase
             appName: AltDriverConfig.AppName,
             connectTimeout: AltDriverConfig.ConnectTimeout
         );
+        // Sharded runs: a crossed port or app name would silently run this shard against another instance's game.
+        if (AltDriverConfig.InstanceId >= 0 && AimingHelper.TryGetTestInstanceConfig(Driver, out var instance))
+            Assert.That(instance!.InstanceId, Is.EqualTo(AltDriverConfig.InstanceId), "Connected to the wrong game instance: " + instance);
     }
 
     [OneTimeTearDown]